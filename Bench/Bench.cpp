@@ -0,0 +1,59 @@
+#include "framework.h"
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <cstring>
+
+// Bench.exe <name> [args...]
+// Standalone perf harness: no window, prints plain tables so results can be diffed between runs.
+struct BenchEntry
+{
+    const char* name;
+    const char* usage;
+    int (*fn)(int argc, char** argv);
+};
+
+static const BenchEntry s_benches[] = {
+    { "jobs", "jobs [entities=100000] [workIters=64] [reps=5]", &Bench_JobScaling },
+    { "physics", "physics [bodyCount...] (default 1000 2000 4000 8000)", &Bench_PhysicsStep },
+    { "physicsiter", "physicsiter [bodies=50000] [otherEntities=bodies] [reps=50]", &Bench_PhysicsGroup },
+    { "idlookup", "idlookup [entities=100000] [lookups=100000] [scanLookups=1000]", &Bench_IdLookup },
+    { "renderqueue", "renderqueue [layerSpan=21] [spriteCount...] (default 1000 10000 50000)", &Bench_RenderQueue },
+    { "spatial", "spatial [entities=50000] [queries=2000] [radius=200] [movePercent=10]", &Bench_SpatialQuery },
+    { "prefab", "prefab [entities=500]", &Bench_PrefabSpawn },
+    { "snapshot", "snapshot [enemies=5000] [reps=10]", &Bench_SceneSnapshot },
+    { "cook", "cook [reps=3] [entityCount...] (default 1000 10000 100000)", &Bench_CookedLoad },
+    { "tiles", "tiles [width=1000] [height=1000] [reps=3]", &Bench_TileCodec },
+    { "sax", "sax [entities=100000] [reps=3]", &Bench_SaxLoad },
+    { "parallelload", "parallelload [entities=100000] [reps=3] [threads...] (default 1 2 4 8)", &Bench_ParallelLoad },
+    { "zeroalloc", "zeroalloc [warmupTicks=60] [ticks=300]  (exit code 1 if a steady-state tick allocates)", &Bench_ZeroAlloc },
+    { "replaycheck", "replaycheck [ticks=600]  (record + replay in two processes, exit code 1 on divergence)", &Bench_ReplayCheck },
+};
+
+static void PrintUsage()
+{
+    std::printf("Usage: Bench <name> [args...]\n\n");
+    for (const auto& b : s_benches)
+        std::printf("  %s\n", b.usage);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    bench::g_exePath = argv[0];
+
+    for (const auto& b : s_benches)
+    {
+        if (std::strcmp(argv[1], b.name) == 0)
+            return b.fn(argc - 2, argv + 2);
+    }
+
+    std::printf("Unknown benchmark '%s'\n\n", argv[1]);
+    PrintUsage();
+    return 1;
+}
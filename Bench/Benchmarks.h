@@ -0,0 +1,32 @@
+#pragma once
+#include <chrono>
+
+// Each benchmark gets the arguments after its name and returns the process exit code.
+int Bench_JobScaling(int argc, char** argv);
+int Bench_PhysicsStep(int argc, char** argv);
+int Bench_PhysicsGroup(int argc, char** argv);
+int Bench_IdLookup(int argc, char** argv);
+int Bench_RenderQueue(int argc, char** argv);
+int Bench_SpatialQuery(int argc, char** argv);
+int Bench_PrefabSpawn(int argc, char** argv);
+int Bench_SceneSnapshot(int argc, char** argv);
+int Bench_CookedLoad(int argc, char** argv);
+int Bench_TileCodec(int argc, char** argv);
+int Bench_SaxLoad(int argc, char** argv);
+int Bench_ParallelLoad(int argc, char** argv);
+
+// Checks rather than measures: nonzero exit code on failure (usable from CI).
+int Bench_ZeroAlloc(int argc, char** argv);
+int Bench_ReplayCheck(int argc, char** argv);
+
+namespace bench
+{
+    // argv[0], for checks that re-run Bench in child processes
+    inline const char* g_exePath = "Bench";
+
+    inline double NowMs()
+    {
+        using namespace std::chrono;
+        return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    }
+}
@@ -0,0 +1,198 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+#include "Scene/Prefab.h"
+#include "Scene/SceneSerializer.h"
+#include "Scene/CookedScene.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Room load from the authoring JSON vs the cooked .scene.bin, per room size:
+//   json    - SceneSerializer::LoadFromJson (DOM parse + per-entity key lookups)
+//   cook    - the one-off cost of writing the .scene.bin (JSON load + Write)
+//   cooked  - SceneSerializer::LoadFromFile with an up-to-date .scene.bin (mmap + bulk inserts)
+// Both loads are checked to produce the same ids, tags and transforms.
+namespace
+{
+    // Enemies with bodies, plus a sprite-only decoration every 4th entity and a tilemap
+    void BuildRoom(my2d::Scene& scene, uint32_t count)
+    {
+        auto ground = scene.CreateEntity("Tilemap");
+        auto& tm = ground.Add<my2d::TilemapComponent>();
+        tm.width = 128;
+        tm.height = 32;
+        my2d::TileLayer layer;
+        layer.name = "Collision";
+        layer.tiles.assign((size_t)tm.width * tm.height, -1);
+        for (int x = 0; x < tm.width; ++x)
+            layer.tiles[(size_t)(tm.height - 1) * tm.width + x] = 0;
+        tm.layers.push_back(std::move(layer));
+        ground.Add<my2d::TilemapColliderComponent>();
+
+        my2d::Prefab enemy;
+        enemy.SetTag("Enemy");
+        {
+            my2d::SpriteRendererComponent spr;
+            spr.texturePath = "Textures/enemy.png";
+            spr.size = { 32.0f, 32.0f };
+            enemy.AddComponent(spr);
+            enemy.AddComponent(my2d::RigidBody2DComponent{});
+
+            my2d::BoxCollider2DComponent bc;
+            bc.size = { 28.0f, 30.0f };
+            enemy.AddComponent(bc);
+
+            enemy.AddComponent(my2d::TeamComponent{ my2d::Team::Enemy });
+            enemy.AddComponent(my2d::HealthComponent{ 3, 3 });
+            enemy.AddComponent(my2d::HurtboxComponent{});
+            enemy.AddComponent(my2d::FacingComponent{});
+            enemy.AddComponent(my2d::EnemyAIComponent{});
+        }
+
+        my2d::Prefab deco;
+        deco.SetTag("Decoration");
+        {
+            my2d::SpriteRendererComponent spr;
+            spr.texturePath = "Textures/props.png";
+            spr.size = { 16.0f, 16.0f };
+            spr.layer = -2;
+            deco.AddComponent(spr);
+        }
+
+        const uint32_t decoCount = count / 4;
+        const uint32_t enemyCount = count - decoCount;
+
+        std::vector<my2d::TransformComponent> transforms(count);
+        for (uint32_t i = 0; i < count; ++i)
+            transforms[i].position = { 16.0f + (float)((i * 37u) % 8000u), 32.0f * (float)(i % 40u) };
+
+        scene.Instantiate(enemy, enemyCount, transforms.data());
+        scene.Instantiate(deco, decoCount, transforms.data() + enemyCount);
+    }
+
+    struct Probe
+    {
+        uint64_t id;
+        std::string tag;
+        float x, y;
+    };
+
+    std::vector<Probe> Collect(my2d::Scene& scene)
+    {
+        std::vector<Probe> out;
+        for (auto [e, id, tag, tr] : scene.Registry().view<my2d::IdComponent, my2d::TagComponent, my2d::TransformComponent>().each())
+            out.push_back({ id.id, tag.tag.Str(), tr.position.x, tr.position.y });
+        std::sort(out.begin(), out.end(), [](const Probe& a, const Probe& b) { return a.id < b.id; });
+        return out;
+    }
+
+    bool Same(const std::vector<Probe>& a, const std::vector<Probe>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].id != b[i].id || a[i].tag != b[i].tag || a[i].x != b[i].x || a[i].y != b[i].y)
+                return false;
+        }
+        return true;
+    }
+}
+
+int Bench_CookedLoad(int argc, char** argv)
+{
+    const int reps = (argc > 0) ? std::max(1, std::atoi(argv[0])) : 3;
+
+    std::vector<uint32_t> sizes;
+    for (int i = 1; i < argc; ++i)
+        sizes.push_back((uint32_t)std::strtoul(argv[i], nullptr, 10));
+    if (sizes.empty())
+        sizes = { 1000u, 10000u, 100000u };
+
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "my2d_cook_bench";
+    fs::create_directories(dir);
+
+    std::printf("Room load, json vs cooked .scene.bin, best of %d\n\n", reps);
+    std::printf("%10s %12s %12s %12s %12s %12s %10s\n",
+        "entities", "json KiB", "bin KiB", "json ms", "cook ms", "cooked ms", "speedup");
+
+    bool ok = true;
+    for (uint32_t count : sizes)
+    {
+        const fs::path jsonPath = dir / ("room" + std::to_string(count) + ".scene.json");
+        const std::string binPath = my2d::CookedScene::PathFor(jsonPath.string());
+        std::error_code ec;
+        fs::remove(binPath, ec);
+
+        {
+            my2d::Scene scene;
+            BuildRoom(scene, count);
+            if (!my2d::SceneSerializer::SaveToFile(scene, jsonPath.string()))
+            {
+                std::printf("ERROR: cannot write %s\n", jsonPath.string().c_str());
+                return 1;
+            }
+        }
+
+        double jsonMs = 1e30;
+        std::vector<Probe> fromJson;
+        for (int r = 0; r < reps; ++r)
+        {
+            my2d::Scene scene;
+            const double t0 = bench::NowMs();
+            ok = my2d::SceneSerializer::LoadFromJson(scene, jsonPath.string()) && ok;
+            jsonMs = std::min(jsonMs, bench::NowMs() - t0);
+            if (r == 0)
+                fromJson = Collect(scene);
+        }
+
+        double t0 = bench::NowMs();
+        ok = my2d::SceneSerializer::Cook(jsonPath.string()) && ok;
+        const double cookMs = bench::NowMs() - t0;
+
+        if (!my2d::CookedScene::IsUpToDate(binPath))
+        {
+            std::printf("ERROR: %s not up to date right after cooking\n", binPath.c_str());
+            return 1;
+        }
+
+        double cookedMs = 1e30;
+        std::vector<Probe> fromBin;
+        for (int r = 0; r < reps; ++r)
+        {
+            my2d::Scene scene;
+            t0 = bench::NowMs();
+            ok = my2d::SceneSerializer::LoadFromFile(scene, jsonPath.string()) && ok;
+            cookedMs = std::min(cookedMs, bench::NowMs() - t0);
+            if (r == 0)
+                fromBin = Collect(scene);
+        }
+
+        const double jsonKiB = (double)fs::file_size(jsonPath, ec) / 1024.0;
+        const double binKiB = (double)fs::file_size(binPath, ec) / 1024.0;
+        std::printf("%10zu %12.1f %12.1f %12.3f %12.3f %12.3f %9.1fx\n",
+            fromJson.size(), jsonKiB, binKiB, jsonMs, cookMs, cookedMs, cookedMs > 0.0 ? jsonMs / cookedMs : 0.0);
+
+        if (!Same(fromJson, fromBin))
+        {
+            std::printf("ERROR: cooked load differs from the json load (%zu vs %zu entities)\n", fromBin.size(), fromJson.size());
+            ok = false;
+        }
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    if (!ok)
+    {
+        std::printf("ERROR: a load failed\n");
+        return 1;
+    }
+    return 0;
+}
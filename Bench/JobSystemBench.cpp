@@ -0,0 +1,84 @@
+#include "Benchmarks.h"
+
+#include "Core/JobSystem.h"
+#include "Scene/Scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// Synthetic per-entity workload over an EnTT view at 1..N threads (main + workers).
+namespace
+{
+    struct BenchVelocity
+    {
+        glm::vec2 v{ 0.0f, 0.0f };
+    };
+
+    void Integrate(my2d::TransformComponent& t, BenchVelocity& vel, int workIters)
+    {
+        // Enough dependent math to dominate memory traffic, like a small steering/AI update.
+        float x = t.position.x;
+        float y = t.position.y;
+        for (int i = 0; i < workIters; ++i)
+        {
+            const float a = std::sin(x * 0.01f) + std::cos(y * 0.01f);
+            vel.v.x = vel.v.x * 0.99f + a * 0.1f;
+            vel.v.y = vel.v.y * 0.99f - a * 0.1f;
+            x += vel.v.x * (1.0f / 60.0f);
+            y += vel.v.y * (1.0f / 60.0f);
+        }
+        t.position = { x, y };
+    }
+}
+
+int Bench_JobScaling(int argc, char** argv)
+{
+    const uint32_t entities = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 100000u;
+    const int workIters = (argc > 1) ? std::atoi(argv[1]) : 64;
+    const int reps = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 5;
+
+    my2d::Scene scene;
+    auto& reg = scene.Registry();
+    for (uint32_t i = 0; i < entities; ++i)
+    {
+        const entt::entity e = reg.create();
+        reg.emplace<my2d::TransformComponent>(e).position = { (float)(i % 1000), (float)(i / 1000) };
+        reg.emplace<BenchVelocity>(e);
+    }
+
+    const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("jobs: %u entities, %d work iters/entity, best of %d\n", entities, workIters, reps);
+    std::printf("%8s %12s %10s %12s\n", "threads", "ms", "speedup", "efficiency");
+
+    double baseMs = 0.0;
+    for (uint32_t threads = 1; threads <= maxThreads; ++threads)
+    {
+        my2d::JobSystem jobs;
+        jobs.Initialize(threads - 1);
+
+        auto view = reg.view<my2d::TransformComponent, BenchVelocity>();
+
+        double best = 1e30;
+        for (int r = 0; r < reps; ++r)
+        {
+            const double t0 = bench::NowMs();
+            jobs.ParallelForEach(view, 512, [&](entt::entity e)
+                {
+                    Integrate(view.get<my2d::TransformComponent>(e), view.get<BenchVelocity>(e), workIters);
+                });
+            best = std::min(best, bench::NowMs() - t0);
+        }
+
+        jobs.Shutdown();
+
+        if (threads == 1) baseMs = best;
+        const double speedup = (best > 0.0) ? baseMs / best : 0.0;
+        std::printf("%8u %12.3f %9.2fx %11.0f%%\n", threads, best, speedup, 100.0 * speedup / threads);
+    }
+
+    return 0;
+}
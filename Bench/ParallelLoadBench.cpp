@@ -0,0 +1,158 @@
+#include "Benchmarks.h"
+
+#include "Core/JobSystem.h"
+#include "Scene/Scene.h"
+#include "Scene/SceneSerializer.h"
+#include "Scene/StateHash.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// JSON room load on 1..N threads: LoadFromJsonParallel (parallel parse into staging, bulk commit on the
+// main thread) against the single-threaded DOM loader. Every 4th entity uses a prefab and every 8th has a
+// parent further down the file, so the commit does prefab stamps, overrides and forward links too.
+// Each parallel load is checked against the DOM load with Scene_HashState.
+namespace
+{
+    bool WritePrefab(const std::filesystem::path& path)
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "{ \"prefabVersion\": 1, \"entity\": { \"tag\": \"Enemy\","
+            " \"Transform\": { \"scale\": { \"x\": 2, \"y\": 2 } },"
+            " \"SpriteRenderer\": { \"texturePath\": \"Textures/enemy.png\", \"size\": { \"x\": 32, \"y\": 32 }, \"layer\": 5 },"
+            " \"Team\": { \"team\": \"Enemy\" }, \"Health\": { \"hp\": 3, \"maxHp\": 3 } } }\n";
+        return (bool)out;
+    }
+
+    bool WriteScene(const std::filesystem::path& path, const std::string& prefabName, uint32_t count)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            return false;
+
+        out << "{\n  \"sceneVersion\": 1,\n  \"entities\": [\n";
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint32_t x = (i % 200u) * 40u;
+            const uint32_t y = (i / 200u) * 40u;
+
+            char parent[48] = "";
+            if (i % 8 == 0 && i + 1 < count)
+                std::snprintf(parent, sizeof(parent), ", \"parent\": %u", 1000u + i + 1);
+
+            char line[768];
+            if (i % 4 == 0)
+            {
+                std::snprintf(line, sizeof(line),
+                    "    { \"id\": %u, \"prefab\": \"%s\","
+                    " \"Transform\": { \"position\": { \"x\": %u, \"y\": %u } }, \"Health\": { \"hp\": 5, \"maxHp\": 5 }%s }%s\n",
+                    1000u + i, prefabName.c_str(), x, y, parent, (i + 1 < count) ? "," : "");
+            }
+            else
+            {
+                std::snprintf(line, sizeof(line),
+                    "    { \"id\": %u, \"tag\": \"Enemy\","
+                    " \"Transform\": { \"position\": { \"x\": %u, \"y\": %u }, \"rotationDeg\": 0, \"scale\": { \"x\": 1, \"y\": 1 } },"
+                    " \"SpriteRenderer\": { \"texturePath\": \"Textures/enemy.png\", \"size\": { \"x\": 32, \"y\": 32 }, \"layer\": 5 },"
+                    " \"RigidBody2D\": { \"type\": \"Dynamic\", \"fixedRotation\": true, \"gravityScale\": 1.0 },"
+                    " \"BoxCollider2D\": { \"size\": { \"x\": 28, \"y\": 30 }, \"offset\": { \"x\": 2, \"y\": 2 }, \"friction\": 0.2 },"
+                    " \"Team\": { \"team\": \"Enemy\" }, \"Health\": { \"hp\": 3, \"maxHp\": 3 }%s }%s\n",
+                    1000u + i, x, y, parent, (i + 1 < count) ? "," : "");
+            }
+            out << line;
+        }
+        out << "  ]\n}\n";
+        return (bool)out;
+    }
+
+    struct Result
+    {
+        double ms = 1e30;
+        size_t entities = 0;
+        uint64_t hash = 0;
+    };
+
+    template<typename LoadFn>
+    Result Run(LoadFn&& load, int reps)
+    {
+        Result r;
+        for (int i = 0; i < reps; ++i)
+        {
+            my2d::Scene scene;
+            const double t0 = bench::NowMs();
+            const bool ok = load(scene);
+            r.ms = std::min(r.ms, bench::NowMs() - t0);
+
+            r.entities = ok ? scene.Registry().view<my2d::IdComponent>().size() : 0;
+            r.hash = my2d::Scene_HashState(scene);
+        }
+        return r;
+    }
+}
+
+int Bench_ParallelLoad(int argc, char** argv)
+{
+    const uint32_t count = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 100000u;
+    const int reps = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 3;
+
+    std::vector<uint32_t> threadCounts;
+    for (int i = 2; i < argc; ++i)
+        threadCounts.push_back(std::max(1u, (uint32_t)std::strtoul(argv[i], nullptr, 10)));
+    if (threadCounts.empty())
+        threadCounts = { 1, 2, 4, 8 };
+
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path();
+    const std::string prefabName = "my2d_parallel_bench.prefab.json";
+    const fs::path path = dir / "my2d_parallel_bench.scene.json";
+    if (!WritePrefab(dir / prefabName) || !WriteScene(path, prefabName, count))
+    {
+        std::printf("ERROR: cannot write %s\n", path.string().c_str());
+        return 1;
+    }
+
+    std::error_code ec;
+    const double fileMiB = (double)fs::file_size(path, ec) / (1024.0 * 1024.0);
+    const std::string file = path.string();
+
+    const Result dom = Run([&](my2d::Scene& scene) { return my2d::SceneSerializer::LoadFromJson(scene, file); }, reps);
+
+    std::printf("JSON room load: %u entities, %.1f MiB file, best of %d (%u hardware threads)\n\n",
+        count, fileMiB, reps, std::thread::hardware_concurrency());
+    std::printf("%-10s %8s %12s %10s %10s %8s\n", "loader", "threads", "ms", "speedup", "vs dom", "state");
+    std::printf("%-10s %8u %12.3f %10s %9.2fx %8s\n", "dom", 1u, dom.ms, "-", 1.0, "ref");
+
+    bool failed = dom.entities != count;
+    double baseMs = 0.0;
+    for (uint32_t threads : threadCounts)
+    {
+        my2d::JobSystem jobs;
+        jobs.Initialize(threads - 1);
+
+        const Result par = Run([&](my2d::Scene& scene) { return my2d::SceneSerializer::LoadFromJsonParallel(scene, file, jobs); }, reps);
+        jobs.Shutdown();
+
+        if (baseMs == 0.0)
+            baseMs = par.ms;
+
+        const bool same = par.entities == dom.entities && par.hash == dom.hash;
+        failed = failed || !same;
+        std::printf("%-10s %8u %12.3f %9.2fx %9.2fx %8s\n", "parallel", threads, par.ms, baseMs / par.ms, dom.ms / par.ms,
+            same ? "same" : "DIFF");
+    }
+
+    fs::remove(path, ec);
+    fs::remove(dir / prefabName, ec);
+
+    if (failed)
+    {
+        std::printf("ERROR: expected %u entities and the DOM load's state from every load\n", count);
+        return 1;
+    }
+    return 0;
+}
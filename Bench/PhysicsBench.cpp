@@ -0,0 +1,106 @@
+#include "Benchmarks.h"
+
+#include "Core/JobSystem.h"
+#include "Physics/PhysicsWorld.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Box2D step time vs dynamic body count and solver thread count.
+// The room is a closed box with a grid of crates dropped into it, so most bodies end up touching.
+namespace
+{
+    void BuildRoom(my2d::PhysicsWorld& physics, uint32_t bodies)
+    {
+        const b2WorldId world = physics.WorldId();
+
+        const uint32_t columns = 100;
+        const float roomHalfW = columns * 0.55f + 2.0f;
+
+        b2BodyDef ground = b2DefaultBodyDef();
+        const b2BodyId groundId = b2CreateBody(world, &ground);
+        b2ShapeDef sd = b2DefaultShapeDef();
+
+        const b2Polygon floor = b2MakeOffsetBox(roomHalfW, 1.0f, b2Vec2{ 0.0f, 1.0f }, b2MakeRot(0.0f));
+        const b2Polygon left = b2MakeOffsetBox(1.0f, 200.0f, b2Vec2{ -roomHalfW, -200.0f }, b2MakeRot(0.0f));
+        const b2Polygon right = b2MakeOffsetBox(1.0f, 200.0f, b2Vec2{ roomHalfW, -200.0f }, b2MakeRot(0.0f));
+        b2CreatePolygonShape(groundId, &sd, &floor);
+        b2CreatePolygonShape(groundId, &sd, &left);
+        b2CreatePolygonShape(groundId, &sd, &right);
+
+        // y+ is down, same as the game
+        const b2Polygon crate = b2MakeBox(0.25f, 0.25f);
+        for (uint32_t i = 0; i < bodies; ++i)
+        {
+            b2BodyDef bd = b2DefaultBodyDef();
+            bd.type = b2_dynamicBody;
+            bd.position = b2Vec2{ -roomHalfW + 1.5f + (float)(i % columns) * 1.1f + ((i / columns) % 2) * 0.3f,
+                                  -1.0f - (float)(i / columns) * 1.1f };
+            const b2BodyId id = b2CreateBody(world, &bd);
+
+            b2ShapeDef cs = b2DefaultShapeDef();
+            cs.density = 1.0f;
+            b2CreatePolygonShape(id, &cs, &crate);
+        }
+    }
+}
+
+int Bench_PhysicsStep(int argc, char** argv)
+{
+    std::vector<uint32_t> bodyCounts;
+    for (int i = 0; i < argc; ++i)
+        bodyCounts.push_back((uint32_t)std::strtoul(argv[i], nullptr, 10));
+    if (bodyCounts.empty())
+        bodyCounts = { 1000, 2000, 4000, 8000 };
+
+    const int warmupSteps = 120;  // let the pile settle into contact
+    const int measuredSteps = 240;
+    const int subSteps = 4;
+    const float dt = 1.0f / 60.0f;
+
+    const uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::printf("physics: %d sub-steps, %d warmup + %d measured steps\n", subSteps, warmupSteps, measuredSteps);
+    std::printf("%8s %8s %12s %12s %10s\n", "bodies", "threads", "avg ms", "max ms", "speedup");
+
+    for (uint32_t bodies : bodyCounts)
+    {
+        double baseAvg = 0.0;
+        for (uint32_t threads = 1; threads <= maxThreads; ++threads)
+        {
+            my2d::JobSystem jobs;
+            jobs.Initialize(threads - 1);
+
+            my2d::PhysicsWorld physics;
+            physics.Initialize(b2Vec2{ 0.0f, 9.8f }, &jobs, threads);
+            physics.SetSubSteps(subSteps);
+            BuildRoom(physics, bodies);
+
+            for (int s = 0; s < warmupSteps; ++s)
+                physics.Step(dt);
+
+            double total = 0.0;
+            double worst = 0.0;
+            for (int s = 0; s < measuredSteps; ++s)
+            {
+                const double t0 = bench::NowMs();
+                physics.Step(dt);
+                const double ms = bench::NowMs() - t0;
+                total += ms;
+                worst = std::max(worst, ms);
+            }
+
+            physics.Shutdown();
+            jobs.Shutdown();
+
+            const double avg = total / measuredSteps;
+            if (threads == 1) baseAvg = avg;
+            std::printf("%8u %8u %12.3f %12.3f %9.2fx\n", bodies, threads, avg, worst, (avg > 0.0) ? baseAvg / avg : 0.0);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Iterating Transform + RigidBody2D + BoxCollider2D the way Physics_CreateRuntime does:
+// a plain view (sparse-set intersection, random access into three pools) vs Scene::PhysicsGroup().
+// Components are added in a different shuffled order per pool, like a scene that has seen some churn,
+// and half the transforms belong to non-physics entities.
+namespace
+{
+    void Populate(entt::registry& reg, uint32_t bodies, uint32_t others)
+    {
+        std::mt19937 rng(7);
+
+        std::vector<entt::entity> all(bodies + others);
+        for (auto& e : all)
+        {
+            e = reg.create();
+            reg.emplace<my2d::TransformComponent>(e).position = { (float)(rng() % 4096), (float)(rng() % 4096) };
+        }
+
+        std::vector<entt::entity> physics(all.begin(), all.end());
+        std::shuffle(physics.begin(), physics.end(), rng);
+        physics.resize(bodies);
+
+        for (auto e : physics)
+            reg.emplace<my2d::RigidBody2DComponent>(e);
+
+        std::shuffle(physics.begin(), physics.end(), rng);
+        for (auto e : physics)
+            reg.emplace<my2d::BoxCollider2DComponent>(e).size = { 16.0f + (float)(rng() % 32), 16.0f + (float)(rng() % 32) };
+    }
+
+    // Same shape as the sync: read collider + body, write transform + previous transform
+    inline void Touch(my2d::TransformComponent& tc, my2d::RigidBody2DComponent& rb, my2d::BoxCollider2DComponent& bc)
+    {
+        if (!rb.enabled || !bc.enabled)
+            return;
+
+        rb.prevPosition = tc.position;
+        rb.prevRotationDeg = tc.rotationDeg;
+        tc.position.x += bc.size.x * 0.001f;
+        tc.position.y -= bc.size.y * 0.001f;
+    }
+
+    template<typename Fn>
+    double BestOf(int reps, Fn&& fn)
+    {
+        double best = 1e30;
+        for (int r = 0; r < reps; ++r)
+        {
+            const double t0 = bench::NowMs();
+            fn();
+            best = std::min(best, bench::NowMs() - t0);
+        }
+        return best;
+    }
+}
+
+int Bench_PhysicsGroup(int argc, char** argv)
+{
+    const uint32_t bodies = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 50000u;
+    const uint32_t others = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : bodies;
+    const int reps = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 50;
+
+    // Before: bare registry, no group
+    entt::registry plain;
+    Populate(plain, bodies, others);
+
+    // After: the Scene creates its owning group in the constructor
+    my2d::Scene scene;
+    Populate(scene.Registry(), bodies, others);
+
+    auto view = plain.view<my2d::TransformComponent, my2d::RigidBody2DComponent, my2d::BoxCollider2DComponent>();
+    auto group = scene.PhysicsGroup();
+
+    uint32_t viewCount = 0;
+    const double viewMs = BestOf(reps, [&]()
+        {
+            viewCount = 0;
+            for (auto e : view)
+            {
+                Touch(view.get<my2d::TransformComponent>(e), view.get<my2d::RigidBody2DComponent>(e), view.get<my2d::BoxCollider2DComponent>(e));
+                ++viewCount;
+            }
+        });
+
+    uint32_t eachCount = 0;
+    const double viewEachMs = BestOf(reps, [&]()
+        {
+            eachCount = 0;
+            for (auto [e, tc, rb, bc] : view.each())
+            {
+                Touch(tc, rb, bc);
+                ++eachCount;
+            }
+        });
+
+    uint32_t groupCount = 0;
+    const double groupMs = BestOf(reps, [&]()
+        {
+            groupCount = 0;
+            for (auto [e, tc, rb, bc] : group.each())
+            {
+                Touch(tc, rb, bc);
+                ++groupCount;
+            }
+        });
+
+    std::printf("Physics iteration: %u bodies + %u transform-only entities, best of %d\n\n", bodies, others, reps);
+    std::printf("%-14s %10s %12s %12s\n", "method", "entities", "ms", "ns/entity");
+    auto row = [](const char* name, uint32_t n, double ms)
+        {
+            std::printf("%-14s %10u %12.3f %12.2f\n", name, n, ms, n ? ms * 1e6 / n : 0.0);
+        };
+    row("view get<>", viewCount, viewMs);
+    row("view each()", eachCount, viewEachMs);
+    row("group each()", groupCount, groupMs);
+
+    if (groupMs > 0.0)
+        std::printf("\ngroup speedup: %.2fx over view get<>, %.2fx over view each()\n", viewMs / groupMs, viewEachMs / groupMs);
+
+    if (viewCount != bodies || eachCount != bodies || groupCount != bodies)
+    {
+        std::printf("ERROR: expected %u entities per pass\n", bodies);
+        return 1;
+    }
+    return 0;
+}
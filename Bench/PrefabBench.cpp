@@ -0,0 +1,173 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+#include "Scene/Prefab.h"
+#include "Scene/SceneSerializer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Spawning N copies of one enemy prefab:
+//   reparse      - read + parse the prefab file for every entity (what scene loads used to do)
+//   cached       - parse once, then CreateEntity + Stamp one entity at a time
+//   instantiate  - parse once, Scene::Instantiate (range create/insert)
+// plus a full scene file load of N prefab entities through SceneSerializer (prefab parsed once per load).
+namespace
+{
+    const char* kPrefabJson = R"({
+  "prefabVersion": 1,
+  "entity": {
+    "tag": "Enemy",
+    "Transform": { "position": { "x": 0, "y": 0 }, "rotationDeg": 0, "scale": { "x": 1, "y": 1 } },
+    "SpriteRenderer": { "texturePath": "Textures/enemy.png", "size": { "x": 32, "y": 32 }, "layer": 5 },
+    "RigidBody2D": { "type": "Dynamic", "fixedRotation": true, "gravityScale": 1.0 },
+    "BoxCollider2D": { "size": { "x": 28, "y": 30 }, "offset": { "x": 2, "y": 2 }, "friction": 0.2 },
+    "Facing": { "facing": 1 },
+    "Team": { "team": "Enemy" },
+    "Health": { "hp": 3, "maxHp": 3 },
+    "Hurtbox": { "enabled": true },
+    "EnemyAI": { "patrolSpeedPx": 60, "chaseSpeedPx": 90, "aggroRangePx": 260 }
+  }
+})";
+
+    bool WriteFile(const std::filesystem::path& p, const std::string& text)
+    {
+        std::ofstream out(p, std::ios::binary);
+        if (!out) return false;
+        out << text;
+        return (bool)out;
+    }
+
+    std::string MakeSceneJson(uint32_t count)
+    {
+        std::string s = "{\n  \"sceneVersion\": 1,\n  \"entities\": [\n";
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            char line[256];
+            std::snprintf(line, sizeof(line),
+                "    { \"id\": %u, \"prefab\": \"enemy.prefab.json\", \"Transform\": { \"position\": { \"x\": %u, \"y\": %u } } }%s\n",
+                1000u + i, (i % 200u) * 40u, (i / 200u) * 40u, (i + 1 < count) ? "," : "");
+            s += line;
+        }
+        s += "  ]\n}\n";
+        return s;
+    }
+}
+
+int Bench_PrefabSpawn(int argc, char** argv)
+{
+    const uint32_t count = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 500u;
+
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "my2d_prefab_bench";
+    fs::create_directories(dir);
+    const fs::path prefabPath = dir / "enemy.prefab.json";
+    const fs::path scenePath = dir / "room.scene.json";
+
+    if (!WriteFile(prefabPath, kPrefabJson) || !WriteFile(scenePath, MakeSceneJson(count)))
+    {
+        std::printf("ERROR: cannot write bench files under %s\n", dir.string().c_str());
+        return 1;
+    }
+
+    std::vector<my2d::TransformComponent> transforms(count);
+    for (uint32_t i = 0; i < count; ++i)
+        transforms[i].position = { (float)((i % 200u) * 40u), (float)((i / 200u) * 40u) };
+
+    // reparse
+    double reparseMs = 0.0;
+    size_t reparseEntities = 0;
+    {
+        my2d::Scene scene;
+        const double t0 = bench::NowMs();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            my2d::Prefab prefab;
+            if (!prefab.LoadFromFile(prefabPath.string()))
+                break;
+
+            const entt::entity e = scene.CreateEntity(prefab.Tag()).Handle();
+            scene.Registry().get<my2d::TransformComponent>(e) = transforms[i];
+            prefab.Stamp(scene.Registry(), &e, &e + 1);
+        }
+        reparseMs = bench::NowMs() - t0;
+        reparseEntities = scene.Registry().view<my2d::RigidBody2DComponent>().size();
+    }
+
+    my2d::Prefab prefab;
+    const double parseT0 = bench::NowMs();
+    if (!prefab.LoadFromFile(prefabPath.string()))
+    {
+        std::printf("ERROR: prefab failed to load\n");
+        return 1;
+    }
+    const double parseMs = bench::NowMs() - parseT0;
+
+    // cached, one at a time
+    double cachedMs = 0.0;
+    size_t cachedEntities = 0;
+    {
+        my2d::Scene scene;
+        const double t0 = bench::NowMs();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const entt::entity e = scene.CreateEntity(prefab.Tag()).Handle();
+            scene.Registry().get<my2d::TransformComponent>(e) = transforms[i];
+            prefab.Stamp(scene.Registry(), &e, &e + 1);
+        }
+        cachedMs = bench::NowMs() - t0;
+        cachedEntities = scene.Registry().view<my2d::RigidBody2DComponent>().size();
+    }
+
+    // bulk
+    double bulkMs = 0.0;
+    size_t bulkEntities = 0;
+    {
+        my2d::Scene scene;
+        const double t0 = bench::NowMs();
+        scene.Instantiate(prefab, count, transforms.data());
+        bulkMs = bench::NowMs() - t0;
+        bulkEntities = scene.Registry().view<my2d::RigidBody2DComponent>().size();
+    }
+
+    // whole scene file
+    double sceneMs = 0.0;
+    size_t sceneEntities = 0;
+    {
+        my2d::Scene scene;
+        const double t0 = bench::NowMs();
+        const bool ok = my2d::SceneSerializer::LoadFromJson(scene, scenePath.string());
+        sceneMs = bench::NowMs() - t0;
+        sceneEntities = ok ? scene.Registry().view<my2d::RigidBody2DComponent>().size() : 0;
+    }
+
+    std::printf("Prefab spawn: %u entities of one prefab (%zu components, parse %.3f ms)\n\n",
+        count, prefab.ComponentCount(), parseMs);
+    std::printf("%-22s %10s %12s %12s\n", "method", "entities", "ms", "us/entity");
+    auto row = [](const char* name, size_t n, double ms)
+        {
+            std::printf("%-22s %10zu %12.3f %12.3f\n", name, n, ms, n ? ms * 1e3 / (double)n : 0.0);
+        };
+    row("reparse per entity", reparseEntities, reparseMs);
+    row("cached, one by one", cachedEntities, cachedMs);
+    row("Scene::Instantiate", bulkEntities, bulkMs);
+    row("scene file load", sceneEntities, sceneMs);
+
+    if (bulkMs > 0.0)
+        std::printf("\ninstantiate speedup: %.1fx over reparse, %.2fx over one by one\n", reparseMs / bulkMs, cachedMs / bulkMs);
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    if (reparseEntities != count || cachedEntities != count || bulkEntities != count || sceneEntities != count)
+    {
+        std::printf("ERROR: expected %u entities per method\n", count);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "Benchmarks.h"
+
+#include "Renderer/RenderQueue.h"
+#include "Scene/Components.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// Draw ordering cost only (no GPU): the old per-integer-layer rescan vs the sorted render queue.
+namespace
+{
+    volatile uint64_t s_sink = 0; // keeps the walks from being optimized out
+
+    // What Scene::OnRender used to do: find the layer range, then walk every sprite once per layer
+    uint64_t OrderByLayerScan(entt::registry& reg)
+    {
+        auto view = reg.view<my2d::TransformComponent, my2d::SpriteRendererComponent>();
+
+        bool hasAny = false;
+        int minLayer = 0;
+        int maxLayer = 0;
+        for (auto e : view)
+        {
+            const int layer = view.get<my2d::SpriteRendererComponent>(e).layer;
+            minLayer = hasAny ? std::min(minLayer, layer) : layer;
+            maxLayer = hasAny ? std::max(maxLayer, layer) : layer;
+            hasAny = true;
+        }
+
+        uint64_t visited = 0;
+        for (int L = minLayer; hasAny && L <= maxLayer; ++L)
+        {
+            for (auto e : view)
+            {
+                if (view.get<my2d::SpriteRendererComponent>(e).layer == L)
+                    visited += (uint64_t)e;
+            }
+        }
+        return visited;
+    }
+
+    uint64_t OrderByQueue(entt::registry& reg, my2d::RenderQueue& queue)
+    {
+        uint64_t visited = 0;
+        for (const auto& item : queue.Update(reg))
+            visited += (uint64_t)item.entity;
+        return visited;
+    }
+}
+
+int Bench_RenderQueue(int argc, char** argv)
+{
+    const int span = (argc > 0) ? std::max(1, std::atoi(argv[0])) : 21;
+
+    std::vector<uint32_t> counts;
+    for (int i = 1; i < argc; ++i)
+        counts.push_back((uint32_t)std::strtoul(argv[i], nullptr, 10));
+    if (counts.empty())
+        counts = { 1000, 10000, 50000 };
+
+    const int frames = 50;
+    const char* textures[] = { "a.png", "b.png", "c.png", "d.png", "e.png", "f.png", "g.png", "h.png" };
+
+    std::printf("Render ordering: layers %d..%d, %d frames per row (ms per frame)\n\n", -span / 2, -span / 2 + span - 1, frames);
+    std::printf("%10s %12s %12s %12s %14s\n", "sprites", "layer scan", "queue full", "queue idle", "queue 1% move");
+
+    for (uint32_t count : counts)
+    {
+        entt::registry reg;
+        my2d::RenderQueue queue;
+        queue.Connect(reg);
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> layerDist(-span / 2, -span / 2 + span - 1);
+        std::vector<entt::entity> entities;
+        entities.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const entt::entity e = reg.create();
+            reg.emplace<my2d::TransformComponent>(e);
+            my2d::SpriteRendererComponent sc;
+            sc.layer = layerDist(rng);
+            sc.texturePath = textures[rng() % 8];
+            reg.emplace<my2d::SpriteRendererComponent>(e, sc);
+            entities.push_back(e);
+        }
+
+        uint64_t sink = 0;
+
+        double t0 = bench::NowMs();
+        for (int f = 0; f < frames; ++f)
+            sink += OrderByLayerScan(reg);
+        const double scanMs = (bench::NowMs() - t0) / frames;
+
+        t0 = bench::NowMs();
+        for (int f = 0; f < frames; ++f)
+        {
+            queue.Invalidate();
+            sink += OrderByQueue(reg, queue);
+        }
+        const double fullMs = (bench::NowMs() - t0) / frames;
+
+        t0 = bench::NowMs();
+        for (int f = 0; f < frames; ++f)
+            sink += OrderByQueue(reg, queue);
+        const double idleMs = (bench::NowMs() - t0) / frames;
+
+        // 1% of sprites hop to another layer each frame (patch, so the signal path is what's measured)
+        const uint32_t movers = std::max(1u, count / 100);
+        double moveMs = 0.0;
+        for (int f = 0; f < frames; ++f)
+        {
+            for (uint32_t m = 0; m < movers; ++m)
+            {
+                const entt::entity e = entities[rng() % count];
+                reg.patch<my2d::SpriteRendererComponent>(e, [&](auto& sc) { sc.layer = layerDist(rng); });
+            }
+
+            t0 = bench::NowMs();
+            sink += OrderByQueue(reg, queue);
+            moveMs += bench::NowMs() - t0;
+        }
+        moveMs /= frames;
+
+        std::printf("%10u %12.3f %12.3f %12.3f %14.3f\n", count, scanMs, fullMs, idleMs, moveMs);
+
+        queue.Disconnect(reg);
+        s_sink = sink;
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "Benchmarks.h"
+
+#include "framework.h"
+#include "Gameplay/RoomManager.h"
+#include "Gameplay/ProgressionSystem.h"
+#include "Gameplay/CombatSystem.h"
+#include "Gameplay/EnemyAISystem.h"
+#include "Physics/PlatformerControllerSystem.h"
+#include "Physics/PhysicsSystem.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+// Records room_start headless in one Bench process, replays it in a second one and fails if any tick's
+// state hash differs. Separate processes on purpose: anything seeded per process (generated ids, address
+// order, ...) that leaks into the simulation or the hash shows up here and nowhere else.
+//   replaycheck [ticks]          parent: runs both children, exit code 1 on divergence
+//   replaycheck record <file> <ticks> / replaycheck replay <file>   (children)
+namespace
+{
+    // The game's per-step and per-frame systems, in the game's order, without rendering or hotkeys
+    class ReplayApp : public my2d::App
+    {
+    public:
+        bool OnInit(my2d::Engine& engine) override
+        {
+            return m_rooms.LoadRoom(engine, "Scenes/room_start.scene.json", "start");
+        }
+
+        void OnFixedUpdate(my2d::Engine& engine, double fixedDt) override
+        {
+            my2d::EnemyAI_FixedUpdate(engine, m_rooms.GetScene(), (float)fixedDt, m_rooms.GetPlayer());
+            my2d::PlatformerController_FixedUpdate(engine, m_rooms.GetScene(), (float)fixedDt);
+            my2d::Combat_PrePhysics(engine, m_rooms.GetScene(), (float)fixedDt);
+        }
+
+        void OnPostFixedUpdate(my2d::Engine& engine, double fixedDt) override
+        {
+            my2d::Combat_PostPhysics(engine, m_rooms.GetScene(), (float)fixedDt);
+            my2d::Physics_SyncTransforms(m_rooms.GetScene(), engine.GetPhysics(), engine.PixelsPerMeter());
+        }
+
+        void OnUpdate(my2d::Engine& engine, double dt) override
+        {
+            my2d::Progression_Update(engine, m_rooms.GetScene(), m_rooms.GetPlayer());
+            m_rooms.Update(engine, (float)dt);
+        }
+
+        my2d::Scene* GetActiveScene() override { return &m_rooms.GetScene(); }
+
+    private:
+        my2d::RoomManager m_rooms;
+    };
+
+    my2d::EngineConfig MakeConfig()
+    {
+        my2d::EngineConfig cfg;
+        cfg.headless = true;
+        cfg.contentRoot = "Game/Content";
+        return cfg;
+    }
+
+    int RunChild(const std::string& args)
+    {
+        std::string cmd = "\"" + std::string(bench::g_exePath) + "\" replaycheck " + args;
+#ifdef _WIN32
+        cmd = "\"" + cmd + "\""; // cmd /c strips one pair of outer quotes
+#endif
+        std::fflush(stdout);
+        return std::system(cmd.c_str());
+    }
+}
+
+int Bench_ReplayCheck(int argc, char** argv)
+{
+    if (argc >= 3 && std::strcmp(argv[0], "record") == 0)
+    {
+        my2d::EngineConfig cfg = MakeConfig();
+        cfg.recordInputPath = argv[1];
+
+        my2d::Engine engine;
+        ReplayApp app;
+        return engine.RunHeadless(cfg, app, std::strtoull(argv[2], nullptr, 10));
+    }
+
+    if (argc >= 2 && std::strcmp(argv[0], "replay") == 0)
+    {
+        my2d::EngineConfig cfg = MakeConfig();
+        cfg.replayInputPath = argv[1];
+
+        my2d::Engine engine;
+        ReplayApp app;
+        return engine.RunReplay(cfg, app);
+    }
+
+    const uint64_t ticks = (argc > 0) ? std::strtoull(argv[0], nullptr, 10) : 600;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "my2d_replay_check.m2ir";
+    const std::string file = "\"" + path.string() + "\"";
+
+    if (RunChild("record " + file + " " + std::to_string(ticks)) != 0)
+    {
+        std::printf("replaycheck: recording run failed\n");
+        return 1;
+    }
+
+    const int rc = RunChild("replay " + file);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+
+    if (rc != 0)
+    {
+        std::printf("replaycheck: FAILED, the replay process diverged from the recording (exit code %d)\n", rc);
+        return 1;
+    }
+
+    std::printf("replaycheck: OK, %llu ticks replayed in a second process with matching state hashes\n",
+        (unsigned long long)ticks);
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+#include "Scene/SceneSerializer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// JSON room load, DOM (LoadFromJson) vs streaming SAX (LoadFromJsonStream): time and process peak RSS.
+// Peak RSS only goes up, so the streaming loader runs first and each row shows how far its loads pushed
+// the peak above what the process had before any load. Both build the same scene, so the difference
+// between the rows is the parser's own memory. The scene file is written line by line (no DOM).
+namespace
+{
+    size_t PeakRssBytes()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS pmc{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+            return (size_t)pmc.PeakWorkingSetSize;
+        return 0;
+#else
+        rusage ru{};
+        getrusage(RUSAGE_SELF, &ru);
+        return (size_t)ru.ru_maxrss * 1024; // KiB on Linux
+#endif
+    }
+
+    bool WriteScene(const std::filesystem::path& path, uint32_t count)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+            return false;
+
+        out << "{\n  \"sceneVersion\": 1,\n  \"entities\": [\n";
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            char line[768];
+            std::snprintf(line, sizeof(line),
+                "    { \"id\": %u, \"tag\": \"Enemy\","
+                " \"Transform\": { \"position\": { \"x\": %u, \"y\": %u }, \"rotationDeg\": 0, \"scale\": { \"x\": 1, \"y\": 1 } },"
+                " \"SpriteRenderer\": { \"texturePath\": \"Textures/enemy.png\", \"size\": { \"x\": 32, \"y\": 32 }, \"layer\": 5 },"
+                " \"RigidBody2D\": { \"type\": \"Dynamic\", \"fixedRotation\": true, \"gravityScale\": 1.0 },"
+                " \"BoxCollider2D\": { \"size\": { \"x\": 28, \"y\": 30 }, \"offset\": { \"x\": 2, \"y\": 2 }, \"friction\": 0.2 },"
+                " \"Team\": { \"team\": \"Enemy\" }, \"Health\": { \"hp\": 3, \"maxHp\": 3 } }%s\n",
+                1000u + i, (i % 200u) * 40u, (i / 200u) * 40u, (i + 1 < count) ? "," : "");
+            out << line;
+        }
+        out << "  ]\n}\n";
+        return (bool)out;
+    }
+
+    using LoadFn = bool (*)(my2d::Scene&, const std::string&, my2d::AssetManager*, std::vector<std::string>*);
+
+    struct Result
+    {
+        double ms = 1e30;
+        size_t peakGrowth = 0;
+        size_t entities = 0;
+    };
+
+    Result Run(LoadFn load, const std::string& path, int reps, size_t basePeak)
+    {
+        Result r;
+        for (int i = 0; i < reps; ++i)
+        {
+            my2d::Scene scene;
+            const double t0 = bench::NowMs();
+            if (load(scene, path, nullptr, nullptr))
+                r.entities = scene.Registry().view<my2d::IdComponent>().size();
+            r.ms = std::min(r.ms, bench::NowMs() - t0);
+        }
+        const size_t peak = PeakRssBytes();
+        r.peakGrowth = peak > basePeak ? peak - basePeak : 0;
+        return r;
+    }
+}
+
+int Bench_SaxLoad(int argc, char** argv)
+{
+    const uint32_t count = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 100000u;
+    const int reps = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 3;
+
+    namespace fs = std::filesystem;
+    const fs::path path = fs::temp_directory_path() / "my2d_sax_bench.scene.json";
+    if (!WriteScene(path, count))
+    {
+        std::printf("ERROR: cannot write %s\n", path.string().c_str());
+        return 1;
+    }
+
+    std::error_code ec;
+    const double fileMiB = (double)fs::file_size(path, ec) / (1024.0 * 1024.0);
+
+    const size_t basePeak = PeakRssBytes();
+    const Result sax = Run(&my2d::SceneSerializer::LoadFromJsonStream, path.string(), reps, basePeak);
+    const Result dom = Run(&my2d::SceneSerializer::LoadFromJson, path.string(), reps, basePeak);
+    fs::remove(path, ec);
+
+    std::printf("JSON room load: %u entities, %.1f MiB file, best of %d\n\n", count, fileMiB, reps);
+    std::printf("%-12s %10s %12s %18s\n", "loader", "entities", "ms", "peak RSS +MiB");
+    std::printf("%-12s %10zu %12.3f %18.1f\n", "sax stream", sax.entities, sax.ms, sax.peakGrowth / (1024.0 * 1024.0));
+    std::printf("%-12s %10zu %12.3f %18.1f\n", "dom", dom.entities, dom.ms, dom.peakGrowth / (1024.0 * 1024.0));
+
+    if (sax.entities != count || dom.entities != count)
+    {
+        std::printf("ERROR: expected %u entities from each loader\n", count);
+        return 1;
+    }
+    return 0;
+}
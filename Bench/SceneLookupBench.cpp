@@ -0,0 +1,87 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Scene::FindEntityById: the old linear IdComponent scan vs the id index.
+namespace
+{
+    entt::entity FindByScan(my2d::Scene& scene, uint64_t id)
+    {
+        auto view = scene.Registry().view<my2d::IdComponent>();
+        for (auto e : view)
+        {
+            if (view.get<my2d::IdComponent>(e).id == id)
+                return e;
+        }
+        return entt::null;
+    }
+}
+
+int Bench_IdLookup(int argc, char** argv)
+{
+    const uint32_t entityCount = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 100000u;
+    const uint32_t lookups = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 100000u;
+    const uint32_t scanLookups = (argc > 2) ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 1000u;
+
+    my2d::Scene scene;
+
+    double t0 = bench::NowMs();
+    std::vector<uint64_t> ids;
+    ids.reserve(entityCount);
+    scene.ReserveIds(entityCount);
+    for (uint32_t i = 0; i < entityCount; ++i)
+    {
+        auto e = scene.CreateEntity("Entity");
+        ids.push_back(e.Get<my2d::IdComponent>().id);
+    }
+    const double createMs = bench::NowMs() - t0;
+
+    // Same random references for every method
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<uint32_t> pick(0, entityCount - 1);
+    std::vector<uint64_t> queries(lookups);
+    for (auto& q : queries)
+        q = ids[pick(rng)];
+
+    std::printf("Id lookup: %u entities (created in %.2f ms)\n\n", entityCount, createMs);
+    std::printf("%-10s %10s %12s %14s\n", "method", "lookups", "total ms", "ns/lookup");
+
+    uint64_t misses = 0;
+
+    const uint32_t scans = std::min(scanLookups, lookups);
+    t0 = bench::NowMs();
+    for (uint32_t i = 0; i < scans; ++i)
+        misses += (FindByScan(scene, queries[i]) == entt::null);
+    const double scanMs = bench::NowMs() - t0;
+    std::printf("%-10s %10u %12.3f %14.1f\n", "scan", scans, scanMs, scans ? scanMs * 1e6 / scans : 0.0);
+
+    t0 = bench::NowMs();
+    for (uint32_t i = 0; i < lookups; ++i)
+        misses += !scene.FindEntityById(queries[i]);
+    const double indexMs = bench::NowMs() - t0;
+    std::printf("%-10s %10u %12.3f %14.1f\n", "index", lookups, indexMs, lookups ? indexMs * 1e6 / lookups : 0.0);
+
+    std::vector<entt::entity> resolved;
+    t0 = bench::NowMs();
+    scene.FindEntitiesByIds(queries, resolved);
+    const double bulkMs = bench::NowMs() - t0;
+    for (auto e : resolved)
+        misses += (e == entt::null);
+    std::printf("%-10s %10u %12.3f %14.1f\n", "bulk", lookups, bulkMs, lookups ? bulkMs * 1e6 / lookups : 0.0);
+
+    if (scans > 0 && lookups > 0 && indexMs > 0.0)
+        std::printf("\nindex speedup over scan: %.0fx\n", (scanMs / scans) / (indexMs / lookups));
+
+    if (misses != 0)
+    {
+        std::printf("ERROR: %llu lookups failed\n", (unsigned long long)misses);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,223 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+#include "Scene/Prefab.h"
+#include "Scene/SceneSerializer.h"
+#include "Scene/SceneSnapshot.h"
+#include "Physics/PhysicsWorld.h"
+#include "Physics/PhysicsSystem.h"
+#include "Physics/TilemapColliderBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+// Checkpoint restore of a large room: N enemy bodies on a 256x64 tilemap, simulated for a second.
+//   json      - SaveToFile + LoadFromJson + rebuild physics (what F9 used to do, minus the save file)
+//   snapshot  - SceneSnapshot::Capture, then Restore + rebuild physics + ApplyBodyStates
+// The restored bodies are checked against the captured ones (position and velocity, bit-exact).
+namespace
+{
+    constexpr float kPpm = 32.0f;
+    constexpr float kFixedDt = 1.0f / 60.0f;
+
+    void BuildRoom(my2d::Scene& scene, uint32_t enemies)
+    {
+        // Floor tiles along the bottom row + a few ledges
+        auto ground = scene.CreateEntity("Tilemap");
+        auto& tm = ground.Add<my2d::TilemapComponent>();
+        tm.width = 256;
+        tm.height = 64;
+        my2d::TileLayer layer;
+        layer.name = "Collision";
+        layer.tiles.assign((size_t)tm.width * tm.height, -1);
+        for (int x = 0; x < tm.width; ++x)
+        {
+            layer.tiles[(size_t)(tm.height - 1) * tm.width + x] = 0;
+            if (x % 16 < 6)
+                layer.tiles[(size_t)(tm.height - 12) * tm.width + x] = 0;
+        }
+        tm.layers.push_back(std::move(layer));
+        ground.Add<my2d::TilemapColliderComponent>();
+
+        my2d::Prefab enemy;
+        enemy.SetTag("Enemy");
+        {
+            my2d::SpriteRendererComponent spr;
+            spr.texturePath = "Textures/enemy.png";
+            spr.size = { 32.0f, 32.0f };
+            enemy.AddComponent(spr);
+
+            my2d::RigidBody2DComponent rb;
+            enemy.AddComponent(rb);
+
+            my2d::BoxCollider2DComponent bc;
+            bc.size = { 28.0f, 30.0f };
+            bc.categoryBits = my2d::PhysicsLayers::Enemy;
+            bc.maskBits = my2d::PhysicsLayers::Environment | my2d::PhysicsLayers::Enemy;
+            enemy.AddComponent(bc);
+
+            enemy.AddComponent(my2d::TeamComponent{ my2d::Team::Enemy });
+            enemy.AddComponent(my2d::HealthComponent{ 3, 3 });
+            enemy.AddComponent(my2d::HurtboxComponent{});
+            enemy.AddComponent(my2d::FacingComponent{});
+            enemy.AddComponent(my2d::EnemyAIComponent{});
+        }
+
+        std::vector<my2d::TransformComponent> transforms(enemies);
+        for (uint32_t i = 0; i < enemies; ++i)
+            transforms[i].position = { 16.0f + (float)((i * 37u) % 8000u), 32.0f * (float)(i % 40u) };
+
+        scene.Instantiate(enemy, enemies, transforms.data());
+    }
+
+    void BuildPhysics(my2d::Scene& scene, my2d::PhysicsWorld& physics)
+    {
+        physics.Shutdown();
+        physics.Initialize(b2Vec2{ 0.0f, 9.8f });
+        BuildTilemapColliders(physics, scene, kPpm);
+        my2d::Physics_CreateRuntime(scene, physics, kPpm);
+    }
+
+    struct BodyProbe
+    {
+        uint64_t id;
+        b2Vec2 p;
+        b2Vec2 v;
+    };
+
+    std::vector<BodyProbe> Probe(my2d::Scene& scene)
+    {
+        std::vector<BodyProbe> out;
+        for (auto [e, id, rb] : scene.Registry().view<my2d::IdComponent, my2d::RigidBody2DComponent>().each())
+        {
+            if (b2Body_IsValid(rb.bodyId))
+                out.push_back({ id.id, b2Body_GetPosition(rb.bodyId), b2Body_GetLinearVelocity(rb.bodyId) });
+        }
+        std::sort(out.begin(), out.end(), [](const BodyProbe& a, const BodyProbe& b) { return a.id < b.id; });
+        return out;
+    }
+
+    bool SameBodies(const std::vector<BodyProbe>& a, const std::vector<BodyProbe>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].id != b[i].id || a[i].p.x != b[i].p.x || a[i].p.y != b[i].p.y || a[i].v.x != b[i].v.x || a[i].v.y != b[i].v.y)
+                return false;
+        }
+        return true;
+    }
+}
+
+int Bench_SceneSnapshot(int argc, char** argv)
+{
+    const uint32_t enemies = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 5000u;
+    const int reps = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 10;
+
+    my2d::PhysicsWorld physics;
+    auto scene = std::make_unique<my2d::Scene>();
+    BuildRoom(*scene, enemies);
+    BuildPhysics(*scene, physics);
+
+    // Let things fall, collide and (some) go to sleep
+    for (int i = 0; i < 60; ++i)
+    {
+        physics.Step(kFixedDt);
+        my2d::Physics_SyncTransforms(*scene, physics, kPpm);
+    }
+
+    const size_t entityCount = scene->Registry().view<my2d::IdComponent>().size();
+    const std::vector<BodyProbe> reference = Probe(*scene);
+
+    // json round trip
+    namespace fs = std::filesystem;
+    const fs::path jsonPath = fs::temp_directory_path() / "my2d_snapshot_bench.scene.json";
+    double jsonSaveMs = 1e30, jsonLoadMs = 1e30;
+    size_t jsonBytes = 0;
+    for (int r = 0; r < reps; ++r)
+    {
+        double t0 = bench::NowMs();
+        if (!my2d::SceneSerializer::SaveToFile(*scene, jsonPath.string()))
+        {
+            std::printf("ERROR: cannot write %s\n", jsonPath.string().c_str());
+            return 1;
+        }
+        jsonSaveMs = std::min(jsonSaveMs, bench::NowMs() - t0);
+
+        my2d::PhysicsWorld loadedPhysics;
+        my2d::Scene loaded;
+        t0 = bench::NowMs();
+        my2d::SceneSerializer::LoadFromJson(loaded, jsonPath.string());
+        BuildPhysics(loaded, loadedPhysics);
+        jsonLoadMs = std::min(jsonLoadMs, bench::NowMs() - t0);
+    }
+    {
+        std::error_code ec;
+        jsonBytes = (size_t)fs::file_size(jsonPath, ec);
+        fs::remove(jsonPath, ec);
+    }
+
+    // snapshot
+    my2d::SceneSnapshot snapshot;
+    double captureMs = 1e30;
+    for (int r = 0; r < reps; ++r)
+    {
+        const double t0 = bench::NowMs();
+        snapshot.Capture(*scene);
+        captureMs = std::min(captureMs, bench::NowMs() - t0);
+    }
+
+    double restoreMs = 1e30, physicsMs = 1e30, bodiesMs = 1e30;
+    bool match = true;
+    for (int r = 0; r < reps; ++r)
+    {
+        // The live room goes away first, like RoomManager::RestoreCheckpoint
+        scene.reset();
+
+        double t0 = bench::NowMs();
+        scene = std::make_unique<my2d::Scene>();
+        if (!snapshot.Restore(*scene))
+        {
+            std::printf("ERROR: restore failed\n");
+            return 1;
+        }
+        restoreMs = std::min(restoreMs, bench::NowMs() - t0);
+
+        t0 = bench::NowMs();
+        BuildPhysics(*scene, physics);
+        physicsMs = std::min(physicsMs, bench::NowMs() - t0);
+
+        t0 = bench::NowMs();
+        snapshot.ApplyBodyStates(*scene);
+        bodiesMs = std::min(bodiesMs, bench::NowMs() - t0);
+
+        match = match && SameBodies(reference, Probe(*scene));
+    }
+
+    std::printf("Scene snapshot: %zu entities, %zu bodies, 256x64 tilemap, best of %d\n\n",
+        entityCount, reference.size(), reps);
+    std::printf("%-28s %12s %12s\n", "step", "ms", "KiB");
+    std::printf("%-28s %12.3f %12.1f\n", "json save", jsonSaveMs, jsonBytes / 1024.0);
+    std::printf("%-28s %12.3f\n", "json load + physics", jsonLoadMs);
+    std::printf("%-28s %12.3f %12.1f\n", "snapshot capture", captureMs, snapshot.SizeBytes() / 1024.0);
+    std::printf("%-28s %12.3f\n", "snapshot restore entities", restoreMs);
+    std::printf("%-28s %12.3f\n", "  + rebuild physics", physicsMs);
+    std::printf("%-28s %12.3f\n", "  + apply body states", bodiesMs);
+
+    const double snapshotTotal = restoreMs + physicsMs + bodiesMs;
+    if (snapshotTotal > 0.0)
+        std::printf("\nrestore speedup over json load: %.1fx\n", jsonLoadMs / snapshotTotal);
+
+    if (!match || snapshot.EntityCount() != entityCount)
+    {
+        std::printf("ERROR: restored bodies differ from the captured room\n");
+        return 1;
+    }
+    return 0;
+}
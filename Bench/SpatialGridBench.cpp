@@ -0,0 +1,125 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Scene::QueryRadius vs the old "distance to every entity" loops, plus the cost of keeping the grid
+// up to date when a slice of the scene moves every frame. Results are cross-checked.
+namespace
+{
+    uint32_t CountByScan(my2d::Scene& scene, const glm::vec2& center, float radius)
+    {
+        uint32_t hits = 0;
+        auto view = scene.Registry().view<my2d::TransformComponent, my2d::BoxCollider2DComponent>();
+        for (auto e : view)
+        {
+            glm::vec2 mn, mx;
+            my2d::SpatialGrid::ComputeBounds(scene.Registry(), e, mn, mx);
+            const float dx = center.x - std::clamp(center.x, mn.x, mx.x);
+            const float dy = center.y - std::clamp(center.y, mn.y, mx.y);
+            hits += (dx * dx + dy * dy <= radius * radius);
+        }
+        return hits;
+    }
+}
+
+int Bench_SpatialQuery(int argc, char** argv)
+{
+    const uint32_t entityCount = (argc > 0) ? (uint32_t)std::strtoul(argv[0], nullptr, 10) : 50000u;
+    const uint32_t queries = (argc > 1) ? (uint32_t)std::strtoul(argv[1], nullptr, 10) : 2000u;
+    const float radius = (argc > 2) ? (float)std::atof(argv[2]) : 200.0f;
+    const uint32_t movePercent = (argc > 3) ? (uint32_t)std::strtoul(argv[3], nullptr, 10) : 10u;
+
+    // Roughly constant density: ~1 entity per 128x128 px
+    const float worldSize = std::sqrt((float)entityCount) * 128.0f;
+
+    my2d::Scene scene;
+    auto& reg = scene.Registry();
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> coord(0.0f, worldSize);
+
+    std::vector<entt::entity> entities;
+    entities.reserve(entityCount);
+    for (uint32_t i = 0; i < entityCount; ++i)
+    {
+        auto e = scene.CreateEntity("Entity");
+        e.Get<my2d::TransformComponent>().position = { coord(rng), coord(rng) };
+        e.Add<my2d::BoxCollider2DComponent>().size = { 32.0f, 32.0f };
+        entities.push_back(e.Handle());
+    }
+
+    double t0 = bench::NowMs();
+    scene.Spatial().Rebuild(reg);
+    const double buildMs = bench::NowMs() - t0;
+
+    std::vector<glm::vec2> centers(queries);
+    for (auto& c : centers)
+        c = { coord(rng), coord(rng) };
+
+    std::printf("Spatial query: %u entities over %.0fx%.0f px, radius %.0f (grid built in %.2f ms, %zu cells)\n\n",
+        entityCount, worldSize, worldSize, radius, buildMs, scene.Spatial().CellCount());
+    std::printf("%-10s %10s %12s %14s\n", "method", "queries", "total ms", "us/query");
+
+    uint64_t scanHits = 0;
+    t0 = bench::NowMs();
+    for (const auto& c : centers)
+        scanHits += CountByScan(scene, c, radius);
+    const double scanMs = bench::NowMs() - t0;
+    std::printf("%-10s %10u %12.3f %14.2f\n", "scan", queries, scanMs, queries ? scanMs * 1e3 / queries : 0.0);
+
+    uint64_t gridHits = 0;
+    t0 = bench::NowMs();
+    for (const auto& c : centers)
+        gridHits += scene.QueryRadius(c, radius).size();
+    const double gridMs = bench::NowMs() - t0;
+    std::printf("%-10s %10u %12.3f %14.2f\n", "grid", queries, gridMs, queries ? gridMs * 1e3 / queries : 0.0);
+
+    if (gridMs > 0.0)
+        std::printf("\ngrid speedup over scan: %.0fx (%.1f hits/query)\n", scanMs / gridMs, queries ? (double)gridHits / queries : 0.0);
+
+    // Move a slice of the scene per "frame" (the way Physics_SyncTransforms does for awake bodies) and flush on the next query
+    const uint32_t moving = entityCount * std::min(movePercent, 100u) / 100u;
+    const int frames = 60;
+    std::uniform_real_distribution<float> step(-8.0f, 8.0f);
+
+    t0 = bench::NowMs();
+    for (int f = 0; f < frames; ++f)
+    {
+        for (uint32_t i = 0; i < moving; ++i)
+        {
+            auto& tc = reg.get<my2d::TransformComponent>(entities[i]);
+            tc.position += glm::vec2(step(rng), step(rng));
+            scene.MarkTransformChanged(entities[i]);
+        }
+        scene.QueryAABB({ 0.0f, 0.0f }, { 0.0f, 0.0f });
+    }
+    const double moveMs = bench::NowMs() - t0;
+    std::printf("update: %u moving entities/frame, %.3f ms/frame (incl. marking)\n", moving, moveMs / frames);
+
+    if (scanHits != gridHits)
+    {
+        std::printf("ERROR: scan found %llu hits, grid found %llu\n", (unsigned long long)scanHits, (unsigned long long)gridHits);
+        return 1;
+    }
+
+    // Still agrees after all the moves
+    uint64_t afterScan = 0, afterGrid = 0;
+    for (uint32_t i = 0; i < std::min(queries, 100u); ++i)
+    {
+        afterScan += CountByScan(scene, centers[i], radius);
+        afterGrid += scene.QueryRadius(centers[i], radius).size();
+    }
+    if (afterScan != afterGrid)
+    {
+        std::printf("ERROR: after moving, scan found %llu hits, grid found %llu\n", (unsigned long long)afterScan, (unsigned long long)afterGrid);
+        return 1;
+    }
+    return 0;
+}
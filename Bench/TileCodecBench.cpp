@@ -0,0 +1,134 @@
+#include "Benchmarks.h"
+
+#include "Scene/Scene.h"
+#include "Scene/SceneSerializer.h"
+#include "Scene/TileCodec.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+// One big tilemap saved and loaded as a legacy int array vs the "rle16" string:
+// file size, SaveToFile and LoadFromJson times, and a check that both loads give back the same tiles.
+namespace
+{
+    // Ground, platforms, some flipped decoration on a second layer; mostly empty like a real room
+    void BuildTilemap(my2d::Scene& scene, int width, int height)
+    {
+        auto e = scene.CreateEntity("Tilemap");
+        auto& tm = e.Add<my2d::TilemapComponent>();
+        tm.width = width;
+        tm.height = height;
+
+        my2d::TileLayer solid;
+        solid.name = "Collision";
+        solid.tiles.assign((size_t)width * height, -1);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                int& t = solid.tiles[(size_t)y * width + x];
+                if (y >= height - 4)
+                    t = 1 + (x % 3);
+                else if (y % 24 == 0 && (x / 8) % 5 < 3)
+                    t = 10 + (x % 8 == 0 ? 1 : 0);
+            }
+        }
+
+        my2d::TileLayer deco;
+        deco.name = "Decoration";
+        deco.layer = -1;
+        deco.tiles.assign((size_t)width * height, -1);
+        for (size_t i = 0; i < deco.tiles.size(); i += 13)
+            deco.tiles[i] = (int)(40 + i % 20) | ((i % 2) ? (int)0x80000000u : 0);
+
+        tm.layers.push_back(std::move(solid));
+        tm.layers.push_back(std::move(deco));
+    }
+
+    struct Result
+    {
+        size_t bytes = 0;
+        double saveMs = 1e30;
+        double loadMs = 1e30;
+        std::vector<std::vector<int>> tiles;
+    };
+
+    bool Run(my2d::Scene& scene, const std::filesystem::path& path, int reps, Result& out)
+    {
+        for (int r = 0; r < reps; ++r)
+        {
+            double t0 = bench::NowMs();
+            if (!my2d::SceneSerializer::SaveToFile(scene, path.string()))
+                return false;
+            out.saveMs = std::min(out.saveMs, bench::NowMs() - t0);
+
+            my2d::Scene loaded;
+            t0 = bench::NowMs();
+            if (!my2d::SceneSerializer::LoadFromJson(loaded, path.string()))
+                return false;
+            out.loadMs = std::min(out.loadMs, bench::NowMs() - t0);
+
+            out.tiles.clear();
+            for (auto [e, tm] : loaded.Registry().view<my2d::TilemapComponent>().each())
+            {
+                for (const auto& layer : tm.layers)
+                    out.tiles.push_back(layer.tiles);
+            }
+        }
+
+        std::error_code ec;
+        out.bytes = (size_t)std::filesystem::file_size(path, ec);
+        std::filesystem::remove(path, ec);
+        return true;
+    }
+}
+
+int Bench_TileCodec(int argc, char** argv)
+{
+    const int width = (argc > 0) ? std::max(1, std::atoi(argv[0])) : 1000;
+    const int height = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 1000;
+    const int reps = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 3;
+
+    my2d::Scene scene;
+    BuildTilemap(scene, width, height);
+
+    std::vector<std::vector<int>> reference;
+    for (auto [e, tm] : scene.Registry().view<my2d::TilemapComponent>().each())
+    {
+        for (const auto& layer : tm.layers)
+            reference.push_back(layer.tiles);
+    }
+
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path();
+
+    Result legacy, compact;
+    my2d::SceneSerializer::SetCompactTiles(false);
+    const bool legacyOk = Run(scene, dir / "my2d_tiles_array.scene.json", reps, legacy);
+    my2d::SceneSerializer::SetCompactTiles(true);
+    const bool compactOk = Run(scene, dir / "my2d_tiles_rle16.scene.json", reps, compact);
+
+    if (!legacyOk || !compactOk)
+    {
+        std::printf("ERROR: save/load failed under %s\n", dir.string().c_str());
+        return 1;
+    }
+
+    std::printf("Tilemap %dx%d, %zu layers, best of %d\n\n", width, height, reference.size(), reps);
+    std::printf("%-10s %12s %12s %12s\n", "tiles", "KiB", "save ms", "load ms");
+    std::printf("%-10s %12.1f %12.3f %12.3f\n", "array", legacy.bytes / 1024.0, legacy.saveMs, legacy.loadMs);
+    std::printf("%-10s %12.1f %12.3f %12.3f\n", "rle16", compact.bytes / 1024.0, compact.saveMs, compact.loadMs);
+    if (compact.bytes > 0 && compact.loadMs > 0.0)
+        std::printf("\nrle16: %.1fx smaller, loads %.1fx faster\n",
+            (double)legacy.bytes / (double)compact.bytes, legacy.loadMs / compact.loadMs);
+
+    if (legacy.tiles != reference || compact.tiles != reference)
+    {
+        std::printf("ERROR: loaded tiles differ from the saved ones\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "Benchmarks.h"
+
+#include "framework.h"
+#include "Gameplay/RoomManager.h"
+#include "Gameplay/ProgressionSystem.h"
+#include "Gameplay/CombatSystem.h"
+#include "Gameplay/EnemyAISystem.h"
+#include "Physics/PlatformerControllerSystem.h"
+#include "Physics/PhysicsSystem.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Loads room_start headless, lets it settle, then fails if any steady-state tick touches the heap.
+// Each tick runs the same systems the game runs per fixed step and per frame (no input, no rendering),
+// with the engine's default job workers, so the multithreaded physics step is covered too.
+namespace
+{
+    class SteadyStateApp : public my2d::App
+    {
+    public:
+        SteadyStateApp(uint64_t warmupTicks) : m_warmupTicks(warmupTicks) {}
+
+        bool OnInit(my2d::Engine& engine) override
+        {
+            return m_rooms.LoadRoom(engine, "Scenes/room_start.scene.json", "start");
+        }
+
+        void OnFixedUpdate(my2d::Engine& engine, double fixedDt) override
+        {
+            // Stats cover the previous tick (RunHeadless starts a new alloc frame every tick)
+            if (m_tick > m_warmupTicks)
+                Check(engine.GetAllocStats());
+            ++m_tick;
+
+            m_jobThreads = engine.GetJobs().ThreadCount();
+
+        my2d::EnemyAI_FixedUpdate(engine, m_rooms.GetScene(), (float)fixedDt, m_rooms.GetPlayer());
+            my2d::PlatformerController_FixedUpdate(engine, m_rooms.GetScene(), (float)fixedDt);
+            my2d::Combat_PrePhysics(engine, m_rooms.GetScene(), (float)fixedDt);
+        }
+
+        void OnPostFixedUpdate(my2d::Engine& engine, double fixedDt) override
+        {
+            my2d::Combat_PostPhysics(engine, m_rooms.GetScene(), (float)fixedDt);
+            my2d::Physics_SyncTransforms(m_rooms.GetScene(), engine.GetPhysics(), engine.PixelsPerMeter());
+
+            // Per-frame gameplay (what OnUpdate does in the game), one frame per tick here
+            my2d::Progression_Update(engine, m_rooms.GetScene(), m_rooms.GetPlayer());
+            m_rooms.Update(engine, (float)fixedDt);
+        }
+
+        my2d::Scene* GetActiveScene() override { return &m_rooms.GetScene(); }
+
+        uint64_t FailedTicks() const { return m_failedTicks; }
+        uint64_t CheckedTicks() const { return m_checkedTicks; }
+        uint32_t JobThreads() const { return m_jobThreads; }
+
+    private:
+        void Check(const my2d::AllocStats& s)
+        {
+            ++m_checkedTicks;
+            if (s.TotalAllocs() == 0)
+                return;
+
+            // Report the first few offenders by tag, then just count
+            if (m_failedTicks++ < 5)
+            {
+                std::printf("tick %llu: %llu allocations (%llu bytes)\n",
+                    (unsigned long long)(m_tick - 1), (unsigned long long)s.TotalAllocs(), (unsigned long long)s.TotalBytes());
+                for (size_t i = 0; i < s.allocs.size(); ++i)
+                {
+                    if (s.allocs[i] == 0) continue;
+                    std::printf("    %-10s %6llu allocs %8llu bytes\n", my2d::AllocTracker::TagName((my2d::AllocTag)i),
+                        (unsigned long long)s.allocs[i], (unsigned long long)s.bytes[i]);
+                }
+            }
+        }
+
+    private:
+        my2d::RoomManager m_rooms;
+        uint64_t m_warmupTicks = 0;
+        uint64_t m_tick = 0;
+        uint64_t m_checkedTicks = 0;
+        uint64_t m_failedTicks = 0;
+        uint32_t m_jobThreads = 0;
+    };
+}
+
+int Bench_ZeroAlloc(int argc, char** argv)
+{
+    const uint64_t warmup = (argc > 0) ? std::strtoull(argv[0], nullptr, 10) : 60;
+    const uint64_t ticks = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 300;
+
+    my2d::EngineConfig cfg;
+    cfg.headless = true;
+    cfg.contentRoot = "Game/Content";
+    cfg.trackAllocations = true;
+
+    my2d::Engine engine;
+    SteadyStateApp app(warmup);
+
+    // +1: the last tick's stats are checked at the start of the tick after it
+    const int rc = engine.RunHeadless(cfg, app, warmup + ticks + 1);
+    if (rc != 0)
+    {
+        std::printf("zeroalloc: engine run failed (%d)\n", rc);
+        return rc;
+    }
+
+    if (app.FailedTicks() > 0)
+    {
+        std::printf("zeroalloc: FAILED, %llu of %llu steady-state ticks allocated\n",
+            (unsigned long long)app.FailedTicks(), (unsigned long long)app.CheckedTicks());
+        return 1;
+    }
+
+    std::printf("zeroalloc: OK, %llu steady-state ticks without a heap allocation (%u job threads)\n",
+        (unsigned long long)app.CheckedTicks(), app.JobThreads());
+    return 0;
+}
@@ -1,15 +1,25 @@
 #include "pch.h"
 #include "Assets/AssetManager.h"
+#include "Core/AllocTracker.h"
 #include "Renderer/Texture2D.h"
 #include "Renderer/SpriteAtlas.h"
 #include "Renderer/AnimationSet.h"
+#include "Scene/Prefab.h"
 #include <cctype>
 #include <filesystem>
 #include <spdlog/spdlog.h>
 
 namespace my2d
 {
-    std::string AssetManager::ResolvePath(const std::string& path) const
+    const std::string& AssetManager::ResolvePath(const std::string& path) const
+    {
+        if (auto it = m_resolvedPaths.find(path); it != m_resolvedPaths.end())
+            return it->second;
+
+        return m_resolvedPaths.emplace(path, ResolvePathUncached(path)).first->second;
+    }
+
+    std::string AssetManager::ResolvePathUncached(const std::string& path) const
     {
         namespace fs = std::filesystem;
 
@@ -82,17 +92,21 @@ namespace my2d
         }
 
         m_contentRoot = resolved.lexically_normal().string();
+        m_resolvedPaths.clear();
+        m_prefabCache.clear();
     }
 
     std::shared_ptr<Texture2D> AssetManager::GetTexture(const std::string& path)
     {
+        MY2D_ALLOC_SCOPE(Assets);
+
         if (!m_renderer)
         {
             spdlog::error("AssetManager::GetTexture called before SetRenderer()");
             return {};
         }
 
-        const std::string resolved = ResolvePath(path);
+        const std::string& resolved = ResolvePath(path);
 
         // Cache hit?
         if (auto it = m_textureCache.find(resolved); it != m_textureCache.end())
@@ -108,7 +122,9 @@ namespace my2d
 
     std::shared_ptr<AnimationSet> AssetManager::GetAnimationSet(const std::string& animSetPath)
     {
-        const std::string resolved = ResolvePath(animSetPath);
+        MY2D_ALLOC_SCOPE(Assets);
+
+        const std::string& resolved = ResolvePath(animSetPath);
 
         if (auto it = m_animSetCache.find(resolved); it != m_animSetCache.end())
             return it->second;
@@ -121,9 +137,42 @@ namespace my2d
         return set;
     }
 
+    std::shared_ptr<Prefab> AssetManager::GetPrefab(const std::string& prefabPath)
+    {
+        MY2D_ALLOC_SCOPE(Assets);
+
+        const std::string& resolved = ResolvePath(prefabPath);
+
+        // Scene loads only, so one stat per lookup is fine; a missing file reads as file_time_type::min()
+        std::error_code ec;
+        const auto writeTime = std::filesystem::last_write_time(resolved, ec);
+
+        if (auto it = m_prefabCache.find(resolved); it != m_prefabCache.end())
+        {
+            if (it->second.writeTime == writeTime)
+                return it->second.prefab; // may be nullptr (failed cached)
+
+            // Edited on disk: scenes already built from the old parse keep it
+            spdlog::info("AssetManager: prefab '{}' changed, reloading", resolved);
+            m_prefabCache.erase(it);
+        }
+
+        auto prefab = std::make_shared<Prefab>();
+        if (!prefab->LoadFromFile(resolved))
+        {
+            m_prefabCache.emplace(resolved, CachedPrefab{ nullptr, writeTime });
+            return {};
+        }
+
+        m_prefabCache.emplace(resolved, CachedPrefab{ prefab, writeTime });
+        return prefab;
+    }
+
     std::shared_ptr<SpriteAtlas> AssetManager::GetAtlas(const std::string& atlasJsonPath)
     {
-        const std::string resolved = ResolvePath(atlasJsonPath);
+        MY2D_ALLOC_SCOPE(Assets);
+
+        const std::string& resolved = ResolvePath(atlasJsonPath);
 
         if (auto it = m_atlasCache.find(resolved); it != m_atlasCache.end())
             return it->second; // may be nullptr (failed cached)
@@ -144,5 +193,6 @@ namespace my2d
         m_textureCache.clear();
         m_atlasCache.clear();
         m_animSetCache.clear();
+        m_prefabCache.clear();
     }
 }
\ No newline at end of file
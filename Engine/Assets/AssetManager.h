@@ -1,4 +1,5 @@
 #pragma once
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -10,6 +11,7 @@ namespace my2d
     class Texture2D;
     class SpriteAtlas;
     class AnimationSet;
+    class Prefab;
     class AssetManager
     {
     public:
@@ -23,15 +25,30 @@ namespace my2d
         std::shared_ptr<SpriteAtlas> GetAtlas(const std::string& atlasJsonPath);
         std::shared_ptr<AnimationSet> GetAnimationSet(const std::string& animSetPath);
 
+        // Parsed once per path into a component template (Scene::Instantiate, scene loads). Re-parsed when
+        // the file's write time changes; SetContentRoot/Clear drop the cache.
+        std::shared_ptr<Prefab> GetPrefab(const std::string& prefabPath);
+
     private:
-        std::string ResolvePath(const std::string& path) const;
+        // Cached per requested path: lookups after the first are allocation-free.
+        const std::string& ResolvePath(const std::string& path) const;
+        std::string ResolvePathUncached(const std::string& path) const;
+
+        struct CachedPrefab
+        {
+            std::shared_ptr<Prefab> prefab; // nullptr = failed to load
+            std::filesystem::file_time_type writeTime;
+        };
 
     private:
         SDL_Renderer* m_renderer = nullptr;
         std::string m_contentRoot;
 
+        mutable std::unordered_map<std::string, std::string> m_resolvedPaths;
+
         std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_textureCache;
         std::unordered_map<std::string, std::shared_ptr<SpriteAtlas>> m_atlasCache;
         std::unordered_map<std::string, std::shared_ptr<AnimationSet>> m_animSetCache;
+        std::unordered_map<std::string, CachedPrefab> m_prefabCache;
     };
 }
\ No newline at end of file
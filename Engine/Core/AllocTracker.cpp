@@ -0,0 +1,169 @@
+#include "pch.h"
+#include "Core/AllocTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace my2d
+{
+    // Plain atomics: must not allocate, and job threads allocate too
+    static std::atomic<uint64_t> s_allocs[(size_t)AllocTag::Count];
+    static std::atomic<uint64_t> s_bytes[(size_t)AllocTag::Count];
+    static std::atomic<uint64_t> s_frees{ 0 };
+
+    static AllocStats s_lastFrame;
+
+    static thread_local AllocTag t_tag = AllocTag::Untagged;
+
+    void AllocTracker::NewFrame()
+    {
+        for (size_t i = 0; i < (size_t)AllocTag::Count; ++i)
+        {
+            s_lastFrame.allocs[i] = s_allocs[i].exchange(0, std::memory_order_relaxed);
+            s_lastFrame.bytes[i] = s_bytes[i].exchange(0, std::memory_order_relaxed);
+        }
+        s_lastFrame.frees = s_frees.exchange(0, std::memory_order_relaxed);
+    }
+
+    const AllocStats& AllocTracker::LastFrame()
+    {
+        return s_lastFrame;
+    }
+
+    const char* AllocTracker::TagName(AllocTag tag)
+    {
+        switch (tag)
+        {
+        case AllocTag::Untagged: return "Untagged";
+        case AllocTag::Renderer: return "Renderer";
+        case AllocTag::Physics: return "Physics";
+        case AllocTag::Scene: return "Scene";
+        case AllocTag::Assets: return "Assets";
+        case AllocTag::Gameplay: return "Gameplay";
+        default: return "?";
+        }
+    }
+
+    AllocTag AllocTracker::CurrentTag()
+    {
+        return t_tag;
+    }
+
+    AllocTag AllocTracker::SetCurrentTag(AllocTag tag)
+    {
+        const AllocTag prev = t_tag;
+        t_tag = tag;
+        return prev;
+    }
+
+    void AllocTracker::RecordAlloc(size_t bytes)
+    {
+        const size_t i = (size_t)t_tag;
+        s_allocs[i].fetch_add(1, std::memory_order_relaxed);
+        s_bytes[i].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void AllocTracker::RecordFree()
+    {
+        s_frees.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+#if MY2D_ALLOC_TRACKING
+
+// ---- global operator new/delete replacements ----
+// Always installed when compiled in; counting only happens while the tracker is enabled.
+namespace
+{
+    void* TrackedAlloc(size_t size) noexcept
+    {
+        if (size == 0) size = 1;
+        void* p = std::malloc(size);
+        if (p && my2d::AllocTracker::IsEnabled())
+            my2d::AllocTracker::RecordAlloc(size);
+        return p;
+    }
+
+    void* TrackedAlignedAlloc(size_t size, size_t align) noexcept
+    {
+        if (size == 0) size = 1;
+#ifdef _MSC_VER
+        void* p = _aligned_malloc(size, align);
+#else
+        void* p = std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+#endif
+        if (p && my2d::AllocTracker::IsEnabled())
+            my2d::AllocTracker::RecordAlloc(size);
+        return p;
+    }
+
+    void TrackedFree(void* p) noexcept
+    {
+        if (!p) return;
+        if (my2d::AllocTracker::IsEnabled())
+            my2d::AllocTracker::RecordFree();
+        std::free(p);
+    }
+
+    void TrackedAlignedFree(void* p) noexcept
+    {
+        if (!p) return;
+        if (my2d::AllocTracker::IsEnabled())
+            my2d::AllocTracker::RecordFree();
+#ifdef _MSC_VER
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+void* operator new(size_t size)
+{
+    if (void* p = TrackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    if (void* p = TrackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+
+void* operator new(size_t size, std::align_val_t align)
+{
+    if (void* p = TrackedAlignedAlloc(size, (size_t)align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t align)
+{
+    if (void* p = TrackedAlignedAlloc(size, (size_t)align)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return TrackedAlignedAlloc(size, (size_t)align); }
+void* operator new[](size_t size, std::align_val_t align, const std::nothrow_t&) noexcept { return TrackedAlignedAlloc(size, (size_t)align); }
+
+void operator delete(void* p) noexcept { TrackedFree(p); }
+void operator delete[](void* p) noexcept { TrackedFree(p); }
+void operator delete(void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { TrackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { TrackedFree(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { TrackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { TrackedAlignedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { TrackedAlignedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { TrackedAlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { TrackedAlignedFree(p); }
+
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Set MY2D_ALLOC_TRACKING=0 in the project defines to drop the global new/delete hooks entirely.
+#ifndef MY2D_ALLOC_TRACKING
+#define MY2D_ALLOC_TRACKING 1
+#endif
+
+namespace my2d
+{
+    enum class AllocTag : uint8_t
+    {
+        Untagged = 0,
+        Renderer,
+        Physics,
+        Scene,
+        Assets,
+        Gameplay,
+        Count
+    };
+
+    struct AllocStats
+    {
+        std::array<uint64_t, (size_t)AllocTag::Count> allocs{};
+        std::array<uint64_t, (size_t)AllocTag::Count> bytes{};
+        uint64_t frees = 0;
+
+        uint64_t TotalAllocs() const
+        {
+            uint64_t n = 0;
+            for (uint64_t a : allocs) n += a;
+            return n;
+        }
+
+        uint64_t TotalBytes() const
+        {
+            uint64_t n = 0;
+            for (uint64_t b : bytes) n += b;
+            return n;
+        }
+    };
+
+    // Counts operator new/delete while enabled (EngineConfig::trackAllocations).
+    // Each allocation is charged to the innermost MY2D_ALLOC_SCOPE on the allocating thread.
+    class AllocTracker
+    {
+    public:
+        static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+        static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+        // Ends the current frame: its counters become LastFrame() and counting restarts. Main thread.
+        static void NewFrame();
+        static const AllocStats& LastFrame();
+
+        static const char* TagName(AllocTag tag);
+
+        static AllocTag CurrentTag();
+        static AllocTag SetCurrentTag(AllocTag tag); // returns the previous tag
+
+        // Called from the hooks
+        static void RecordAlloc(size_t bytes);
+        static void RecordFree();
+
+    private:
+        static inline std::atomic<bool> s_enabled{ false };
+    };
+
+    class AllocScope
+    {
+    public:
+        explicit AllocScope(AllocTag tag) : m_prev(AllocTracker::SetCurrentTag(tag)) {}
+        ~AllocScope() { AllocTracker::SetCurrentTag(m_prev); }
+
+        AllocScope(const AllocScope&) = delete;
+        AllocScope& operator=(const AllocScope&) = delete;
+
+    private:
+        AllocTag m_prev;
+    };
+}
+
+#if MY2D_ALLOC_TRACKING
+#define MY2D_ALLOC_CONCAT_INNER(a, b) a##b
+#define MY2D_ALLOC_CONCAT(a, b) MY2D_ALLOC_CONCAT_INNER(a, b)
+#define MY2D_ALLOC_SCOPE(tag) ::my2d::AllocScope MY2D_ALLOC_CONCAT(my2dAllocScope_, __LINE__)(::my2d::AllocTag::tag)
+#else
+#define MY2D_ALLOC_SCOPE(tag) ((void)0)
+#endif
@@ -6,6 +6,8 @@
 namespace my2d
 {
     class Engine;
+    class Scene;
+    class RenderSnapshot;
 
     class App
     {
@@ -20,7 +22,17 @@ namespace my2d
         virtual void OnPostFixedUpdate(Engine& engine, double fixedDt) { (void)engine; (void)fixedDt; }
         virtual void OnRender(Engine& engine) { (void)engine; }
 
+        // Pipelined rendering (EngineConfig::pipelinedRendering) calls this instead of OnRender, on the simulation thread.
+        // Record draws into `out` (its camera is already set); never touch the SDL_Renderer from here.
+        virtual void OnBuildRenderSnapshot(Engine& engine, RenderSnapshot& out) { (void)engine; (void)out; }
+
         // Return true if consumed (engine wont do default handling for input/window).
+        // Pipelined rendering calls it on the simulation thread, after the window has already seen the event
+        // on the main thread: consuming it there only keeps it from Input.
         virtual bool OnEvent(Engine& engine, const SDL_Event& e) { (void)engine; (void)e; return false; }
+
+        // Scene hashed after every fixed tick while recording/replaying input (null = nothing to hash).
+        // Its queued commands are flushed and its world transforms updated after OnPostFixedUpdate and after OnUpdate.
+        virtual Scene* GetActiveScene() { return nullptr; }
     };
 }
\ No newline at end of file
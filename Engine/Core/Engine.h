@@ -3,9 +3,15 @@
 #include "Platform/Sdl.h"
 #include "Assets/AssetManager.h"
 #include "Renderer/Renderer2D.h"
+#include "Renderer/RenderSnapshot.h"
 
+#include "Core/AllocTracker.h"
 #include "Core/EngineConfig.h"
+#include "Core/FrameLimiter.h"
 #include "Core/Input.h"
+#include "Core/InputRecording.h"
+#include "Core/JobSystem.h"
+#include "Core/LinearArena.h"
 #include "Core/Time.h"
 
 #include "Platform/Window.h"
@@ -14,11 +20,32 @@
 #include "Physics/PhysicsDebugDraw.h"
 
 #include "Gameplay/WorldState.h"
+#include "Scene/TransformTracker.h"
+
+#include <atomic>
+#include <vector>
 
 namespace my2d
 {
     class App;
 
+    struct HeadlessRunStats
+    {
+        uint64_t ticks = 0;
+        double wallSeconds = 0.0;
+        double ticksPerSecond = 0.0;
+    };
+
+    struct ReplayResult
+    {
+        uint64_t frames = 0;
+        uint64_t ticks = 0;
+        bool diverged = false;
+        uint64_t divergedTick = 0;
+        uint64_t expectedHash = 0;
+        uint64_t actualHash = 0;
+    };
+
     class Engine
     {
     public:
@@ -29,9 +56,21 @@ namespace my2d
         void Shutdown();
 
         int Run(const EngineConfig& config, App& app);
+
+        // Fixed-step only (no window/renderer, no OnUpdate/OnRender), as fast as possible.
+        // ticks == 0 runs until RequestQuit(). With EngineConfig::recordInputPath set, each tick is recorded
+        // as a frame of its own and OnUpdate runs after it, so RunReplay can check the run tick by tick.
+        int RunHeadless(const EngineConfig& config, App& app, uint64_t ticks);
+
+        // Headless replay of a recording made with EngineConfig::recordInputPath.
+        // Frames are rebuilt exactly (events, dt, fixed ticks, OnUpdate); stops at the first tick whose
+        // state hash differs. Returns 0 when every tick matched, 3 on divergence.
+        int RunReplay(const EngineConfig& config, App& app);
         void ResetPhysicsWorld();
 
+        // Safe from the simulation thread in pipelined mode.
         void RequestQuit();
+        bool IsPipelined() const { return m_pipelined; }
 
         SDL_Window* GetSDLWindow() const;
         SDL_Renderer* GetSDLRenderer() const;
@@ -41,14 +80,42 @@ namespace my2d
         Renderer2D& GetRenderer2D() { return m_renderer2d; }
         PhysicsWorld& GetPhysics() { return m_physics; }
         PhysicsDebugDraw& GetPhysicsDebugDraw() { return m_physicsDebug; }
+        JobSystem& GetJobs() { return m_jobs; }
+
+        // Scratch memory valid until the next frame / fixed tick starts (simulation thread only).
+        LinearArena& GetFrameArena() { return m_frameArena; }
+        LinearArena& GetTickArena() { return m_tickArena; }
         float PixelsPerMeter() const { return m_pixelsPerMeter; }
         bool DrawPhysicsDebug() const { return m_drawPhysicsDebug; }
+        bool IsHeadless() const { return m_headless; }
+
+        // How far the current frame is between the last fixed step and the next one [0, 1).
+        float RenderAlpha() const { return m_renderAlpha; }
+        const HeadlessRunStats& GetHeadlessStats() const { return m_headlessStats; }
+        const ReplayResult& GetReplayResult() const { return m_replayResult; }
+
+        // Frame time / jitter / idle over the last second (see EngineConfig::targetFps).
+        const FrameLimiterStats& GetFrameStats() const { return m_limiter.Stats(); }
+        bool IsLowPower() const { return m_lowPower; }
+
+        // Distinct entities whose transform changed, per frame of the active scene (headless: per tick).
+        const TransformStats& GetTransformStats() const { return m_transformStats; }
+
+        // Heap allocations made during the previous frame (headless: previous tick). Needs EngineConfig::trackAllocations.
+        const AllocStats& GetAllocStats() const { return AllocTracker::LastFrame(); }
         const Time& GetTime() const;
 
         WorldState& GetWorldState() { return m_worldState; }
         const WorldState& GetWorldState() const { return m_worldState; }
         const std::string& ContentRoot() const { return m_contentRoot; }
 
+    private:
+        int RunPipelined(const EngineConfig& config, App& app);
+        void LimitFrameRate(const EngineConfig& config);
+        void EndSceneFrame(App& app, bool fixedStep);
+        void SimulateFrame(const EngineConfig& config, App& app, double dt, const std::vector<SDL_Event>& events,
+            int viewW, int viewH, uint32_t frameIndex, uint64_t& tick, RenderSnapshot& out);
+
     private:
         // Concrete members
         Platform::Window m_window; // (defined in Platform/Window.h)
@@ -56,17 +123,31 @@ namespace my2d
         Time m_time;
         AssetManager m_assets;
         Renderer2D m_renderer2d;
+        Renderer2D m_renderStage; // pipelined mode: the only user of the SDL_Renderer, main thread
         PhysicsWorld m_physics;
         PhysicsDebugDraw m_physicsDebug;
+        JobSystem m_jobs;
+        FrameLimiter m_limiter;
+        LinearArena m_frameArena;
+        LinearArena m_tickArena;
         float m_pixelsPerMeter = 100.0f;
         bool m_drawPhysicsDebug = false;
         b2Vec2 m_gravity{ 0.0f, 9.8f };
+        uint32_t m_physicsWorkers = 1;
         std::string m_contentRoot;
 
         WorldState m_worldState;
 
         double m_fixedAccumulator = 0.0;
+        float m_renderAlpha = 1.0f;
+        HeadlessRunStats m_headlessStats;
+        TransformStats m_transformStats;
+        ReplayResult m_replayResult;
+        InputRecorder m_recorder;
+        bool m_headless = false;
+        bool m_pipelined = false;
+        bool m_lowPower = false;
         bool m_initialized = false;
-        bool m_quitRequested = false;
+        std::atomic<bool> m_quitRequested{ false };
     };
 }
\ No newline at end of file
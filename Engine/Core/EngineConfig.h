@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <string>
 
 namespace my2d
@@ -11,9 +12,45 @@ namespace my2d
         bool resizable = true;
         bool vsync = true;
 
+        // Frame cap (Core/FrameLimiter.h), mostly for vsync off. 0 = uncapped.
+        // Headless runs stay uncapped unless this is set.
+        double targetFps = 0.0;
+
+        // Rate while the window is unfocused or minimized (rendering is skipped while minimized). 0 = no low-power mode.
+        double lowPowerFps = 10.0;
+
+        // No window/renderer: only fixed updates + physics run (CI soak tests, throughput runs).
+        bool headless = false;
+
+        // Simulation runs on its own thread one frame ahead of rendering, handing over a RenderSnapshot
+        // (App::OnBuildRenderSnapshot). The main thread keeps SDL: events, the renderer and all GPU texture work.
+        bool pipelinedRendering = false;
+
+        // Input record/replay (see Core/InputRecording.h). Replay implies headless; a headless recording
+        // has no input and checks determinism only.
+        std::string recordInputPath;
+        std::string replayInputPath;
+
         // Used by the engine loop for fixed updates (physics).
         double fixedDeltaSeconds = 1.0 / 60.0;
 
+        // Job system worker threads. -1 = hardware threads - 1 (the main thread also runs jobs while waiting).
+        int jobWorkerThreads = -1;
+
+        // Count heap allocations per frame and per AllocTag (Core/AllocTracker.h). Costs a few atomics per new/delete.
+        bool trackAllocations = false;
+
+        // Scratch arenas reset every frame / every fixed tick (main thread only).
+        // Size them from the high-water marks logged at shutdown.
+        size_t frameArenaBytes = 1u << 20;
+        size_t tickArenaBytes = 256u << 10;
+
+        // Box2D solver threads, borrowed from the job system. -1 = every job thread, 1 = single-threaded.
+        int physicsWorkerThreads = -1;
+
+        // Box2D sub-steps per fixed step (Box2D's docs suggest 4 for stiffer stacking).
+        int physicsSubSteps = 1;
+
         float gravityX = 0.0f;
         float gravityY = 9.8f;          // y+ down (works fine with SDL coords)
         float pixelsPerMeter = 100.0f;  // conversion scale
@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "Core/FrameLimiter.h"
+#include "Core/Profiler.h"
+#include "Platform/Sdl.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace my2d
+{
+    void FrameLimiter::Accum::Add(double frameSec, double idleSec)
+    {
+        ++frames;
+        sum += frameSec;
+        sumSq += frameSec * frameSec;
+        max = std::max(max, frameSec);
+        idle += idleSec;
+    }
+
+    void FrameLimiter::Accum::Store(FrameLimiterStats& out, double targetFps) const
+    {
+        out.targetFps = targetFps;
+        out.frames = frames;
+        if (frames == 0) return;
+
+        const double mean = sum / frames;
+        const double variance = std::max(0.0, sumSq / frames - mean * mean);
+
+        out.avgFrameMs = mean * 1000.0;
+        out.jitterMs = std::sqrt(variance) * 1000.0;
+        out.maxFrameMs = max * 1000.0;
+        out.idlePercent = (sum > 0.0) ? 100.0 * idle / sum : 0.0;
+    }
+
+    void FrameLimiter::Reset()
+    {
+        m_freq = SDL_GetPerformanceFrequency();
+        m_lastFrameEnd = SDL_GetPerformanceCounter();
+        m_nextDeadline = m_lastFrameEnd + m_period;
+        m_idleThisFrame = 0.0;
+        m_windowSec = 0.0;
+        m_window = Accum{};
+        m_all = Accum{};
+        m_stats = FrameLimiterStats{};
+        m_total = FrameLimiterStats{};
+    }
+
+    void FrameLimiter::SetTargetFps(double fps)
+    {
+        if (fps == m_targetFps)
+            return;
+
+        if (m_freq == 0)
+            m_freq = SDL_GetPerformanceFrequency();
+
+        m_targetFps = (fps > 0.0) ? fps : 0.0;
+        m_period = (m_targetFps > 0.0) ? (uint64_t)((double)m_freq / m_targetFps) : 0;
+
+        // New rate: schedule from now instead of from the old grid
+        m_nextDeadline = SDL_GetPerformanceCounter() + m_period;
+    }
+
+    void FrameLimiter::SleepUntil(uint64_t deadline)
+    {
+        const double freq = (double)m_freq;
+
+        // Coarse part: whole-millisecond sleeps while we're clearly early
+        while (true)
+        {
+            const uint64_t now = SDL_GetPerformanceCounter();
+            if (now >= deadline) return;
+
+            const double remaining = (double)(deadline - now) / freq;
+            if (remaining <= m_oversleepSec + 0.0005)
+                break;
+
+            const uint32_t ms = std::max<uint32_t>(1, (uint32_t)((remaining - m_oversleepSec) * 1000.0));
+            SDL_Delay(ms);
+
+            const uint64_t woke = SDL_GetPerformanceCounter();
+            const double slept = (double)(woke - now) / freq;
+            m_idleThisFrame += slept;
+
+            // Jump up on a late wake-up, creep back down otherwise
+            const double late = std::max(0.0, slept - ms * 0.001);
+            m_oversleepSec = (late > m_oversleepSec) ? late : m_oversleepSec + (late - m_oversleepSec) * 0.05;
+        }
+
+        // Fine part: spin out the last fraction of a millisecond
+        while (SDL_GetPerformanceCounter() < deadline)
+        {
+        }
+    }
+
+    void FrameLimiter::Wait()
+    {
+        MY2D_PROFILE_SCOPE("FrameLimiter::Wait");
+
+        if (m_freq == 0)
+            Reset();
+
+        m_idleThisFrame = 0.0;
+
+        if (m_period > 0)
+        {
+            const uint64_t now = SDL_GetPerformanceCounter();
+
+            // More than a frame behind (hitch, breakpoint): restart the grid instead of rushing to catch up
+            if (now > m_nextDeadline + m_period)
+                m_nextDeadline = now;
+            else
+                SleepUntil(m_nextDeadline);
+
+            m_nextDeadline += m_period;
+        }
+
+        const uint64_t end = SDL_GetPerformanceCounter();
+        const double frameSec = (double)(end - m_lastFrameEnd) / (double)m_freq;
+        m_lastFrameEnd = end;
+
+        m_window.Add(frameSec, m_idleThisFrame);
+        m_all.Add(frameSec, m_idleThisFrame);
+        m_all.Store(m_total, m_targetFps);
+
+        m_windowSec += frameSec;
+        if (m_windowSec >= 1.0)
+        {
+            m_window.Store(m_stats, m_targetFps);
+            m_window = Accum{};
+            m_windowSec = 0.0;
+        }
+    }
+}
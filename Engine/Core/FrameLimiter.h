@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+
+namespace my2d
+{
+    struct FrameLimiterStats
+    {
+        double targetFps = 0.0;   // 0 = uncapped
+        uint32_t frames = 0;
+        double avgFrameMs = 0.0;
+        double jitterMs = 0.0;    // std-dev of the frame time
+        double maxFrameMs = 0.0;
+        double idlePercent = 0.0; // wall time spent asleep inside Wait()
+    };
+
+    // Caps the loop to a target rate without burning a core.
+    // Wait() sleeps most of the remaining time, then spins the last bit on SDL_GetPerformanceCounter.
+    // The spin margin tracks how late SDL_Delay actually wakes up on this machine.
+    class FrameLimiter
+    {
+    public:
+        void Reset();
+
+        // fps <= 0 disables the cap (Wait() only measures).
+        void SetTargetFps(double fps);
+        double TargetFps() const { return m_targetFps; }
+
+        // Call once per frame, after present. Blocks until the next frame slot.
+        void Wait();
+
+        // Last completed one-second window, and everything since Reset().
+        const FrameLimiterStats& Stats() const { return m_stats; }
+        const FrameLimiterStats& TotalStats() const { return m_total; }
+
+    private:
+        struct Accum
+        {
+            uint32_t frames = 0;
+            double sum = 0.0;
+            double sumSq = 0.0;
+            double max = 0.0;
+            double idle = 0.0;
+
+            void Add(double frameSec, double idleSec);
+            void Store(FrameLimiterStats& out, double targetFps) const;
+        };
+
+        void SleepUntil(uint64_t deadline);
+
+    private:
+        uint64_t m_freq = 0;
+        uint64_t m_period = 0;       // perf counter ticks per frame, 0 = uncapped
+        uint64_t m_nextDeadline = 0;
+        uint64_t m_lastFrameEnd = 0;
+        double m_targetFps = 0.0;
+
+        double m_oversleepSec = 0.001; // how late a 1 ms sleep tends to come back
+        double m_idleThisFrame = 0.0;
+
+        double m_windowSec = 0.0;
+        Accum m_window;
+        Accum m_all;
+        FrameLimiterStats m_stats;
+        FrameLimiterStats m_total;
+    };
+}
@@ -0,0 +1,242 @@
+#include "pch.h"
+#include "Core/InputRecording.h"
+
+#include <spdlog/spdlog.h>
+
+namespace my2d
+{
+    static constexpr char Magic[4] = { 'M', '2', 'I', 'R' };
+    static constexpr uint32_t Version = 1;
+
+    InputRecorder::~InputRecorder()
+    {
+        Close();
+    }
+
+    bool InputRecorder::Open(const std::string& path, double fixedDt)
+    {
+        Close();
+
+        m_out.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_out)
+        {
+            spdlog::error("InputRecorder: cannot open '{}'", path);
+            return false;
+        }
+
+        m_path = path;
+        m_frames = 0;
+        m_events = 0;
+        m_buffer.clear();
+        m_buffer.reserve(1u << 16);
+
+        m_buffer.insert(m_buffer.end(), Magic, Magic + 4);
+        Write(Version);
+        Write(fixedDt);
+
+        spdlog::info("InputRecorder: recording to '{}'", path);
+        return true;
+    }
+
+    void InputRecorder::Close()
+    {
+        if (!m_out.is_open())
+            return;
+
+        m_out.write(reinterpret_cast<const char*>(m_buffer.data()), (std::streamsize)m_buffer.size());
+        m_buffer.clear();
+        m_out.close();
+
+        spdlog::info("InputRecorder: wrote {} frames, {} events to '{}'", m_frames, m_events, m_path);
+    }
+
+    void InputRecorder::FlushIfLarge()
+    {
+        if (m_buffer.size() < (1u << 16))
+            return;
+
+        m_out.write(reinterpret_cast<const char*>(m_buffer.data()), (std::streamsize)m_buffer.size());
+        m_buffer.clear();
+    }
+
+    void InputRecorder::BeginFrame(uint32_t frameIndex, uint64_t firstTick, double dt)
+    {
+        if (!IsOpen()) return;
+
+        Write(InputRecordKind::Frame);
+        Write(frameIndex);
+        Write(firstTick);
+        Write(dt);
+        ++m_frames;
+        FlushIfLarge();
+    }
+
+    void InputRecorder::RecordEvent(const SDL_Event& e)
+    {
+        if (!IsOpen()) return;
+
+        switch (e.type)
+        {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            Write(InputRecordKind::Event);
+            Write(e.type);
+            Write((int32_t)e.key.keysym.scancode);
+            Write((int32_t)e.key.keysym.sym);
+            Write(e.key.keysym.mod);
+            Write(e.key.state);
+            Write(e.key.repeat);
+            break;
+
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            Write(InputRecordKind::Event);
+            Write(e.type);
+            Write(e.button.button);
+            Write(e.button.state);
+            Write(e.button.clicks);
+            Write(e.button.x);
+            Write(e.button.y);
+            break;
+
+        case SDL_MOUSEMOTION:
+            Write(InputRecordKind::Event);
+            Write(e.type);
+            Write(e.motion.state);
+            Write(e.motion.x);
+            Write(e.motion.y);
+            Write(e.motion.xrel);
+            Write(e.motion.yrel);
+            break;
+
+        case SDL_MOUSEWHEEL:
+            Write(InputRecordKind::Event);
+            Write(e.type);
+            Write(e.wheel.x);
+            Write(e.wheel.y);
+            Write(e.wheel.direction);
+            break;
+
+        default:
+            return;
+        }
+
+        ++m_events;
+    }
+
+    void InputRecorder::RecordTick(uint64_t tick, uint64_t hash)
+    {
+        if (!IsOpen()) return;
+
+        Write(InputRecordKind::Tick);
+        Write(tick);
+        Write(hash);
+    }
+
+    bool InputReplay::Open(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in)
+        {
+            spdlog::error("InputReplay: cannot open '{}'", path);
+            return false;
+        }
+
+        const std::streamsize size = in.tellg();
+        in.seekg(0);
+        m_data.resize((size_t)size);
+        if (size > 0 && !in.read(reinterpret_cast<char*>(m_data.data()), size))
+        {
+            spdlog::error("InputReplay: failed reading '{}'", path);
+            return false;
+        }
+
+        m_path = path;
+        m_cursor = 0;
+
+        char magic[4]{};
+        uint32_t version = 0;
+        if (!Read(magic) || std::memcmp(magic, Magic, 4) != 0 || !Read(version) || !Read(m_fixedDt))
+        {
+            spdlog::error("InputReplay: '{}' is not an input recording", path);
+            return false;
+        }
+
+        if (version != Version)
+        {
+            spdlog::error("InputReplay: '{}' has version {}, expected {}", path, version, Version);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool InputReplay::ReadEvent(SDL_Event& e)
+    {
+        e = SDL_Event{};
+
+        uint32_t type = 0;
+        if (!Read(type)) return false;
+        e.type = type;
+
+        switch (type)
+        {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+        {
+            int32_t scancode = 0, sym = 0;
+            if (!Read(scancode) || !Read(sym) || !Read(e.key.keysym.mod) || !Read(e.key.state) || !Read(e.key.repeat))
+                return false;
+            e.key.keysym.scancode = (SDL_Scancode)scancode;
+            e.key.keysym.sym = (SDL_Keycode)sym;
+            return true;
+        }
+
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            return Read(e.button.button) && Read(e.button.state) && Read(e.button.clicks) && Read(e.button.x) && Read(e.button.y);
+
+        case SDL_MOUSEMOTION:
+            return Read(e.motion.state) && Read(e.motion.x) && Read(e.motion.y) && Read(e.motion.xrel) && Read(e.motion.yrel);
+
+        case SDL_MOUSEWHEEL:
+            return Read(e.wheel.x) && Read(e.wheel.y) && Read(e.wheel.direction);
+
+        default:
+            return false;
+        }
+    }
+
+    bool InputReplay::Next(InputRecord& out)
+    {
+        if (m_cursor >= m_data.size())
+            return false;
+
+        uint8_t kind = 0;
+        Read(kind);
+        out.kind = (InputRecordKind)kind;
+
+        bool ok = false;
+        switch (out.kind)
+        {
+        case InputRecordKind::Frame:
+            ok = Read(out.frameIndex) && Read(out.firstTick) && Read(out.dt);
+            break;
+        case InputRecordKind::Event:
+            ok = ReadEvent(out.event);
+            break;
+        case InputRecordKind::Tick:
+            ok = Read(out.tick) && Read(out.hash);
+            break;
+        default:
+            break;
+        }
+
+        if (!ok)
+        {
+            spdlog::error("InputReplay: corrupt record at byte {} in '{}'", m_cursor, m_path);
+            m_cursor = m_data.size();
+        }
+        return ok;
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "Platform/Sdl.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace my2d
+{
+    // Binary input log: the events Engine::Run fed to the app each frame, the frame's dt,
+    // and a world-state hash after every fixed tick. Replaying it headless reproduces the run
+    // and flags the first tick whose hash differs.
+    //
+    // Layout (little endian):
+    //   header  "M2IR" u32 version f64 fixedDt
+    //   frame   u8 1  u32 frameIndex u64 firstTick f64 dt
+    //   event   u8 2  u32 SDL type + type-specific payload (keys, mouse buttons/motion/wheel only)
+    //   tick    u8 3  u64 tick u64 hash
+    enum class InputRecordKind : uint8_t
+    {
+        Frame = 1,
+        Event = 2,
+        Tick = 3
+    };
+
+    class InputRecorder
+    {
+    public:
+        ~InputRecorder();
+
+        bool Open(const std::string& path, double fixedDt);
+        void Close();
+        bool IsOpen() const { return m_out.is_open(); }
+
+        void BeginFrame(uint32_t frameIndex, uint64_t firstTick, double dt);
+
+        // Ignores event types that can't affect the simulation (window, text, ...)
+        void RecordEvent(const SDL_Event& e);
+
+        void RecordTick(uint64_t tick, uint64_t hash);
+
+    private:
+        template<typename T>
+        void Write(const T& v)
+        {
+            const auto* p = reinterpret_cast<const uint8_t*>(&v);
+            m_buffer.insert(m_buffer.end(), p, p + sizeof(T));
+        }
+
+        void FlushIfLarge();
+
+    private:
+        std::ofstream m_out;
+        std::vector<uint8_t> m_buffer;
+        std::string m_path;
+        uint64_t m_frames = 0;
+        uint64_t m_events = 0;
+    };
+
+    struct InputRecord
+    {
+        InputRecordKind kind = InputRecordKind::Frame;
+
+        // Frame
+        uint32_t frameIndex = 0;
+        uint64_t firstTick = 0;
+        double dt = 0.0;
+
+        // Event
+        SDL_Event event{};
+
+        // Tick
+        uint64_t tick = 0;
+        uint64_t hash = 0;
+    };
+
+    class InputReplay
+    {
+    public:
+        // Reads the whole file up front so replay timing is not disturbed by disk reads.
+        bool Open(const std::string& path);
+
+        double FixedDt() const { return m_fixedDt; }
+
+        // false at end of file (or on a truncated/corrupt record, which is logged)
+        bool Next(InputRecord& out);
+
+    private:
+        template<typename T>
+        bool Read(T& v)
+        {
+            if (m_cursor + sizeof(T) > m_data.size())
+                return false;
+            std::memcpy(&v, m_data.data() + m_cursor, sizeof(T));
+            m_cursor += sizeof(T);
+            return true;
+        }
+
+        bool ReadEvent(SDL_Event& e);
+
+    private:
+        std::vector<uint8_t> m_data;
+        size_t m_cursor = 0;
+        double m_fixedDt = 0.0;
+        std::string m_path;
+    };
+}
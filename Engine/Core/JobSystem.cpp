@@ -0,0 +1,247 @@
+#include "pch.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace my2d
+{
+    static constexpr uint32_t NotAWorker = 0xFFFFFFFFu;
+
+    static thread_local uint32_t t_threadIndex = NotAWorker;
+
+    JobSystem::~JobSystem()
+    {
+        Shutdown();
+    }
+
+    uint32_t JobSystem::CurrentThreadIndex()
+    {
+        return t_threadIndex;
+    }
+
+    void JobSystem::Initialize(uint32_t workerThreads)
+    {
+        if (m_running.load())
+            return;
+
+        t_threadIndex = 0; // caller is the owner thread
+
+        m_queues.clear();
+        for (uint32_t i = 0; i < workerThreads + 1; ++i)
+            m_queues.push_back(std::make_unique<WorkQueue>());
+
+        m_queuedJobs.store(0);
+        m_running.store(true);
+
+        m_workers.reserve(workerThreads);
+        for (uint32_t i = 1; i <= workerThreads; ++i)
+            m_workers.emplace_back(&JobSystem::WorkerMain, this, i);
+
+        spdlog::info("JobSystem: {} worker threads (+ main)", workerThreads);
+    }
+
+    void JobSystem::SetOwnerThread()
+    {
+        t_threadIndex = 0;
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (!m_running.load())
+            return;
+
+        // Run whatever is left so no counter is left dangling
+        Job job;
+        while (TryGetJob(job))
+            Execute(job);
+
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_running.store(false);
+        }
+        m_wake.notify_all();
+
+        for (auto& t : m_workers)
+            if (t.joinable()) t.join();
+
+        m_workers.clear();
+        m_queues.clear();
+    }
+
+    void JobSystem::WorkerMain(uint32_t index)
+    {
+        t_threadIndex = index;
+
+        const std::string name = "Worker " + std::to_string(index);
+        Profiler::SetThreadName(name.c_str());
+
+        while (m_running.load(std::memory_order_acquire))
+        {
+            Job job;
+            if (TryGetJob(job))
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this]()
+                {
+                    return !m_running.load(std::memory_order_acquire) || m_queuedJobs.load(std::memory_order_acquire) > 0;
+                });
+        }
+    }
+
+    void JobSystem::Push(Job job)
+    {
+        // Not running (or called from a foreign thread before Initialize): run inline
+        if (m_queues.empty())
+        {
+            Execute(job);
+            return;
+        }
+
+        const uint32_t self = t_threadIndex;
+        WorkQueue& q = *m_queues[(self < m_queues.size()) ? self : 0];
+
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.size < WorkQueue::Capacity)
+            {
+                q.jobs[(q.front + q.size) % WorkQueue::Capacity] = std::move(job);
+                ++q.size;
+            }
+        }
+
+        // Ring full: more chunks in flight than anyone can steal, so just run this one here
+        if (job.fn)
+        {
+            Execute(job);
+            return;
+        }
+        m_queuedJobs.fetch_add(1, std::memory_order_release);
+
+        // Taking the lock orders us against a worker that is about to sleep
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_wake.notify_one();
+    }
+
+    bool JobSystem::TryPop(uint32_t index, Job& out)
+    {
+        WorkQueue& q = *m_queues[index];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.size == 0)
+            return false;
+
+        --q.size;
+        out = std::move(q.jobs[(q.front + q.size) % WorkQueue::Capacity]);
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool JobSystem::TrySteal(uint32_t thief, Job& out)
+    {
+        const uint32_t n = (uint32_t)m_queues.size();
+        const uint32_t start = (thief < n) ? thief + 1 : 0;
+
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const uint32_t victim = (start + i) % n;
+            if (victim == thief) continue;
+
+            WorkQueue& q = *m_queues[victim];
+            std::unique_lock<std::mutex> lock(q.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || q.size == 0)
+                continue;
+
+            out = std::move(q.jobs[q.front]);
+            q.front = (q.front + 1) % WorkQueue::Capacity;
+            --q.size;
+            m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    bool JobSystem::TryGetJob(Job& out)
+    {
+        if (m_queuedJobs.load(std::memory_order_acquire) <= 0)
+            return false;
+
+        const uint32_t self = t_threadIndex;
+        if (self < m_queues.size() && TryPop(self, out))
+            return true;
+
+        return TrySteal(self, out);
+    }
+
+    void JobSystem::Execute(Job& job)
+    {
+        {
+            MY2D_PROFILE_SCOPE("Job");
+            if (job.fn) job.fn();
+        }
+
+        if (job.counter)
+            FinishOne(job.counter);
+    }
+
+    void JobSystem::FinishOne(JobCounter* counter)
+    {
+        std::vector<Job> ready;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_mutex);
+            if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ready.swap(counter->m_continuations);
+        }
+
+        for (auto& j : ready)
+            Push(std::move(j));
+    }
+
+    void JobSystem::Submit(JobFunction fn, JobCounter* counter)
+    {
+        if (counter)
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        Push(Job{ std::move(fn), counter });
+    }
+
+    void JobSystem::SubmitAfter(JobCounter& dependency, JobFunction fn, JobCounter* counter)
+    {
+        if (counter)
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            std::lock_guard<std::mutex> lock(dependency.m_mutex);
+            if (!dependency.IsDone())
+            {
+                dependency.m_continuations.push_back(Job{ std::move(fn), counter });
+                return;
+            }
+        }
+
+        Push(Job{ std::move(fn), counter });
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        MY2D_PROFILE_SCOPE("JobSystem::Wait");
+
+        while (!counter.IsDone())
+        {
+            Job job;
+            if (TryGetJob(job))
+                Execute(job);
+            else
+                std::this_thread::yield();
+        }
+
+        // The last finisher may still be inside FinishOne holding the counter's lock
+        std::lock_guard<std::mutex> lock(counter.m_mutex);
+    }
+}
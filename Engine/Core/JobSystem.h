@@ -0,0 +1,243 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace my2d
+{
+    class JobCounter;
+
+    // Move-only void() callable stored inline, so submitting a job never touches the heap.
+    // The callable must fit kInlineSize: capture by reference or through a pointer, not big objects by value.
+    class JobFunction
+    {
+    public:
+        static constexpr size_t kInlineSize = 64;
+
+        JobFunction() = default;
+
+        template<typename Fn, typename F = std::decay_t<Fn>,
+            typename = std::enable_if_t<!std::is_same_v<F, JobFunction>>>
+        JobFunction(Fn&& fn)
+        {
+            static_assert(sizeof(F) <= kInlineSize && alignof(F) <= alignof(std::max_align_t),
+                "job callable doesn't fit inline: capture by reference or through a pointer");
+            ::new ((void*)m_storage) F(std::forward<Fn>(fn));
+            m_ops = &kOps<F>;
+        }
+
+        JobFunction(JobFunction&& other) noexcept { MoveFrom(other); }
+        JobFunction& operator=(JobFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                MoveFrom(other);
+            }
+            return *this;
+        }
+        JobFunction(const JobFunction&) = delete;
+        JobFunction& operator=(const JobFunction&) = delete;
+        ~JobFunction() { Reset(); }
+
+        explicit operator bool() const { return m_ops != nullptr; }
+        void operator()() { m_ops->invoke(m_storage); }
+
+    private:
+        struct Ops
+        {
+            void (*invoke)(void*);
+            void (*move)(void* dst, void* src); // move-constructs dst, destroys src
+            void (*destroy)(void*);
+        };
+
+        template<typename F>
+        static constexpr Ops kOps = {
+            [](void* p) { (*static_cast<F*>(p))(); },
+            [](void* dst, void* src) { ::new (dst) F(std::move(*static_cast<F*>(src))); static_cast<F*>(src)->~F(); },
+            [](void* p) { static_cast<F*>(p)->~F(); },
+        };
+
+        void Reset()
+        {
+            if (m_ops)
+                m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+
+        void MoveFrom(JobFunction& other)
+        {
+            if (!other.m_ops)
+                return;
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = std::exchange(other.m_ops, nullptr);
+        }
+
+        alignas(std::max_align_t) unsigned char m_storage[kInlineSize];
+        const Ops* m_ops = nullptr;
+    };
+
+    struct Job
+    {
+        JobFunction fn;
+        JobCounter* counter = nullptr; // decremented when fn returns (optional)
+    };
+
+    // Outstanding-work counter. JobSystem::Wait() on it; SubmitAfter() chains work behind it.
+    // Must outlive every job that references it (Wait before it goes out of scope).
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+        int Pending() const { return m_pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<int> m_pending{ 0 };
+        std::mutex m_mutex;
+        std::vector<Job> m_continuations; // released when m_pending hits zero (the one allocating path)
+    };
+
+    // Work-stealing scheduler: one fixed-capacity ring per worker (+ one for the owner thread).
+    // Owners push/pop at the back, thieves steal from the front. Submit doesn't allocate; a job pushed
+    // onto a full ring runs inline instead.
+    // The owner thread submits and waits; it has no dedicated worker and runs jobs while it waits. It is the
+    // thread that called Initialize (the main thread) until another one calls SetOwnerThread: under
+    // Engine's pipelined rendering that is the simulation thread.
+    class JobSystem
+    {
+    public:
+        JobSystem() = default;
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // The caller becomes the owner thread. workerThreads == 0 => everything runs inline on Wait().
+        void Initialize(uint32_t workerThreads);
+        // From the owner thread, once no jobs are being submitted
+        void Shutdown();
+
+        // Hands the owner's queue to the calling thread. The previous owner must not Submit/Wait after this
+        // (until it takes it back the same way); ownership changes hands only while no jobs are in flight.
+        void SetOwnerThread();
+
+        // Worker threads + the main thread
+        uint32_t ThreadCount() const { return (uint32_t)m_workers.size() + 1; }
+        uint32_t WorkerThreadCount() const { return (uint32_t)m_workers.size(); }
+
+        // 0 = owner thread, 1..N = workers, UINT32_MAX = some other thread
+        static uint32_t CurrentThreadIndex();
+
+        void Submit(JobFunction fn, JobCounter* counter = nullptr);
+
+        // Runs fn once `dependency` reaches zero (immediately if it already has). Parking it on the
+        // counter may allocate.
+        void SubmitAfter(JobCounter& dependency, JobFunction fn, JobCounter* counter = nullptr);
+
+        // Helps execute jobs until the counter reaches zero. Owner thread or a job.
+        void Wait(JobCounter& counter);
+
+        // fn(begin, end) over [0, count) in chunks of `grain`. Blocks until done.
+        template<typename Fn>
+        void ParallelFor(uint32_t count, uint32_t grain, Fn&& fn)
+        {
+            if (count == 0) return;
+            grain = std::max<uint32_t>(1, grain);
+
+            if (count <= grain || ThreadCount() == 1)
+            {
+                fn(0u, count);
+                return;
+            }
+
+            JobCounter counter;
+            for (uint32_t begin = 0; begin < count; begin += grain)
+            {
+                const uint32_t end = std::min(count, begin + grain);
+                Submit([&fn, begin, end]() { fn(begin, end); }, &counter);
+            }
+            Wait(counter);
+        }
+
+        // fn(entity) for every entity of an EnTT view/group, split by index without copying the entity list.
+        // Groups and single-type views are indexed directly; multi-type views split their leading storage
+        // and skip entities the view doesn't contain. fn must not add/remove the viewed component types.
+        template<typename View, typename Fn>
+        void ParallelForEach(const View& view, uint32_t grain, Fn&& fn)
+        {
+            using It = decltype(view.begin());
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>)
+            {
+                const It first = view.begin();
+                ParallelFor((uint32_t)(view.end() - first), grain, [&](uint32_t begin, uint32_t end)
+                    {
+                        for (It it = first + begin, last = first + end; it != last; ++it)
+                            fn(*it);
+                    });
+            }
+            else
+            {
+                const auto* lead = view.handle();
+                if (!lead)
+                    return;
+
+                ParallelFor((uint32_t)lead->size(), grain, [&](uint32_t begin, uint32_t end)
+                    {
+                        const auto* entities = lead->data();
+                        for (uint32_t i = begin; i < end; ++i)
+                        {
+                            if (view.contains(entities[i]))
+                                fn(entities[i]);
+                        }
+                    });
+            }
+        }
+
+    private:
+        // Ring of jobs, [front, front + size) modulo Capacity; only touched under the mutex
+        struct alignas(64) WorkQueue
+        {
+            static constexpr uint32_t Capacity = 1024;
+
+            std::mutex mutex;
+            uint32_t front = 0;
+            uint32_t size = 0;
+            std::array<Job, Capacity> jobs;
+        };
+
+        void WorkerMain(uint32_t index);
+        void Push(Job job);
+        bool TryPop(uint32_t index, Job& out);
+        bool TrySteal(uint32_t thief, Job& out);
+        bool TryGetJob(Job& out);
+        void Execute(Job& job);
+        void FinishOne(JobCounter* counter);
+
+    private:
+        std::vector<std::unique_ptr<WorkQueue>> m_queues; // [0] = main thread
+        std::vector<std::thread> m_workers;
+
+        std::atomic<bool> m_running{ false };
+        std::atomic<int> m_queuedJobs{ 0 };
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wake;
+    };
+}
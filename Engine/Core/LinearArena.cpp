@@ -0,0 +1,62 @@
+#include "pch.h"
+#include "Core/LinearArena.h"
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace my2d
+{
+    LinearArena::~LinearArena()
+    {
+        Reset();
+    }
+
+    void LinearArena::Initialize(size_t capacityBytes, const char* name)
+    {
+        Reset();
+
+        m_name = name ? name : "Arena";
+        m_capacity = capacityBytes;
+        m_buffer = (capacityBytes > 0) ? std::make_unique<std::byte[]>(capacityBytes) : nullptr;
+        m_offset = 0;
+        m_highWater = 0;
+        m_overflowCount = 0;
+    }
+
+    void* LinearArena::Allocate(size_t size, size_t align)
+    {
+        if (size == 0) size = 1;
+
+        const uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer.get());
+        const uintptr_t aligned = (base + m_offset + (align - 1)) & ~(uintptr_t)(align - 1);
+        const size_t newOffset = (size_t)(aligned - base) + size;
+
+        void* p = nullptr;
+        if (m_buffer && newOffset <= m_capacity)
+        {
+            m_offset = newOffset;
+            p = reinterpret_cast<void*>(aligned);
+        }
+        else
+        {
+            if (m_overflowCount++ == 0)
+                spdlog::warn("{}: out of space ({} bytes), falling back to the heap. Check the high-water mark.", m_name, m_capacity);
+
+            p = ::operator new(size, std::align_val_t(align));
+            m_overflow.push_back(OverflowBlock{ p, align });
+            m_overflowBytes += size;
+        }
+
+        m_highWater = std::max(m_highWater, Used());
+        return p;
+    }
+
+    void LinearArena::Reset()
+    {
+        for (const OverflowBlock& b : m_overflow)
+            ::operator delete(b.ptr, std::align_val_t(b.align));
+        m_overflow.clear();
+        m_overflowBytes = 0;
+        m_offset = 0;
+    }
+}
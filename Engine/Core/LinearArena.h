@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace my2d
+{
+    // Bump allocator for short-lived scratch memory (per frame / per fixed tick).
+    // Allocate is a pointer bump, individual frees are no-ops, Reset() drops everything at once.
+    // Running out of capacity falls back to the heap (freed on Reset) and is counted in the
+    // high-water mark, so the mark is the size the arena should have had.
+    // Main thread only.
+    class LinearArena
+    {
+    public:
+        LinearArena() = default;
+        ~LinearArena();
+
+        LinearArena(const LinearArena&) = delete;
+        LinearArena& operator=(const LinearArena&) = delete;
+
+        void Initialize(size_t capacityBytes, const char* name);
+
+        void* Allocate(size_t size, size_t align = alignof(std::max_align_t));
+        void Reset();
+
+        size_t Capacity() const { return m_capacity; }
+        size_t Used() const { return m_offset + m_overflowBytes; }
+        size_t HighWaterMark() const { return m_highWater; }
+        uint64_t OverflowCount() const { return m_overflowCount; }
+        const char* Name() const { return m_name; }
+
+    private:
+        struct OverflowBlock
+        {
+            void* ptr;
+            size_t align;
+        };
+
+        std::unique_ptr<std::byte[]> m_buffer;
+        size_t m_capacity = 0;
+        size_t m_offset = 0;
+
+        std::vector<OverflowBlock> m_overflow;
+        size_t m_overflowBytes = 0;
+        uint64_t m_overflowCount = 0;
+
+        size_t m_highWater = 0;
+        const char* m_name = "Arena";
+    };
+
+    // STL allocator over a LinearArena. A null arena means plain new/delete,
+    // so helpers can take an optional arena without two code paths.
+    template<typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept = default;
+        explicit ArenaAllocator(LinearArena* arena) noexcept : m_arena(arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.Arena()) {}
+
+        T* allocate(size_t n)
+        {
+            if (m_arena)
+                return static_cast<T*>(m_arena->Allocate(n * sizeof(T), alignof(T)));
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t) noexcept
+        {
+            // Arena memory comes back on Reset()
+            if (!m_arena)
+                ::operator delete(p);
+        }
+
+        LinearArena* Arena() const noexcept { return m_arena; }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>& other) const noexcept { return m_arena == other.Arena(); }
+        template<typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const noexcept { return m_arena != other.Arena(); }
+
+    private:
+        LinearArena* m_arena = nullptr;
+    };
+
+    template<typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace my2d
+{
+    // Read-only memory map of a whole file (MapViewOfFile / mmap). The OS pages it in on first touch,
+    // so nothing is copied until it's read. Data() stays valid until Close() or destruction.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // False if the file is missing, empty or can't be mapped
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        const uint8_t* Data() const { return m_data; }
+        size_t Size() const { return m_size; }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+
+#ifdef _WIN32
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#else
+        int m_fd = -1;
+#endif
+    };
+}
@@ -0,0 +1,255 @@
+#include "pch.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace my2d
+{
+    struct ZoneEvent
+    {
+        const char* name = nullptr;
+        uint64_t startNs = 0;
+        uint64_t endNs = 0;
+        uint32_t depth = 0;
+    };
+
+    // One per thread that ever recorded a zone. Only the owning thread writes, and only with `writing`
+    // set while recording is on; the dump switches recording off and waits for `writing` to drop on
+    // every buffer before reading (see RecordZone / StopRecording).
+    struct ThreadBuffer
+    {
+        static constexpr size_t Capacity = 1u << 16;
+
+        uint32_t tid = 0;
+        std::string name;
+        std::vector<ZoneEvent> events;
+        std::atomic<uint64_t> head{ 0 };
+        std::atomic<bool> writing{ false };
+    };
+
+    static std::mutex s_buffersMutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> s_buffers;
+
+    static thread_local ThreadBuffer* t_buffer = nullptr;
+    static thread_local uint32_t t_depth = 0;
+
+    // Capture state (main thread only, driven by NewFrame)
+    static uint32_t s_requestedFrames = 0;
+    static uint32_t s_framesLeft = 0;
+    static std::string s_capturePath;
+    static uint64_t s_captureStartNs = 0;
+    static uint64_t s_captureEndNs = 0;
+
+    static ThreadBuffer& GetThreadBuffer()
+    {
+        if (t_buffer)
+            return *t_buffer;
+
+        auto buf = std::make_unique<ThreadBuffer>();
+        buf->events.resize(ThreadBuffer::Capacity);
+
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buf->tid = (uint32_t)s_buffers.size() + 1;
+        buf->name = (buf->tid == 1) ? "Main" : ("Thread " + std::to_string(buf->tid));
+
+        t_buffer = buf.get();
+        s_buffers.push_back(std::move(buf));
+        return *t_buffer;
+    }
+
+    uint64_t Profiler::NowNs()
+    {
+        using namespace std::chrono;
+        return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        ThreadBuffer& buf = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        buf.name = name ? name : "";
+    }
+
+    void Profiler::RecordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth)
+    {
+        ThreadBuffer& buf = GetThreadBuffer();
+
+        // seq_cst pair with StopRecording: either it sees `writing` and waits for this event, or this
+        // sees recording off and drops the zone (it would end outside the window anyway)
+        buf.writing.store(true);
+        if (!s_recording.load())
+        {
+            buf.writing.store(false, std::memory_order_release);
+            return;
+        }
+
+        const uint64_t h = buf.head.load(std::memory_order_relaxed);
+        ZoneEvent& ev = buf.events[h % ThreadBuffer::Capacity];
+        ev.name = name;
+        ev.startNs = startNs;
+        ev.endNs = endNs;
+        ev.depth = depth;
+        buf.head.store(h + 1, std::memory_order_release);
+        buf.writing.store(false, std::memory_order_release);
+    }
+
+    // Switches recording off on every thread and waits until no zone is mid-write, so the buffers can
+    // be read. Zones still open keep running but record nothing. Call with s_buffersMutex held.
+    static void StopRecording(std::atomic<bool>& recording)
+    {
+        recording.store(false);
+        for (const auto& buf : s_buffers)
+        {
+            while (buf->writing.load(std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+    }
+
+    void Profiler::RequestCapture(uint32_t frames, std::string path)
+    {
+        if (frames == 0) return;
+        s_requestedFrames = frames;
+        s_capturePath = std::move(path);
+    }
+
+    void Profiler::NewFrame()
+    {
+        if (s_recording.load(std::memory_order_relaxed))
+        {
+            if (s_framesLeft > 0)
+                --s_framesLeft;
+
+            if (s_framesLeft == 0)
+            {
+                s_captureEndNs = NowNs();
+                WriteChromeTrace(s_capturePath);
+            }
+        }
+
+        if (!s_recording.load(std::memory_order_relaxed) && s_requestedFrames > 0)
+        {
+            // Make sure the main thread is buffer #1 so it sorts first in the viewer
+            GetThreadBuffer();
+
+            s_framesLeft = s_requestedFrames;
+            s_requestedFrames = 0;
+            s_captureStartNs = NowNs();
+            s_captureEndNs = 0;
+            s_recording.store(true, std::memory_order_relaxed);
+            spdlog::info("Profiler: capturing {} frames -> '{}'", s_framesLeft, s_capturePath);
+        }
+    }
+
+    static void WriteEscaped(std::ofstream& out, const std::string& s)
+    {
+        for (char c : s)
+        {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+    }
+
+    bool Profiler::WriteChromeTrace(const std::string& path)
+    {
+        std::ofstream out(path, std::ios::binary);
+        if (!out)
+        {
+            spdlog::error("Profiler: cannot open '{}'", path);
+            return false;
+        }
+
+        const uint64_t windowStart = s_captureStartNs;
+        const uint64_t windowEnd = (s_captureEndNs != 0) ? s_captureEndNs : NowNs();
+
+        std::lock_guard<std::mutex> lock(s_buffersMutex);
+        StopRecording(s_recording);
+
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        size_t written = 0;
+        bool wrapped = false;
+
+        std::vector<ZoneEvent> events;
+        for (const auto& buf : s_buffers)
+        {
+            if (!first) out << ",";
+            first = false;
+            out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buf->tid << ",\"args\":{\"name\":\"";
+            WriteEscaped(out, buf->name);
+            out << "\"}}";
+
+            const uint64_t head = buf->head.load(std::memory_order_acquire);
+            const uint64_t count = std::min<uint64_t>(head, ThreadBuffer::Capacity);
+
+            events.clear();
+            for (uint64_t i = head - count; i < head; ++i)
+            {
+                const ZoneEvent& ev = buf->events[i % ThreadBuffer::Capacity];
+                if (ev.startNs < windowStart || ev.endNs > windowEnd) continue;
+                events.push_back(ev);
+            }
+
+            // Ring wrapped inside the window: the oldest part of the capture is gone
+            if (head > ThreadBuffer::Capacity && buf->events[head % ThreadBuffer::Capacity].startNs >= windowStart)
+                wrapped = true;
+
+            // Parents before children at equal start times keeps older viewers happy
+            std::sort(events.begin(), events.end(), [](const ZoneEvent& a, const ZoneEvent& b)
+                {
+                    if (a.startNs != b.startNs) return a.startNs < b.startNs;
+                    return a.depth < b.depth;
+                });
+
+            for (const ZoneEvent& ev : events)
+            {
+                const double ts = (double)(ev.startNs - windowStart) / 1000.0;
+                const double dur = (double)(ev.endNs - ev.startNs) / 1000.0;
+
+                out << ",{\"ph\":\"X\",\"cat\":\"cpu\",\"pid\":1,\"tid\":" << buf->tid
+                    << ",\"ts\":" << ts << ",\"dur\":" << dur << ",\"name\":\"";
+                WriteEscaped(out, ev.name ? ev.name : "?");
+                out << "\"}";
+                ++written;
+            }
+        }
+
+        out << "]}";
+
+        if (wrapped)
+            spdlog::warn("Profiler: ring buffer wrapped during capture, oldest zones were lost");
+
+        spdlog::info("Profiler: wrote {} zones to '{}'", written, path);
+        return true;
+    }
+
+    ProfileScope::ProfileScope(const char* name)
+    {
+        if (!Profiler::IsCapturing())
+            return;
+
+        m_active = true;
+        m_name = name;
+        m_depth = t_depth++;
+        m_startNs = Profiler::NowNs();
+    }
+
+    ProfileScope::~ProfileScope()
+    {
+        if (!m_active)
+            return;
+
+        const uint64_t endNs = Profiler::NowNs();
+        --t_depth;
+        Profiler::RecordZone(m_name, m_startNs, endNs, m_depth);
+    }
+}
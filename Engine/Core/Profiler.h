@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Set MY2D_PROFILER=0 in the project defines to compile every zone out.
+#ifndef MY2D_PROFILER
+#define MY2D_PROFILER 1
+#endif
+
+namespace my2d
+{
+    // Scoped-zone CPU profiler.
+    // Zones are only recorded while a capture is running, into per-thread ring buffers,
+    // and dumped as Chrome trace JSON (chrome://tracing or ui.perfetto.dev).
+    class Profiler
+    {
+    public:
+        // Call once at the top of every frame (before that frame's zones).
+        static void NewFrame();
+
+        // Record the next `frames` frames, then write them to `path`.
+        static void RequestCapture(uint32_t frames, std::string path);
+        static bool IsCapturing() { return s_recording.load(std::memory_order_relaxed); }
+
+        // Writes the last capture window from all thread buffers. Ends a running capture first (on every
+        // thread, waiting out zones mid-write), so the buffers are never read while being written.
+        static bool WriteChromeTrace(const std::string& path);
+
+        // Shows up as the track name in the trace viewer.
+        static void SetThreadName(const char* name);
+
+        static uint64_t NowNs();
+
+        // `name` must outlive the capture (string literal).
+        static void RecordZone(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth);
+
+    private:
+        static inline std::atomic<bool> s_recording{ false };
+    };
+
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name);
+        ~ProfileScope();
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* m_name = nullptr;
+        uint64_t m_startNs = 0;
+        uint32_t m_depth = 0;
+        bool m_active = false;
+    };
+}
+
+#if MY2D_PROFILER
+#define MY2D_PROFILE_CONCAT_INNER(a, b) a##b
+#define MY2D_PROFILE_CONCAT(a, b) MY2D_PROFILE_CONCAT_INNER(a, b)
+#define MY2D_PROFILE_SCOPE(name) ::my2d::ProfileScope MY2D_PROFILE_CONCAT(my2dProfileZone_, __LINE__)(name)
+#define MY2D_PROFILE_FRAME() ::my2d::Profiler::NewFrame()
+#else
+#define MY2D_PROFILE_SCOPE(name) ((void)0)
+#define MY2D_PROFILE_FRAME() ((void)0)
+#endif
@@ -0,0 +1,40 @@
+#include "pch.h"
+#include "Core/StringId.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <spdlog/spdlog.h>
+
+namespace my2d
+{
+    // Node-based map: string references handed out by Str() never move
+    static std::mutex s_tableMutex;
+    static std::unordered_map<uint64_t, std::string>& Table()
+    {
+        static std::unordered_map<uint64_t, std::string> s_table;
+        return s_table;
+    }
+
+    uint64_t StringId::Intern(std::string_view s)
+    {
+        const uint64_t id = Hash(s);
+        if (id == 0) return 0;
+
+        std::lock_guard<std::mutex> lock(s_tableMutex);
+        auto [it, inserted] = Table().try_emplace(id, s);
+        if (!inserted && it->second != s)
+            spdlog::error("StringId: hash collision between '{}' and '{}'", it->second, s);
+
+        return id;
+    }
+
+    const std::string& StringId::Str() const
+    {
+        static const std::string s_empty;
+        if (m_id == 0) return s_empty;
+
+        std::lock_guard<std::mutex> lock(s_tableMutex);
+        auto it = Table().find(m_id);
+        return (it != Table().end()) ? it->second : s_empty;
+    }
+}
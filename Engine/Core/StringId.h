@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace my2d
+{
+    // Interned string: an FNV-1a hash plus one shared copy of the text in a global table.
+    // Compare/hash as a plain integer; Str() is for saving and logging.
+    // The empty string is id 0.
+    class StringId
+    {
+    public:
+        StringId() = default;
+        explicit StringId(std::string_view s) : m_id(Intern(s)) {}
+        explicit StringId(const char* s) : StringId(std::string_view(s ? s : "")) {}
+        explicit StringId(const std::string& s) : StringId(std::string_view(s)) {}
+
+        uint64_t Value() const { return m_id; }
+        bool Empty() const { return m_id == 0; }
+
+        // Thread-safe. Reference stays valid for the life of the process.
+        const std::string& Str() const;
+
+        bool operator==(const StringId& o) const { return m_id == o.m_id; }
+        bool operator!=(const StringId& o) const { return m_id != o.m_id; }
+
+        static constexpr uint64_t Hash(std::string_view s)
+        {
+            if (s.empty()) return 0;
+
+            uint64_t h = 1469598103934665603ull;
+            for (char c : s)
+            {
+                h ^= (uint8_t)c;
+                h *= 1099511628211ull;
+            }
+            return h ? h : 1; // 0 is reserved for ""
+        }
+
+    private:
+        static uint64_t Intern(std::string_view s);
+
+    private:
+        uint64_t m_id = 0;
+    };
+}
+
+template<>
+struct std::hash<my2d::StringId>
+{
+    size_t operator()(const my2d::StringId& s) const noexcept { return (size_t)s.Value(); }
+};
@@ -26,6 +26,14 @@ namespace my2d
             ++m_frameIndex;
         }
 
+        // Advance by a fixed amount (headless/replay runs, no wall clock involved)
+        void Advance(double seconds)
+        {
+            m_deltaSeconds = seconds;
+            m_totalSeconds += seconds;
+            ++m_frameIndex;
+        }
+
         double DeltaSeconds() const { return m_deltaSeconds; }
         double TotalSeconds() const { return m_totalSeconds; }
         uint64_t FrameIndex() const { return m_frameIndex; }
@@ -2,8 +2,16 @@
 #include "framework.h"
 
 #include "Platform/Window.h"
+#include "Core/Profiler.h"
+#include "Scene/Scene.h"
+#include "Scene/StateHash.h"
+#include "Physics/PhysicsSystem.h"
+#include "Renderer/Texture2D.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <spdlog/spdlog.h>
 #include "Platform/SdlImage.h"
 #include "Platform/SdlTtf.h"
@@ -20,6 +28,44 @@ namespace my2d
         spdlog::set_level(spdlog::level::info);
     }
 
+    static uint64_t HashAppState(App& app)
+    {
+        Scene* scene = app.GetActiveScene();
+        return scene ? Scene_HashState(*scene) : 0;
+    }
+
+    // Post-step sync point: deferred destroys/adds/removes queued by gameplay systems, then child
+    // world transforms (bodies moved by the step) and the child bodies they carry, before the next step
+    static void FlushSceneCommands(Engine& engine, App& app)
+    {
+        if (Scene* scene = app.GetActiveScene())
+        {
+            scene->FlushCommands();
+            scene->UpdateWorldTransforms(true);
+            Physics_SyncChildBodies(*scene, engine.GetPhysics(), engine.PixelsPerMeter());
+        }
+    }
+
+    // Last sync point of a frame: flush + world transforms, then let the scene roll its per-frame transform counts
+    void Engine::EndSceneFrame(App& app, bool fixedStep)
+    {
+        Scene* scene = app.GetActiveScene();
+        if (!scene)
+            return;
+
+        scene->FlushCommands();
+        scene->UpdateWorldTransforms(fixedStep);
+        Physics_SyncChildBodies(*scene, m_physics, m_pixelsPerMeter);
+        scene->EndFrame();
+
+        // Scenes come and go with rooms; keep the run-wide numbers here
+        const uint32_t moved = scene->GetTransformStats().movedLastFrame;
+        m_transformStats.movedLastFrame = moved;
+        m_transformStats.maxMoved = std::max(m_transformStats.maxMoved, moved);
+        m_transformStats.totalMoved += moved;
+        ++m_transformStats.frames;
+    }
+
     Engine::Engine() = default;
 
     Engine::~Engine()
@@ -38,7 +84,14 @@ namespace my2d
 
         SDL_SetMainReady();
 
-        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER) != 0)
+        m_headless = config.headless;
+
+        // Headless boxes have no display: only the event subsystem (for SDL_QUIT on Ctrl+C)
+        const Uint32 sdlFlags = m_headless
+            ? SDL_INIT_EVENTS
+            : (SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_GAMECONTROLLER);
+
+        if (SDL_Init(sdlFlags) != 0)
         {
             spdlog::error("SDL_Init failed: {}", SDL_GetError());
             return false;
@@ -67,29 +120,51 @@ namespace my2d
             return false;
         }
 
-        if (!m_window.Create(config))
+        if (!m_headless && !m_window.Create(config))
             return false;
 
-        // Hook runtime systems to the created SDL_Renderer
+        // Hook runtime systems to the created SDL_Renderer (null when headless)
         m_assets.SetRenderer(m_window.GetSDLRenderer());
         m_assets.SetContentRoot(config.contentRoot);
         m_contentRoot = m_assets.ContentRoot();
 
         m_renderer2d.SetRenderer(m_window.GetSDLRenderer());
-        m_renderer2d.SetViewport(m_window.Width(), m_window.Height());
+        if (m_headless)
+            m_renderer2d.SetViewport(config.windowWidth, config.windowHeight);
+        else
+            m_renderer2d.SetViewport(m_window.Width(), m_window.Height());
 
         m_pixelsPerMeter = config.pixelsPerMeter;
         m_drawPhysicsDebug = config.drawPhysicsDebug;
 
+        uint32_t workers = 0;
+        if (config.jobWorkerThreads >= 0)
+            workers = (uint32_t)config.jobWorkerThreads;
+        else
+            workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        m_jobs.Initialize(workers);
+
+        // Physics runs on the job threads, so they have to exist first
         m_gravity = b2Vec2(config.gravityX, config.gravityY);
-        m_physics.Initialize(m_gravity);
+        m_physicsWorkers = (config.physicsWorkerThreads >= 0) ? (uint32_t)config.physicsWorkerThreads : m_jobs.ThreadCount();
+        m_physics.Initialize(m_gravity, &m_jobs, m_physicsWorkers);
+        m_physics.SetSubSteps(config.physicsSubSteps);
+        spdlog::info("Physics: {} solver threads, {} sub-steps", m_physics.WorkerCount(), m_physics.SubSteps());
+
+        AllocTracker::SetEnabled(config.trackAllocations);
+
+        m_frameArena.Initialize(config.frameArenaBytes, "Frame arena");
+        m_tickArena.Initialize(config.tickArenaBytes, "Tick arena");
 
         m_time.Reset(SDL_GetPerformanceCounter());
+        m_limiter.SetTargetFps(config.targetFps);
+        m_limiter.Reset();
+        m_lowPower = false;
         m_fixedAccumulator = 0.0;
         m_quitRequested = false;
         m_initialized = true;
 
-        spdlog::info("Engine initialized.");
+        spdlog::info(m_headless ? "Engine initialized (headless)." : "Engine initialized.");
         return true;
     }
 
@@ -100,18 +175,48 @@ namespace my2d
 
         spdlog::info("Engine shutdown...");
 
+        const FrameLimiterStats& frames = m_limiter.TotalStats();
+        if (frames.frames > 0)
+        {
+            spdlog::info("Frames: {} at {:.2f} ms avg (jitter {:.2f} ms, max {:.2f} ms), {:.0f}% idle",
+                frames.frames, frames.avgFrameMs, frames.jitterMs, frames.maxFrameMs, frames.idlePercent);
+        }
+
+        if (m_transformStats.frames > 0)
+        {
+            spdlog::info("Transforms moved: {:.1f} avg, {} max per frame over {} frames",
+                m_transformStats.AvgMoved(), m_transformStats.maxMoved, m_transformStats.frames);
+        }
+
+        for (const LinearArena* arena : { &m_frameArena, &m_tickArena })
+        {
+            spdlog::info("{}: high-water {} KB of {} KB ({} heap fallbacks)",
+                arena->Name(), arena->HighWaterMark() / 1024, arena->Capacity() / 1024, arena->OverflowCount());
+        }
+
+        m_physics.Shutdown();
+        m_jobs.Shutdown();
         m_window.Destroy();
 
         TTF_Quit();
         IMG_Quit();
-        m_physics.Shutdown();
         SDL_Quit();
 
+        AllocTracker::SetEnabled(false);
         m_initialized = false;
     }
 
     int Engine::Run(const EngineConfig& config, App& app)
     {
+        if (!config.replayInputPath.empty())
+            return RunReplay(config, app);
+
+        if (config.headless)
+            return RunHeadless(config, app, 0);
+
+        if (config.pipelinedRendering)
+            return RunPipelined(config, app);
+
         if (!Initialize(config))
             return 1;
 
@@ -122,34 +227,54 @@ namespace my2d
             return 2;
         }
 
+        if (!config.recordInputPath.empty())
+            m_recorder.Open(config.recordInputPath, config.fixedDeltaSeconds);
+
+        uint32_t frameIndex = 0;
+        uint64_t tick = 0;
+
         // Main loop
         while (!m_quitRequested)
         {
+            MY2D_PROFILE_FRAME();
+            MY2D_PROFILE_SCOPE("Frame");
+
             // Tick time
             m_time.Tick(SDL_GetPerformanceCounter(), SDL_GetPerformanceFrequency());
 
             // Clamp dt to avoid spiral-of-death on pauses/breakpoints
             const double dt = std::min(m_time.DeltaSeconds(), 0.25);
 
+            // Frame boundary: last frame's scratch memory is dead now
+            m_frameArena.Reset();
+            AllocTracker::NewFrame();
+
             // Input frame boundary
             m_input.BeginFrame();
+            m_recorder.BeginFrame(frameIndex++, tick, dt);
 
             // Pump events
-            SDL_Event e{};
-            while (SDL_PollEvent(&e))
             {
-                if (e.type == SDL_QUIT)
-                {
-                    RequestQuit();
-                    continue;
-                }
+                MY2D_PROFILE_SCOPE("Engine::PumpEvents");
 
-                // Allow app to consume first if desired
-                const bool consumed = app.OnEvent(*this, e);
-                if (!consumed)
+                SDL_Event e{};
+                while (SDL_PollEvent(&e))
                 {
-                    m_input.OnEvent(e);
-                    m_window.OnEvent(e);
+                    if (e.type == SDL_QUIT)
+                    {
+                        RequestQuit();
+                        continue;
+                    }
+
+                    m_recorder.RecordEvent(e);
+
+                    // Allow app to consume first if desired
+                    const bool consumed = app.OnEvent(*this, e);
+                    if (!consumed)
+                    {
+                        m_input.OnEvent(e);
+                        m_window.OnEvent(e);
+                    }
                 }
             }
 
@@ -162,25 +287,541 @@ namespace my2d
 
             while (m_fixedAccumulator >= fixedDt)
             {
-                app.OnFixedUpdate(*this, fixedDt);      // pre-step: set velocities, spawn hitboxes, etc.
-                m_physics.Step((float)fixedDt);         // step physics
-                app.OnPostFixedUpdate(*this, fixedDt);  // post-step: process sensor events + sync transforms
+                MY2D_PROFILE_SCOPE("Engine::FixedStep");
+                m_tickArena.Reset();
+                {
+                    MY2D_PROFILE_SCOPE("App::OnFixedUpdate");
+                    app.OnFixedUpdate(*this, fixedDt);      // pre-step: set velocities, spawn hitboxes, etc.
+                }
+                m_physics.Step((float)fixedDt);             // step physics
+                {
+                    MY2D_PROFILE_SCOPE("App::OnPostFixedUpdate");
+                    app.OnPostFixedUpdate(*this, fixedDt);  // post-step: process sensor events + sync transforms
+                    FlushSceneCommands(*this, app);
+                }
+                if (m_recorder.IsOpen())
+                    m_recorder.RecordTick(tick, HashAppState(app));
+                ++tick;
                 m_fixedAccumulator -= fixedDt;
             }
 
+            // Leftover time: render blends this far from the previous step toward the latest one
+            m_renderAlpha = (float)(m_fixedAccumulator / fixedDt);
+
             // Variable update + render
+            {
+                MY2D_PROFILE_SCOPE("App::OnUpdate");
+                app.OnUpdate(*this, dt);
+                EndSceneFrame(app, false);
+            }
+
+            // Nothing to look at while minimized
+            if (!m_window.IsMinimized())
+            {
+                {
+                    MY2D_PROFILE_SCOPE("Window::BeginFrame");
+                    m_window.BeginFrame();
+                }
+                {
+                    MY2D_PROFILE_SCOPE("App::OnRender");
+                    app.OnRender(*this);
+                }
+                {
+                    MY2D_PROFILE_SCOPE("Window::EndFrame");
+                    m_window.EndFrame();
+                }
+            }
+
+            LimitFrameRate(config);
+        }
+
+        m_recorder.Close();
+        app.OnShutdown(*this);
+        Shutdown();
+        return 0;
+    }
+
+    void Engine::LimitFrameRate(const EngineConfig& config)
+    {
+        // Unfocused/minimized: nobody is watching, drop to the low-power rate
+        const bool lowPower = !m_headless && config.lowPowerFps > 0.0 && (!m_window.IsFocused() || m_window.IsMinimized());
+        if (lowPower != m_lowPower)
+        {
+            m_lowPower = lowPower;
+            if (lowPower)
+                spdlog::info("Low-power mode: {:.0f} fps", config.lowPowerFps);
+            else
+                spdlog::info("Leaving low-power mode");
+        }
+
+        double fps = config.targetFps;
+        if (lowPower)
+            fps = (fps > 0.0) ? std::min(fps, config.lowPowerFps) : config.lowPowerFps;
+
+        m_limiter.SetTargetFps(fps);
+        m_limiter.Wait();
+    }
+
+    void Engine::SimulateFrame(const EngineConfig& config, App& app, double dt, const std::vector<SDL_Event>& events,
+        int viewW, int viewH, uint32_t frameIndex, uint64_t& tick, RenderSnapshot& out)
+    {
+        MY2D_PROFILE_SCOPE("Engine::SimulateFrame");
+
+        m_frameArena.Reset();
+        m_input.BeginFrame();
+        m_recorder.BeginFrame(frameIndex, tick, dt);
+
+        for (const SDL_Event& e : events)
+        {
+            m_recorder.RecordEvent(e);
+            if (!app.OnEvent(*this, e))
+                m_input.OnEvent(e);
+        }
+
+        m_renderer2d.SetViewport(viewW, viewH);
+
+        m_fixedAccumulator += dt;
+        const double fixedDt = config.fixedDeltaSeconds;
+
+        while (m_fixedAccumulator >= fixedDt)
+        {
+            MY2D_PROFILE_SCOPE("Engine::FixedStep");
+            m_tickArena.Reset();
+            {
+                MY2D_PROFILE_SCOPE("App::OnFixedUpdate");
+                app.OnFixedUpdate(*this, fixedDt);
+            }
+            m_physics.Step((float)fixedDt);
+            {
+                MY2D_PROFILE_SCOPE("App::OnPostFixedUpdate");
+                app.OnPostFixedUpdate(*this, fixedDt);
+                FlushSceneCommands(*this, app);
+            }
+            if (m_recorder.IsOpen())
+                m_recorder.RecordTick(tick, HashAppState(app));
+            ++tick;
+            m_fixedAccumulator -= fixedDt;
+        }
+
+        m_renderAlpha = (float)(m_fixedAccumulator / fixedDt);
+
+        {
+            MY2D_PROFILE_SCOPE("App::OnUpdate");
             app.OnUpdate(*this, dt);
+            EndSceneFrame(app, false);
+        }
+
+        // Camera is final once OnUpdate has run; the snapshot carries its own copy
+        out.Clear();
+        out.frame = frameIndex;
+        out.camera = m_renderer2d.GetCamera();
+        {
+            MY2D_PROFILE_SCOPE("App::OnBuildRenderSnapshot");
+            app.OnBuildRenderSnapshot(*this, out);
+        }
+    }
+
+    int Engine::RunPipelined(const EngineConfig& config, App& app)
+    {
+        if (!Initialize(config))
+            return 1;
+
+        // From here on textures only decode on load; the main thread creates/destroys the SDL side
+        m_pipelined = true;
+        Texture2D::SetDeferredGpu(true);
+
+        m_renderStage.SetRenderer(m_window.GetSDLRenderer());
+        m_renderer2d.SetRenderer(nullptr); // the simulation never draws directly
+
+        if (!app.OnInit(*this))
+        {
+            spdlog::error("App OnInit failed.");
+            Texture2D::SetDeferredGpu(false);
+            Texture2D::DestroyPending();
+            m_pipelined = false;
+            Shutdown();
+            return 2;
+        }
+
+        if (!config.recordInputPath.empty())
+            m_recorder.Open(config.recordInputPath, config.fixedDeltaSeconds);
+
+        // Double buffer: the render stage reads one snapshot while the simulation writes the other
+        RenderSnapshot snapshots[2];
+        int renderIndex = 0;
+
+        // Hand-off to the simulation thread: one frame of work at a time
+        std::mutex simMutex;
+        std::condition_variable simCv;
+        bool simHasWork = false;
+        bool simExit = false;
+
+        double simDt = 0.0;
+        int simViewW = 0;
+        int simViewH = 0;
+        uint32_t simFrameIndex = 0;
+        std::vector<SDL_Event> simEvents;
+        std::vector<SDL_Event> pendingEvents;
+        uint64_t tick = 0;
+
+        std::thread simThread([&]()
+            {
+                Profiler::SetThreadName("Simulation");
+
+                // Physics steps and the app's jobs are submitted from here now; the main thread only
+                // renders until it takes the job system back after the join
+                m_jobs.SetOwnerThread();
+
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(simMutex);
+                        simCv.wait(lock, [&]() { return simHasWork || simExit; });
+                        if (!simHasWork)
+                            break;
+                    }
+
+                    SimulateFrame(config, app, simDt, simEvents, simViewW, simViewH, simFrameIndex, tick,
+                        snapshots[1 - renderIndex]);
+
+                    {
+                        std::lock_guard<std::mutex> lock(simMutex);
+                        simHasWork = false;
+                    }
+                    simCv.notify_all();
+                }
+            });
+
+        uint32_t frameIndex = 0;
+        bool haveSnapshot = false;
+
+        while (!m_quitRequested)
+        {
+            MY2D_PROFILE_FRAME();
+            MY2D_PROFILE_SCOPE("Frame");
+
+            m_time.Tick(SDL_GetPerformanceCounter(), SDL_GetPerformanceFrequency());
+            const double dt = std::min(m_time.DeltaSeconds(), 0.25);
+
+            AllocTracker::NewFrame();
+
+            // Events are pumped here (SDL wants the window thread) and replayed on the simulation thread
+            {
+                MY2D_PROFILE_SCOPE("Engine::PumpEvents");
+
+                pendingEvents.clear();
+                SDL_Event e{};
+                while (SDL_PollEvent(&e))
+                {
+                    if (e.type == SDL_QUIT)
+                    {
+                        RequestQuit();
+                        continue;
+                    }
+
+                    // Unlike Run, the window sees every event, consumed or not: it lives on this thread and
+                    // needs its size/minimized state now, while App::OnEvent only runs on the simulation
+                    // thread during the next frame. Consuming a window event doesn't hide it from the window.
+                    m_window.OnEvent(e);
+                    pendingEvents.push_back(e);
+                }
+            }
 
-            m_window.BeginFrame();
-            app.OnRender(*this);
-            m_window.EndFrame();
+            // Kick frame N+1...
+            {
+                std::lock_guard<std::mutex> lock(simMutex);
+                simEvents.swap(pendingEvents);
+                simDt = dt;
+                simViewW = m_window.Width();
+                simViewH = m_window.Height();
+                simFrameIndex = frameIndex++;
+                simHasWork = true;
+            }
+            simCv.notify_all();
+
+            // ...while frame N goes to the GPU
+            if (!m_window.IsMinimized())
+            {
+                {
+                    MY2D_PROFILE_SCOPE("Window::BeginFrame");
+                    m_window.BeginFrame();
+                }
+                if (haveSnapshot)
+                {
+                    MY2D_PROFILE_SCOPE("Engine::RenderSnapshot");
+                    snapshots[renderIndex].Submit(m_renderStage);
+                }
+                {
+                    MY2D_PROFILE_SCOPE("Window::EndFrame");
+                    m_window.EndFrame();
+                }
+            }
+            Texture2D::DestroyPending();
+
+            {
+                MY2D_PROFILE_SCOPE("Engine::WaitSimulation");
+                std::unique_lock<std::mutex> lock(simMutex);
+                simCv.wait(lock, [&]() { return !simHasWork; });
+            }
+
+            renderIndex = 1 - renderIndex;
+            haveSnapshot = true;
+
+            LimitFrameRate(config);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(simMutex);
+            simExit = true;
         }
+        simCv.notify_all();
+        simThread.join();
+        m_jobs.SetOwnerThread(); // OnShutdown and Shutdown run here
 
+        m_recorder.Close();
         app.OnShutdown(*this);
+
+        // Drop the snapshots' texture references while the renderer still exists
+        snapshots[0].Clear();
+        snapshots[1].Clear();
+        Texture2D::DestroyPending();
+        Texture2D::SetDeferredGpu(false);
+        m_pipelined = false;
+
         Shutdown();
         return 0;
     }
 
+    int Engine::RunHeadless(const EngineConfig& config, App& app, uint64_t ticks)
+    {
+        EngineConfig headlessConfig = config;
+        headlessConfig.headless = true;
+
+        if (!Initialize(headlessConfig))
+            return 1;
+
+        if (!app.OnInit(*this))
+        {
+            spdlog::error("App OnInit failed.");
+            Shutdown();
+            return 2;
+        }
+
+        const double fixedDt = headlessConfig.fixedDeltaSeconds;
+        const uint64_t freq = SDL_GetPerformanceFrequency();
+        const uint64_t start = SDL_GetPerformanceCounter();
+
+        // Recording (no input, so it's a pure determinism check): every tick is a whole frame with its
+        // variable update, the shape RunReplay plays back
+        if (!headlessConfig.recordInputPath.empty())
+            m_recorder.Open(headlessConfig.recordInputPath, fixedDt);
+        const bool recording = m_recorder.IsOpen();
+
+        uint64_t tick = 0;
+        while (!m_quitRequested && (ticks == 0 || tick < ticks))
+        {
+            MY2D_PROFILE_FRAME();
+            MY2D_PROFILE_SCOPE("Engine::FixedStep");
+
+            // Sim time advances by exactly fixedDt per tick, wall clock is only used for reporting
+            m_time.Advance(fixedDt);
+            m_frameArena.Reset();
+            m_tickArena.Reset();
+            AllocTracker::NewFrame();
+            m_input.BeginFrame();
+            m_recorder.BeginFrame((uint32_t)tick, tick, fixedDt);
+
+            // No window, but still honour SDL_QUIT (Ctrl+C)
+            SDL_Event e{};
+            while (SDL_PollEvent(&e))
+            {
+                if (e.type == SDL_QUIT)
+                    RequestQuit();
+            }
+
+            {
+                MY2D_PROFILE_SCOPE("App::OnFixedUpdate");
+                app.OnFixedUpdate(*this, fixedDt);
+            }
+            m_physics.Step((float)fixedDt);
+            if (recording)
+            {
+                {
+                    MY2D_PROFILE_SCOPE("App::OnPostFixedUpdate");
+                    app.OnPostFixedUpdate(*this, fixedDt);
+                    FlushSceneCommands(*this, app);
+                }
+                m_recorder.RecordTick(tick, HashAppState(app));
+                {
+                    MY2D_PROFILE_SCOPE("App::OnUpdate");
+                    app.OnUpdate(*this, fixedDt);
+                    EndSceneFrame(app, false);
+                }
+            }
+            else
+            {
+                MY2D_PROFILE_SCOPE("App::OnPostFixedUpdate");
+                app.OnPostFixedUpdate(*this, fixedDt);
+                EndSceneFrame(app, true); // headless: one tick is one frame
+            }
+            ++tick;
+
+            // Uncapped unless EngineConfig::targetFps asks for real-time pacing
+            LimitFrameRate(headlessConfig);
+        }
+
+        const uint64_t end = SDL_GetPerformanceCounter();
+
+        m_headlessStats.ticks = tick;
+        m_headlessStats.wallSeconds = (freq > 0) ? (double)(end - start) / (double)freq : 0.0;
+        m_headlessStats.ticksPerSecond = (m_headlessStats.wallSeconds > 0.0)
+            ? (double)tick / m_headlessStats.wallSeconds
+            : 0.0;
+
+        spdlog::info("Headless run: {} ticks in {:.3f}s ({:.1f} ticks/s, {:.1f}x realtime)",
+            m_headlessStats.ticks,
+            m_headlessStats.wallSeconds,
+            m_headlessStats.ticksPerSecond,
+            m_headlessStats.ticksPerSecond * fixedDt);
+
+        m_recorder.Close();
+        app.OnShutdown(*this);
+        Shutdown();
+        return 0;
+    }
+
+    int Engine::RunReplay(const EngineConfig& config, App& app)
+    {
+        InputReplay replay;
+        if (!replay.Open(config.replayInputPath))
+            return 1;
+
+        // The recording's fixed dt wins over whatever the caller configured
+        EngineConfig replayConfig = config;
+        replayConfig.headless = true;
+        replayConfig.fixedDeltaSeconds = replay.FixedDt();
+        replayConfig.recordInputPath.clear();
+
+        if (!Initialize(replayConfig))
+            return 1;
+
+        if (!app.OnInit(*this))
+        {
+            spdlog::error("App OnInit failed.");
+            Shutdown();
+            return 2;
+        }
+
+        spdlog::info("Replaying '{}' (fixed dt {:.6f})", config.replayInputPath, replay.FixedDt());
+
+        m_replayResult = ReplayResult{};
+        const double fixedDt = replay.FixedDt();
+        const uint64_t freq = SDL_GetPerformanceFrequency();
+        const uint64_t start = SDL_GetPerformanceCounter();
+
+        bool inFrame = false;
+        double frameDt = 0.0;
+        uint64_t tick = 0;
+
+        InputRecord rec;
+        while (!m_quitRequested && !m_replayResult.diverged)
+        {
+            const bool more = replay.Next(rec);
+
+            // The next frame (or end of file) closes the current one with its variable update
+            if (inFrame && (!more || rec.kind == InputRecordKind::Frame))
+            {
+                MY2D_PROFILE_SCOPE("App::OnUpdate");
+                app.OnUpdate(*this, frameDt);
+                EndSceneFrame(app, false);
+                inFrame = false;
+            }
+
+            if (!more)
+                break;
+
+            switch (rec.kind)
+            {
+            case InputRecordKind::Frame:
+            {
+                MY2D_PROFILE_FRAME();
+                m_time.Advance(rec.dt);
+                m_frameArena.Reset();
+                AllocTracker::NewFrame();
+                m_input.BeginFrame();
+                frameDt = rec.dt;
+                inFrame = true;
+                ++m_replayResult.frames;
+
+                // Still honour SDL_QUIT (Ctrl+C); recorded events are the only input
+                SDL_Event e{};
+                while (SDL_PollEvent(&e))
+                {
+                    if (e.type == SDL_QUIT)
+                        RequestQuit();
+                }
+                break;
+            }
+
+            case InputRecordKind::Event:
+                if (!app.OnEvent(*this, rec.event))
+                    m_input.OnEvent(rec.event);
+                break;
+
+            case InputRecordKind::Tick:
+            {
+                {
+                    MY2D_PROFILE_SCOPE("Engine::FixedStep");
+                    m_tickArena.Reset();
+                    {
+                        MY2D_PROFILE_SCOPE("App::OnFixedUpdate");
+                        app.OnFixedUpdate(*this, fixedDt);
+                    }
+                    m_physics.Step((float)fixedDt);
+                    {
+                        MY2D_PROFILE_SCOPE("App::OnPostFixedUpdate");
+                        app.OnPostFixedUpdate(*this, fixedDt);
+                        FlushSceneCommands(*this, app);
+                    }
+                }
+
+                const uint64_t hash = HashAppState(app);
+                if (rec.tick != tick || rec.hash != hash)
+                {
+                    m_replayResult.diverged = true;
+                    m_replayResult.divergedTick = tick;
+                    m_replayResult.expectedHash = rec.hash;
+                    m_replayResult.actualHash = hash;
+                    spdlog::error("Replay diverged at tick {} (frame {}): expected {:016x}, got {:016x}",
+                        tick, m_replayResult.frames - 1, rec.hash, hash);
+                }
+                ++tick;
+                break;
+            }
+            }
+        }
+
+        const uint64_t end = SDL_GetPerformanceCounter();
+
+        m_replayResult.ticks = tick;
+        m_headlessStats.ticks = tick;
+        m_headlessStats.wallSeconds = (freq > 0) ? (double)(end - start) / (double)freq : 0.0;
+        m_headlessStats.ticksPerSecond = (m_headlessStats.wallSeconds > 0.0)
+            ? (double)tick / m_headlessStats.wallSeconds
+            : 0.0;
+
+        spdlog::info("Replay: {} frames, {} ticks in {:.3f}s ({:.1f} ticks/s){}",
+            m_replayResult.frames,
+            m_replayResult.ticks,
+            m_headlessStats.wallSeconds,
+            m_headlessStats.ticksPerSecond,
+            m_replayResult.diverged ? " - DIVERGED" : ", all hashes matched");
+
+        app.OnShutdown(*this);
+        Shutdown();
+        return m_replayResult.diverged ? 3 : 0;
+    }
+
     void Engine::RequestQuit()
     {
         m_quitRequested = true;
@@ -188,8 +829,10 @@ namespace my2d
 
     void Engine::ResetPhysicsWorld()
     {
+        const int subSteps = m_physics.SubSteps();
         m_physics.Shutdown();
-        m_physics.Initialize(m_gravity);
+        m_physics.Initialize(m_gravity, &m_jobs, m_physicsWorkers);
+        m_physics.SetSubSteps(subSteps);
     }
 
     // Accessors
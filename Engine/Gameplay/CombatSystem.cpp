@@ -6,6 +6,8 @@
 #include "Scene/Components.h"
 #include "Physics/PhysicsLayers.h"
 #include "Physics/PhysicsSystem.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <vector>
 #include <algorithm>
@@ -69,6 +71,9 @@ namespace my2d
 
     void Combat_PrePhysics(Engine& engine, Scene& scene, float fixedDt)
     {
+        MY2D_PROFILE_SCOPE("Combat_PrePhysics");
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         auto& reg = scene.Registry();
 
         // i-frames tick down
@@ -206,13 +211,14 @@ namespace my2d
 
     void Combat_PostPhysics(Engine& engine, Scene& scene, float /*fixedDt*/)
     {
+        MY2D_PROFILE_SCOPE("Combat_PostPhysics");
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         auto& reg = scene.Registry();
 
         b2WorldId worldId = engine.GetPhysics().WorldId();
         b2SensorEvents ev = b2World_GetSensorEvents(worldId);
 
-        std::vector<entt::entity> toKill;
-
         for (int i = 0; i < ev.beginCount; ++i)
         {
             const b2SensorBeginTouchEvent& begin = ev.beginEvents[i];
@@ -330,16 +336,9 @@ namespace my2d
 
             MarkHit(*rt, victim);
 
+            // Removed (with its body) at the next sync point, after all events are processed
             if (hp.hp <= 0)
-                toKill.push_back(victim);
-        }
-
-        // kill after processing events
-        for (auto e : toKill)
-        {
-            if (!reg.valid(e)) continue;
-            Physics_DestroyRuntimeForEntity(scene, e);
-            reg.destroy(e);
+                scene.QueueDestroy(victim);
         }
     }
 }
\ No newline at end of file
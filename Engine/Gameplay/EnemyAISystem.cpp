@@ -6,6 +6,8 @@
 #include "Scene/Entity.h"
 #include "Scene/Components.h"
 #include "Physics/PhysicsLayers.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <algorithm>
 #include <cmath>
@@ -24,6 +26,9 @@ namespace my2d
 
     void EnemyAI_FixedUpdate(Engine& engine, Scene& scene, float fixedDt, Entity player)
     {
+        MY2D_PROFILE_SCOPE("EnemyAI_FixedUpdate");
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         if (!player) return;
 
         auto& reg = scene.Registry();
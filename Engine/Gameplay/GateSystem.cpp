@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Gameplay/GateSystem.h"
+#include "Core/AllocTracker.h"
 
 #include "Core/Engine.h"
 #include "Scene/Scene.h"
@@ -84,11 +85,11 @@ namespace my2d
 
     void GateSystem_Update(Engine& engine, Scene& scene)
     {
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         auto& ws = engine.GetWorldState();
         auto& reg = scene.Registry();
 
-        std::vector<entt::entity> toDestroy;
-
         auto view = reg.view<GateComponent>();
         for (auto e : view)
         {
@@ -117,8 +118,7 @@ namespace my2d
             {
                 if (gate.openBehavior == GateOpenBehavior::DestroyEntity)
                 {
-                    Physics_DestroyRuntimeForEntity(scene, e);
-                    toDestroy.push_back(e);
+                    scene.QueueDestroy(e);
                     continue;
                 }
 
@@ -147,9 +147,6 @@ namespace my2d
             }
         }
 
-        for (auto e : toDestroy)
-            if (reg.valid(e)) reg.destroy(e);
-
         // Ensure newly-closed gates can get bodies immediately (useful after toggles)
         Physics_CreateRuntime(scene, engine.GetPhysics(), engine.PixelsPerMeter());
     }
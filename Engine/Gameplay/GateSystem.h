@@ -5,5 +5,6 @@ namespace my2d
     class Scene;
 
     // Re-evaluate all gates based on the current WorldState.
+    // DestroyEntity gates are queued on the scene's command buffer.
     void GateSystem_Update(Engine& engine, Scene& scene);
 }
\ No newline at end of file
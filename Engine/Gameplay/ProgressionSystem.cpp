@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Gameplay/ProgressionSystem.h"
+#include "Core/AllocTracker.h"
 #include "Scene/Components.h"
 #include "Physics/PhysicsSystem.h"
 #include "Gameplay/GateSystem.h"
@@ -10,11 +11,11 @@ namespace my2d
 {
     void Progression_ApplyPersistence(Engine& engine, Scene& scene)
     {
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         auto& ws = engine.GetWorldState();
         auto& reg = scene.Registry();
 
-        std::vector<entt::entity> toDestroy;
-
         // 1) Persistent entities removed if a flag exists
         {
             auto view = reg.view<PersistentFlagComponent>();
@@ -22,20 +23,15 @@ namespace my2d
             {
                 auto& pf = view.get<PersistentFlagComponent>(e);
                 if (!pf.flag.empty() && ws.HasFlag(pf.flag))
-                    toDestroy.push_back(e);
+                    scene.QueueDestroy(e);
             }
         }
-
-        for (auto e : toDestroy)
-        {
-            Physics_DestroyRuntimeForEntity(scene, e);
-            if (reg.valid(e))
-                reg.destroy(e);
-        }
     }
 
     void Progression_Update(Engine& engine, Scene& scene, Entity player)
     {
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         if (!player) return;
 
         auto& reg = scene.Registry();
@@ -45,9 +41,13 @@ namespace my2d
 
         bool grantedSomething = false;
 
+        // Pickup bounds include their radius, so only pickups in reach come back
         auto view = reg.view<TransformComponent, GrantProgressionComponent>();
-        for (auto e : view)
+        for (auto e : scene.QueryAABB(playerT.position, playerT.position))
         {
+            if (!view.contains(e))
+                continue;
+
             auto& t = view.get<TransformComponent>(e);
             auto& g = view.get<GrantProgressionComponent>(e);
 
@@ -61,9 +61,8 @@ namespace my2d
             if (g.unlockAbility)
                 engine.GetWorldState().UnlockAbility(g.ability);
 
-            reg.destroy(e);
+            scene.QueueDestroy(e);
             grantedSomething = true;
-            break;
         }
 
         if (grantedSomething)
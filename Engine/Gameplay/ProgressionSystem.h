@@ -5,7 +5,8 @@
 
 namespace my2d
 {
-	// Call once after you build/load a scene
+	// Call once after you build/load a scene. Collected entities are queued on scene.Commands()
+	// (gone after the next FlushCommands).
 	void Progression_ApplyPersistence(Engine& engine, Scene& scene);
 
 	// Call every update (or fixed update). Uses simple distance check vs player.
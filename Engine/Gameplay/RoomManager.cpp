@@ -1,5 +1,6 @@
 #include "pch.h"
 #include "Gameplay/RoomManager.h"
+#include "Core/AllocTracker.h"
 
 #include "Core/Engine.h"
 #include "Scene/SceneSerializer.h"
@@ -12,6 +13,7 @@
 #include "Physics/PhysicsSystem.h"
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <spdlog/spdlog.h>
 
@@ -42,16 +44,9 @@ namespace my2d
     Entity RoomManager::FindSpawn(const std::string& name)
     {
         if (!m_scene) return {};
-        auto& reg = m_scene->Registry();
 
-        auto view = reg.view<TransformComponent, PlayerSpawnComponent>();
-        for (auto e : view)
-        {
-            auto& sp = view.get<PlayerSpawnComponent>(e);
-            if (sp.name == name)
-                return Entity(e, m_scene.get());
-        }
-        return {};
+        Entity sp = m_scene->FindSpawn(StringId(name));
+        return (sp && sp.Has<TransformComponent>()) ? sp : Entity{};
     }
 
     void RoomManager::PlacePlayerAtSpawn(Engine& engine, const std::string& spawnName)
@@ -68,6 +63,7 @@ namespace my2d
         {
             m_player.Get<TransformComponent>().position = sp.Get<TransformComponent>().position;
         }
+        m_scene->MarkTransformChanged(m_player.Handle());
 
         // Force physics body recreation at the new position
         if (m_player.Has<RigidBody2DComponent>())
@@ -102,24 +98,27 @@ namespace my2d
 
     bool RoomManager::LoadRoom(Engine& engine, std::string sceneRelPath, std::string spawnName)
     {
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         const std::string fullPath = ResolveScenePath(engine, sceneRelPath);
 
         engine.ResetPhysicsWorld();
 
         m_scene = std::make_unique<Scene>();
-        if (!SceneSerializer::LoadFromFile(*m_scene, fullPath))
+        if (!SceneSerializer::LoadFromFile(*m_scene, fullPath, &engine.GetAssets(), &engine.GetJobs()))
         {
             spdlog::error("Failed to load scene '{}'", fullPath);
             m_scene.reset();
             return false;
         }
 
-        // Apply global state
+        // Apply global state (collected/opened entities go before any bodies are built)
         Progression_ApplyPersistence(engine, *m_scene);
         GateSystem_Update(engine, *m_scene);
+        m_scene->FlushCommands();
 
         // Build tile colliders + runtime bodies
-        BuildTilemapColliders(engine.GetPhysics(), *m_scene, engine.PixelsPerMeter());
+        BuildTilemapColliders(engine.GetPhysics(), *m_scene, engine.PixelsPerMeter(), &engine.GetFrameArena());
         Physics_CreateRuntime(*m_scene, engine.GetPhysics(), engine.PixelsPerMeter());
 
         // Find existing player in scene or spawn a default one
@@ -127,11 +126,12 @@ namespace my2d
             auto& reg = m_scene->Registry();
             Entity foundPlayer{};
 
-            auto view = reg.view<TagComponent, TransformComponent, RigidBody2DComponent, BoxCollider2DComponent, PlatformerControllerComponent>();
-            for (auto e : view)
+            static const StringId s_playerTag("Player");
+            std::vector<entt::entity> tagged;
+            m_scene->FindEntitiesByTag(s_playerTag, tagged);
+            for (auto e : tagged)
             {
-                auto& tag = view.get<TagComponent>(e);
-                if (tag.tag == "Player")
+                if (reg.all_of<TransformComponent, RigidBody2DComponent, BoxCollider2DComponent, PlatformerControllerComponent>(e))
                 {
                     foundPlayer = Entity(e, m_scene.get());
                     break;
@@ -214,8 +214,66 @@ namespace my2d
         return true;
     }
 
+    static double MsSince(std::chrono::steady_clock::time_point t0)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    void RoomManager::SaveCheckpoint()
+    {
+        MY2D_ALLOC_SCOPE(Gameplay);
+
+        if (!m_scene) return;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        m_checkpoint.Capture(*m_scene);
+
+        m_checkpointRoom = m_currentRoom;
+        m_checkpointPlayerId = (m_player && m_player.Has<IdComponent>()) ? m_player.Get<IdComponent>().id : 0;
+
+        spdlog::info("Checkpoint: {} entities, {} bodies, {} bytes in {:.3f} ms",
+            m_checkpoint.EntityCount(), m_checkpoint.BodyCount(), m_checkpoint.SizeBytes(), MsSince(t0));
+    }
+
+    bool RoomManager::RestoreCheckpoint(Engine& engine)
+    {
+        MY2D_ALLOC_SCOPE(Gameplay);
+
+        if (m_checkpoint.Empty()) return false;
+
+        const auto t0 = std::chrono::steady_clock::now();
+
+        // Current room stays up if the restore fails
+        auto scene = std::make_unique<Scene>();
+        if (!m_checkpoint.Restore(*scene))
+        {
+            spdlog::error("Failed to restore checkpoint of '{}'", m_checkpointRoom);
+            return false;
+        }
+
+        // Same teardown as LoadRoom; the snapshot already has persistence/gates applied
+        engine.ResetPhysicsWorld();
+        m_scene = std::move(scene);
+
+        BuildTilemapColliders(engine.GetPhysics(), *m_scene, engine.PixelsPerMeter(), &engine.GetFrameArena());
+        Physics_CreateRuntime(*m_scene, engine.GetPhysics(), engine.PixelsPerMeter());
+        m_checkpoint.ApplyBodyStates(*m_scene);
+
+        m_player = m_scene->FindEntityById(m_checkpointPlayerId);
+        if (!m_player)
+            spdlog::warn("Checkpoint of '{}' has no player", m_checkpointRoom);
+
+        m_currentRoom = m_checkpointRoom;
+        m_transitionLock = 0.2f;
+
+        spdlog::info("Restored checkpoint of '{}' in {:.3f} ms", m_currentRoom, MsSince(t0));
+        return true;
+    }
+
     void RoomManager::Update(Engine& engine, float dt)
     {
+        MY2D_ALLOC_SCOPE(Gameplay);
+
         if (!m_scene || !m_player) return;
 
         m_transitionLock = std::max(0.0f, m_transitionLock - dt);
@@ -234,12 +292,24 @@ namespace my2d
         auto view = reg.view<TransformComponent, DoorComponent>();
         for (auto e : view)
         {
-            auto& doorT = view.get<TransformComponent>(e);
             auto& door = view.get<DoorComponent>(e);
-
             door.cooldownTimer = std::max(0.0f, door.cooldownTimer - dt);
+        }
+
+        if (m_transitionLock > 0.0f)
+            return;
+
+        // Only doors whose trigger touches the player box
+        const glm::vec2 pSize = playerBox ? playerBox->size : glm::vec2{ 32.0f, 64.0f };
+        for (auto e : m_scene->QueryAABB(playerT.position, playerT.position + pSize))
+        {
+            if (!view.contains(e))
+                continue;
+
+            auto& doorT = view.get<TransformComponent>(e);
+            auto& door = view.get<DoorComponent>(e);
 
-            if (m_transitionLock > 0.0f || door.cooldownTimer > 0.0f)
+            if (door.cooldownTimer > 0.0f)
                 continue;
 
             if (!PlayerOverlapsDoor(playerT, playerBox, doorT, door))
@@ -4,6 +4,7 @@
 
 #include "Scene/Scene.h"
 #include "Scene/Entity.h"
+#include "Scene/SceneSnapshot.h"
 
 namespace my2d
 {
@@ -24,6 +25,13 @@ namespace my2d
         // If you want game code to spawn player differently later:
         void SetPlayer(Entity e) { m_player = e; }
 
+        // In-memory checkpoint of the current room (entities, runtime state, body positions/velocities).
+        // RestoreCheckpoint rebuilds that room from it without touching disk; false if there is none.
+        void SaveCheckpoint();
+        bool RestoreCheckpoint(Engine& engine);
+        bool HasCheckpoint() const { return !m_checkpoint.Empty(); }
+        void ClearCheckpoint() { m_checkpoint.Clear(); }
+
     private:
         std::string ResolveScenePath(const Engine& engine, const std::string& rel) const;
 
@@ -38,5 +46,9 @@ namespace my2d
         std::string m_currentRoom;
 
         float m_transitionLock = 0.0f;
+
+        SceneSnapshot m_checkpoint;
+        std::string m_checkpointRoom;
+        uint64_t m_checkpointPlayerId = 0;
     };
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "Physics/PhysicsSystem.h"
 #include "Scene/Components.h"
 #include "Physics/PhysicsLayers.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <algorithm>
 
@@ -23,17 +25,14 @@ namespace my2d
 
     void Physics_CreateRuntime(Scene& scene, PhysicsWorld& physics, float ppm)
     {
+        MY2D_ALLOC_SCOPE(Physics);
+
         if (!physics.IsValid()) return;
 
         auto& reg = scene.Registry();
-        auto view = reg.view<TransformComponent, RigidBody2DComponent, BoxCollider2DComponent>();
 
-        for (auto e : view)
+        for (auto [e, local, rb, bc] : scene.PhysicsGroup().each())
         {
-            auto& tc = view.get<TransformComponent>(e);
-            auto& rb = view.get<RigidBody2DComponent>(e);
-            auto& bc = view.get<BoxCollider2DComponent>(e);
-
             if (!rb.enabled || !bc.enabled)
             {
                 // If something disabled this collider (gate open), ensure runtime is gone.
@@ -48,6 +47,9 @@ namespace my2d
             if (b2Body_IsValid(rb.bodyId))
                 continue;
 
+            // Bodies on child entities start at the cached world transform (Physics_SyncChildBodies keeps them there)
+            const TransformComponent& tc = WorldTransformOf(reg, e, local);
+
             // Treat Transform.position as TOP-LEFT in pixels.
             // Box2D body position is the body origin (we'll use center of collider).
             const glm::vec2 half = bc.size * 0.5f;
@@ -66,6 +68,7 @@ namespace my2d
             bd.angularDamping = rb.angularDamping;
 
             rb.bodyId = b2CreateBody(physics.WorldId(), &bd);
+            rb.hasPrevTransform = false; // new or teleported body: don't blend from the old spot
             b2Body_SetUserData(rb.bodyId, (void*)(uintptr_t)(uint32_t)e);
 
             b2ShapeDef sd = b2DefaultShapeDef();
@@ -86,38 +89,118 @@ namespace my2d
         }
     }
 
-    void Physics_SyncTransforms(Scene& scene, float ppm)
+    void Physics_SyncChildBodies(Scene& scene, PhysicsWorld& physics, float ppm)
+    {
+        MY2D_PROFILE_SCOPE("Physics_SyncChildBodies");
+
+        std::vector<entt::entity>& moved = scene.MovedChildBodies();
+        if (!physics.IsValid())
+        {
+            moved.clear();
+            return;
+        }
+
+        auto& reg = scene.Registry();
+        for (entt::entity e : moved)
+        {
+            if (!reg.valid(e))
+                continue;
+
+            // Roots again (ClearParent) are simulated, not carried
+            const auto* wt = reg.try_get<WorldTransformComponent>(e);
+            const auto* rb = reg.try_get<RigidBody2DComponent>(e);
+            const auto* bc = reg.try_get<BoxCollider2DComponent>(e);
+            if (!wt || !rb || !bc || !b2Body_IsValid(rb->bodyId))
+                continue;
+
+            const glm::vec2 centerPx = wt->world.position + bc->offset + bc->size * 0.5f;
+            const b2Vec2 pos{ centerPx.x / ppm, centerPx.y / ppm };
+            const b2Rot rot = b2MakeRot(DegToRad(wt->world.rotationDeg));
+
+            const b2Vec2 cur = b2Body_GetPosition(rb->bodyId);
+            const b2Rot curRot = b2Body_GetRotation(rb->bodyId);
+            if (cur.x != pos.x || cur.y != pos.y || curRot.c != rot.c || curRot.s != rot.s)
+                b2Body_SetTransform(rb->bodyId, pos, rot);
+        }
+        moved.clear();
+    }
+
+    void Physics_SyncTransforms(Scene& scene, PhysicsWorld& physics, float ppm)
     {
+        MY2D_PROFILE_SCOPE("Physics_SyncTransforms");
+        MY2D_ALLOC_SCOPE(Physics);
+
+        if (!physics.IsValid()) return;
+
         auto& reg = scene.Registry();
-        auto view = reg.view<TransformComponent, RigidBody2DComponent, BoxCollider2DComponent>();
 
-        for (auto e : view)
+        // Box2D reports every awake body after the step (sleeping/static bodies aren't in the list),
+        // so only those transforms get written and flagged
+        const b2BodyEvents events = b2World_GetBodyEvents(physics.WorldId());
+
+        for (int i = 0; i < events.moveCount; ++i)
         {
-            auto& tc = view.get<TransformComponent>(e);
-            auto& rb = view.get<RigidBody2DComponent>(e);
-            auto& bc = view.get<BoxCollider2DComponent>(e);
+            const b2BodyMoveEvent& move = events.moveEvents[i];
 
-            if (!rb.enabled || !bc.enabled)
+            const entt::entity e = (entt::entity)(uint32_t)(uintptr_t)move.userData;
+            if (!reg.valid(e))
                 continue;
 
-            if (!b2Body_IsValid(rb.bodyId))
+            auto* tc = reg.try_get<TransformComponent>(e);
+            auto* rb = reg.try_get<RigidBody2DComponent>(e);
+            auto* bc = reg.try_get<BoxCollider2DComponent>(e);
+            if (!tc || !rb || !bc)
                 continue;
 
-            const b2Vec2 pos = b2Body_GetPosition(rb.bodyId);
-            const b2Rot rot = b2Body_GetRotation(rb.bodyId);
+            // Bodies without an entity (tilemap colliders, stale ids) share userData 0
+            if (!B2_ID_EQUALS(rb->bodyId, move.bodyId))
+                continue;
 
-            // Convert body center back to TOP-LEFT pixels
-            const glm::vec2 centerPx{ pos.x * ppm, pos.y * ppm };
-            const glm::vec2 half = bc.size * 0.5f;
+            // Child bodies: the hierarchy owns their transform
+            if (reg.all_of<WorldTransformComponent>(e))
+                continue;
 
-            tc.position = centerPx - bc.offset - half;
+            // Convert body center back to TOP-LEFT pixels
+            const glm::vec2 centerPx{ move.transform.p.x * ppm, move.transform.p.y * ppm };
+            const glm::vec2 half = bc->size * 0.5f;
 
             // Rotation (optional if fixedRotation is true, but harmless)
-            const float angleRad = std::atan2(rot.s, rot.c);
-            tc.rotationDeg = RadToDeg(angleRad);
+            const float angleRad = std::atan2(move.transform.q.s, move.transform.q.c);
+
+            const glm::vec2 newPos = centerPx - bc->offset - half;
+            const float newRot = RadToDeg(angleRad);
+
+            // First sync after the body was created: nothing to blend from yet.
+            // Falling asleep is the last event until it wakes, so settle there instead of blending forever.
+            const bool settle = !rb->hasPrevTransform || move.fellAsleep;
+            rb->prevPosition = settle ? newPos : tc->position;
+            rb->prevRotationDeg = settle ? newRot : tc->rotationDeg;
+            rb->hasPrevTransform = true;
+
+            if (newPos != tc->position || newRot != tc->rotationDeg)
+                scene.MarkTransformChanged(e);
+
+            tc->position = newPos;
+            tc->rotationDeg = newRot;
         }
     }
 
+    TransformComponent Physics_InterpolatedTransform(const TransformComponent& tc, const RigidBody2DComponent* rb, float alpha)
+    {
+        if (!rb || !rb->hasPrevTransform || !b2Body_IsValid(rb->bodyId))
+            return tc;
+
+        alpha = std::clamp(alpha, 0.0f, 1.0f);
+
+        TransformComponent out = tc;
+        out.position = rb->prevPosition + (tc.position - rb->prevPosition) * alpha;
+
+        // Shortest way round so 179 -> -179 doesn't spin the long way
+        float delta = std::fmod(tc.rotationDeg - rb->prevRotationDeg + 540.0f, 360.0f) - 180.0f;
+        out.rotationDeg = rb->prevRotationDeg + delta * alpha;
+        return out;
+    }
+
     void Physics_DestroyRuntimeForEntity(Scene& scene, entt::entity e)
     {
         auto& reg = scene.Registry();
@@ -138,4 +221,28 @@ namespace my2d
             bc.shapeId = b2_nullShapeId;
         }
     }
+
+    void Physics_DestroyRuntimeForEntities(Scene& scene, const entt::entity* entities, size_t count)
+    {
+        MY2D_PROFILE_SCOPE("Physics_DestroyRuntimeForEntities");
+
+        auto& reg = scene.Registry();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const entt::entity e = entities[i];
+            if (!reg.valid(e))
+                continue;
+
+            // Destroying the body takes its shapes (collider, attack hitbox) with it
+            if (auto* rb = reg.try_get<RigidBody2DComponent>(e))
+            {
+                if (b2Body_IsValid(rb->bodyId))
+                    b2DestroyBody(rb->bodyId);
+                rb->bodyId = b2_nullBodyId;
+            }
+
+            if (auto* bc = reg.try_get<BoxCollider2DComponent>(e))
+                bc->shapeId = b2_nullShapeId;
+        }
+    }
 }
\ No newline at end of file
@@ -9,7 +9,22 @@ namespace my2d
 	void Physics_CreateRuntime(Scene& scene, PhysicsWorld& physics, float pixelsPerMeter);
 
 	// Pull body transforms back into TransformComponent for rendering
-	void Physics_SyncTransforms(Scene& scene, float pixelsPerMeter);
+	// (the old value is kept in RigidBody2DComponent::prevPosition/prevRotationDeg).
+	// Driven by the step's body move events: only awake bodies are touched, and the ones that
+	// moved are flagged through Scene::MarkTransformChanged. Call once right after each world step.
+	void Physics_SyncTransforms(Scene& scene, PhysicsWorld& physics, float pixelsPerMeter);
+
+	// Bodies on child entities are carried by the hierarchy, not simulated (make them kinematic or static):
+	// moves the ones whose world transform was rewritten since the last call (Scene::MovedChildBodies) to it.
+	// The Engine calls it at its sync points, right after Scene::UpdateWorldTransforms.
+	void Physics_SyncChildBodies(Scene& scene, PhysicsWorld& physics, float pixelsPerMeter);
+
+	// Transform blended between the last two fixed steps. alpha = leftover accumulator / fixedDt.
+	// Entities without a previous step (new/teleported bodies, no rigidbody) draw at their current transform.
+	TransformComponent Physics_InterpolatedTransform(const TransformComponent& tc, const RigidBody2DComponent* rb, float alpha);
 
 	void Physics_DestroyRuntimeForEntity(Scene& scene, entt::entity e);
+
+	// Batch version for the scene's deferred destroys: every body released in one pass
+	void Physics_DestroyRuntimeForEntities(Scene& scene, const entt::entity* entities, size_t count);
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "pch.h"
+#include "Physics/PhysicsWorld.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace my2d
+{
+    void PhysicsWorld::Initialize(b2Vec2 gravity, JobSystem* jobs, uint32_t workerCount)
+    {
+        b2WorldDef def = b2DefaultWorldDef();
+        def.gravity = gravity;
+
+        m_jobs = jobs;
+        m_workerCount = 1;
+        if (m_jobs && workerCount > 1)
+            m_workerCount = std::min<uint32_t>({ workerCount, m_jobs->ThreadCount(), 64u });
+
+        if (m_workerCount > 1)
+        {
+            def.workerCount = (int)m_workerCount;
+            def.enqueueTask = &PhysicsWorld::EnqueueTask;
+            def.finishTask = &PhysicsWorld::FinishTask;
+            def.userTaskContext = this;
+        }
+
+        m_freeSlots.store((m_workerCount >= 64) ? ~0ull : ((1ull << m_workerCount) - 1ull));
+        m_taskCount = 0;
+
+        m_worldId = b2CreateWorld(&def);
+    }
+
+    void PhysicsWorld::Shutdown()
+    {
+        if (b2World_IsValid(m_worldId))
+        {
+            b2DestroyWorld(m_worldId);
+            m_worldId = b2_nullWorldId;
+        }
+    }
+
+    void PhysicsWorld::Step(float fixedDt)
+    {
+        if (!IsValid()) return;
+        MY2D_PROFILE_SCOPE("PhysicsWorld::Step");
+        MY2D_ALLOC_SCOPE(Physics);
+
+        // Every task is finished before b2World_Step returns
+        m_taskCount = 0;
+        b2World_Step(m_worldId, fixedDt, m_subSteps);
+    }
+
+    uint32_t PhysicsWorld::AcquireSlot()
+    {
+        for (;;)
+        {
+            uint64_t free = m_freeSlots.load(std::memory_order_acquire);
+            while (free != 0)
+            {
+                const uint32_t slot = (uint32_t)std::countr_zero(free);
+                if (m_freeSlots.compare_exchange_weak(free, free & ~(1ull << slot), std::memory_order_acq_rel))
+                    return slot;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void PhysicsWorld::ReleaseSlot(uint32_t slot)
+    {
+        m_freeSlots.fetch_or(1ull << slot, std::memory_order_release);
+    }
+
+    void* PhysicsWorld::EnqueueTask(b2TaskCallback* task, int itemCount, int minRange, void* taskContext, void* userContext)
+    {
+        PhysicsWorld* self = static_cast<PhysicsWorld*>(userContext);
+
+        // Out of task records: run it here, returning null tells Box2D there is nothing to finish
+        if (self->m_taskCount >= MaxTasks)
+        {
+            const uint32_t slot = self->AcquireSlot();
+            task(0, itemCount, slot, taskContext);
+            self->ReleaseSlot(slot);
+            return nullptr;
+        }
+
+        Task& t = self->m_tasks[self->m_taskCount++];
+
+        // At most one chunk per worker, so running chunks never outnumber slots
+        const int workers = (int)self->m_workerCount;
+        const int chunk = std::max(std::max(1, minRange), (itemCount + workers - 1) / workers);
+
+        for (int begin = 0; begin < itemCount; begin += chunk)
+        {
+            const int end = std::min(itemCount, begin + chunk);
+            self->m_jobs->Submit([self, task, taskContext, begin, end]()
+                {
+                    const uint32_t slot = self->AcquireSlot();
+                    task(begin, end, slot, taskContext);
+                    self->ReleaseSlot(slot);
+                }, &t.counter);
+        }
+
+        return &t;
+    }
+
+    void PhysicsWorld::FinishTask(void* userTask, void* userContext)
+    {
+        PhysicsWorld* self = static_cast<PhysicsWorld*>(userContext);
+        Task* t = static_cast<Task*>(userTask);
+        self->m_jobs->Wait(t->counter);
+    }
+}
@@ -1,38 +1,59 @@
 #pragma once
 #include "Physics/Box2D.h"
+#include "Core/JobSystem.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
 
 namespace my2d
 {
     class PhysicsWorld
     {
     public:
-        void Initialize(b2Vec2 gravity)
-        {
-            b2WorldDef def = b2DefaultWorldDef();
-            def.gravity = gravity;
-            m_worldId = b2CreateWorld(&def);
-        }
-
-        void Shutdown()
-        {
-            if (b2World_IsValid(m_worldId))
-            {
-                b2DestroyWorld(m_worldId);
-                m_worldId = b2_nullWorldId;
-            }
-        }
+        // jobs == nullptr or workerCount <= 1 => Box2D steps on the calling thread.
+        // workerCount is clamped to jobs->ThreadCount(): Box2D's solver stages expect every worker task to run at once.
+        void Initialize(b2Vec2 gravity, JobSystem* jobs = nullptr, uint32_t workerCount = 1);
+        void Shutdown();
 
         bool IsValid() const { return b2World_IsValid(m_worldId); }
 
-        void Step(float fixedDt, int subSteps = 1)
-        {
-            if (!IsValid()) return;
-            b2World_Step(m_worldId, fixedDt, subSteps);
-        }
+        void SetSubSteps(int subSteps) { m_subSteps = (subSteps < 1) ? 1 : subSteps; }
+        int SubSteps() const { return m_subSteps; }
+        uint32_t WorkerCount() const { return m_workerCount; }
+
+        // Call from the JobSystem's owner thread: the simulation thread (main thread in Engine::Run, the
+        // simulation thread in pipelined mode).
+        void Step(float fixedDt);
 
         b2WorldId WorldId() const { return m_worldId; }
 
+    private:
+        // Box2D never has more than a handful of tasks in flight per step; past this we run inline.
+        static constexpr uint32_t MaxTasks = 64;
+
+        struct Task
+        {
+            JobCounter counter;
+        };
+
+        static void* EnqueueTask(b2TaskCallback* task, int itemCount, int minRange, void* taskContext, void* userContext);
+        static void FinishTask(void* userTask, void* userContext);
+
+        // Box2D wants a worker index in [0, workerCount) that is unique among running tasks.
+        // Job thread indices don't fit that once workerCount < thread count, so tasks borrow a slot.
+        uint32_t AcquireSlot();
+        void ReleaseSlot(uint32_t slot);
+
     private:
         b2WorldId m_worldId = b2_nullWorldId;
+
+        JobSystem* m_jobs = nullptr;
+        uint32_t m_workerCount = 1;
+        int m_subSteps = 1;
+
+        std::array<Task, MaxTasks> m_tasks;
+        uint32_t m_taskCount = 0;
+        std::atomic<uint64_t> m_freeSlots{ 0 };
     };
-}
\ No newline at end of file
+}
@@ -4,6 +4,8 @@
 #include "Physics/PhysicsLayers.h"
 #include "Physics/PhysicsSystem.h"
 #include "Scene/Components.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <algorithm>
 #include <cmath>
@@ -102,6 +104,9 @@ namespace my2d
 
     void PlatformerController_FixedUpdate(Engine& engine, Scene& scene, float fixedDt)
     {
+        MY2D_PROFILE_SCOPE("PlatformerController_FixedUpdate");
+        MY2D_ALLOC_SCOPE(Physics);
+
         // Ensure runtime bodies exist (safe to call every tick)
         Physics_CreateRuntime(scene, engine.GetPhysics(), engine.PixelsPerMeter());
 
@@ -2,6 +2,8 @@
 #include "Physics/TilemapColliderBuilder.h"
 #include "Scene/Components.h"
 #include "Physics/PhysicsLayers.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <vector>
 #include <algorithm>
@@ -28,13 +30,14 @@ namespace my2d
         return true;
     }
 
-    static std::vector<RectI> MergeSolidsGreedy(const TilemapComponent& tm, const TileLayer& layer, const TilemapColliderComponent& col)
+    static ArenaVector<RectI> MergeSolidsGreedy(const TilemapComponent& tm, const TileLayer& layer, const TilemapColliderComponent& col, LinearArena* scratch)
     {
         const int W = tm.width;
         const int H = tm.height;
 
-        std::vector<uint8_t> used((size_t)W * (size_t)H, 0);
-        std::vector<RectI> rects;
+        ArenaVector<uint8_t> used((size_t)W * (size_t)H, 0, ArenaAllocator<uint8_t>(scratch));
+        ArenaVector<RectI> rects{ ArenaAllocator<RectI>(scratch) };
+        rects.reserve((size_t)H * 4);
 
         auto inBounds = [&](int x, int y) { return x >= 0 && y >= 0 && x < W && y < H; };
         auto idxOf = [&](int x, int y) { return y * W + x; };
@@ -86,8 +89,11 @@ namespace my2d
         return rects;
     }
 
-    void BuildTilemapColliders(PhysicsWorld& physics, Scene& scene, float ppm)
+    void BuildTilemapColliders(PhysicsWorld& physics, Scene& scene, float ppm, LinearArena* scratch)
     {
+        MY2D_PROFILE_SCOPE("BuildTilemapColliders");
+        MY2D_ALLOC_SCOPE(Physics);
+
         if (!physics.IsValid()) return;
 
         auto& reg = scene.Registry();
@@ -170,7 +176,7 @@ namespace my2d
                 }
             }
 
-            const auto rects = MergeSolidsGreedy(tm, layer, col);
+            const auto rects = MergeSolidsGreedy(tm, layer, col, scratch);
 
             for (const auto& r : rects)
             {
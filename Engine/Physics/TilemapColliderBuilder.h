@@ -1,10 +1,12 @@
 #pragma once
 #include "Physics/Box2D.h"
 #include "Scene/Scene.h"
+#include "Core/LinearArena.h"
 
 namespace my2d
 {
 	// Builds/refreshes static colliders for every entity that has:
 	// TransformComponent + TilemapComponent + TilemapColliderComponent
-	void BuildTilemapColliders(PhysicsWorld& physics, Scene& scene, float pixelsPerMeter);
+	// scratch (optional) holds the greedy-merge temporaries, e.g. Engine::GetFrameArena().
+	void BuildTilemapColliders(PhysicsWorld& physics, Scene& scene, float pixelsPerMeter, LinearArena* scratch = nullptr);
 }
\ No newline at end of file
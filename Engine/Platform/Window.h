@@ -56,10 +56,18 @@ namespace my2d::Platform
         {
             if (e.type == SDL_WINDOWEVENT)
             {
-                if (e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                switch (e.window.event)
                 {
+                case SDL_WINDOWEVENT_SIZE_CHANGED:
                     m_width = e.window.data1;
                     m_height = e.window.data2;
+                    break;
+                case SDL_WINDOWEVENT_FOCUS_GAINED: m_focused = true; break;
+                case SDL_WINDOWEVENT_FOCUS_LOST: m_focused = false; break;
+                case SDL_WINDOWEVENT_MINIMIZED: m_minimized = true; break;
+                case SDL_WINDOWEVENT_RESTORED:
+                case SDL_WINDOWEVENT_MAXIMIZED: m_minimized = false; break;
+                default: break;
                 }
             }
         }
@@ -80,11 +88,15 @@ namespace my2d::Platform
 
         int Width() const { return m_width; }
         int Height() const { return m_height; }
+        bool IsFocused() const { return m_focused; }
+        bool IsMinimized() const { return m_minimized; }
 
     private:
         SDL_Window* m_window = nullptr;
         SDL_Renderer* m_renderer = nullptr;
         int m_width = 0;
         int m_height = 0;
+        bool m_focused = true;
+        bool m_minimized = false;
     };
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "Scene/Components.h"
 #include "Renderer/AnimationSet.h"
 #include "Renderer/SpriteAtlas.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <cmath>
 
@@ -13,6 +15,9 @@ namespace my2d
 {
     void AnimationSystem_Update(Engine& engine, Scene& scene, float dt)
     {
+        MY2D_PROFILE_SCOPE("AnimationSystem_Update");
+        MY2D_ALLOC_SCOPE(Renderer);
+
         auto& reg = scene.Registry();
 
         auto view = reg.view<SpriteRendererComponent, AnimatorComponent>();
@@ -47,9 +52,14 @@ namespace my2d
 
             an.frameIndex = idx;
 
-            // write sprite selection
-            spr.atlasPath = set->AtlasPath();
-            spr.regionName = clip->frames[idx];
+            // write sprite selection (only on change: the copy reallocates whenever the new name is longer)
+            if (spr.atlasPath != set->AtlasPath())
+            {
+                spr.atlasPath = set->AtlasPath();
+                scene.MarkSpriteChanged(e); // the atlas is the texture in the draw order key
+            }
+            if (spr.regionName != clip->frames[idx])
+                spr.regionName = clip->frames[idx];
         }
     }
 }
\ No newline at end of file
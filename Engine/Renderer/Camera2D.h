@@ -21,6 +21,14 @@ namespace my2d
             return (world - m_position) * m_zoom + half;
         }
 
+        // World-space rectangle covered by the viewport
+        void WorldBounds(glm::vec2& outMin, glm::vec2& outMax) const
+        {
+            const glm::vec2 half = { m_viewW * 0.5f / m_zoom, m_viewH * 0.5f / m_zoom };
+            outMin = m_position - half;
+            outMax = m_position + half;
+        }
+
     private:
         glm::vec2 m_position{ 0.0f, 0.0f }; // world position at screen center
         float m_zoom = 1.0f;
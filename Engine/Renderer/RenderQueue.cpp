@@ -0,0 +1,198 @@
+#include "pch.h"
+#include "Renderer/RenderQueue.h"
+#include "Scene/Components.h"
+#include "Core/StringId.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+
+namespace my2d
+{
+    // [63..48] layer (biased int16) | [47] 0 = tiles, 1 = sprite | [46..32] texture hash | [31..0] order
+    static uint64_t MakeKey(int layer, bool sprite, const std::string& texture, uint32_t order)
+    {
+        const uint64_t layerBits = (uint64_t)(std::clamp(layer, -32768, 32767) + 32768);
+        const uint64_t textureBits = (StringId::Hash(texture) >> 49) & 0x7FFFu;
+        return (layerBits << 48) | ((sprite ? 1ull : 0ull) << 47) | (textureBits << 32) | order;
+    }
+
+    void RenderQueue::Connect(entt::registry& reg)
+    {
+        reg.on_construct<SpriteRendererComponent>().connect<&RenderQueue::OnChanged>(*this);
+        reg.on_update<SpriteRendererComponent>().connect<&RenderQueue::OnChanged>(*this);
+        reg.on_destroy<SpriteRendererComponent>().connect<&RenderQueue::OnRemoved>(*this);
+
+        reg.on_construct<TilemapComponent>().connect<&RenderQueue::OnChanged>(*this);
+        reg.on_update<TilemapComponent>().connect<&RenderQueue::OnChanged>(*this);
+        reg.on_destroy<TilemapComponent>().connect<&RenderQueue::OnRemoved>(*this);
+
+        m_rebuild = true;
+    }
+
+    void RenderQueue::Disconnect(entt::registry& reg)
+    {
+        reg.on_construct<SpriteRendererComponent>().disconnect(*this);
+        reg.on_update<SpriteRendererComponent>().disconnect(*this);
+        reg.on_destroy<SpriteRendererComponent>().disconnect(*this);
+
+        reg.on_construct<TilemapComponent>().disconnect(*this);
+        reg.on_update<TilemapComponent>().disconnect(*this);
+        reg.on_destroy<TilemapComponent>().disconnect(*this);
+    }
+
+    void RenderQueue::OnChanged(entt::registry& reg, entt::entity e)
+    {
+        (void)reg;
+        MarkChanged(e);
+    }
+
+    void RenderQueue::MarkChanged(entt::entity e)
+    {
+        if (m_rebuild) return;
+
+        // Marked by handle: a recycled index (new version) still gets its own entry
+        const size_t index = (size_t)entt::to_entity(e);
+        if (index >= m_changedMark.size())
+            m_changedMark.resize(index + 1, entt::null);
+
+        if (m_changedMark[index] == e)
+            return;
+
+        m_changedMark[index] = e;
+        m_changed.push_back(e);
+    }
+
+    void RenderQueue::OnRemoved(entt::registry& reg, entt::entity e)
+    {
+        // Same bookkeeping: Update drops the old items and re-adds whatever the entity still draws
+        OnChanged(reg, e);
+    }
+
+    void RenderQueue::AddItems(entt::registry& reg, entt::entity e, std::vector<Item>& out)
+    {
+        if (!reg.valid(e))
+            return;
+
+        if (const auto* tm = reg.try_get<TilemapComponent>(e))
+        {
+            const size_t count = std::min<size_t>(tm->layers.size(), SpriteItem);
+            for (size_t i = 0; i < count; ++i)
+            {
+                Item item;
+                item.entity = e;
+                item.tileLayer = (uint16_t)i;
+                item.key = MakeKey(tm->layers[i].layer, false, tm->tileset.texturePath, m_nextOrder++);
+                out.push_back(item);
+            }
+        }
+
+        if (const auto* sc = reg.try_get<SpriteRendererComponent>(e))
+        {
+            Item item;
+            item.entity = e;
+            item.key = MakeKey(sc->layer, true, sc->atlasPath.empty() ? sc->texturePath : sc->atlasPath, m_nextOrder++);
+            out.push_back(item);
+        }
+    }
+
+    const std::vector<RenderQueue::Item>& RenderQueue::Update(entt::registry& reg)
+    {
+        MY2D_PROFILE_SCOPE("RenderQueue::Update");
+
+        if (m_rebuild)
+        {
+            m_rebuild = false;
+            m_items.clear();
+            for (entt::entity e : m_changed)
+                m_changedMark[(size_t)entt::to_entity(e)] = entt::null;
+            m_changed.clear();
+            m_nextOrder = 0;
+
+            for (auto e : reg.view<TilemapComponent>())
+                AddItems(reg, e, m_items);
+            for (auto e : reg.view<SpriteRendererComponent>())
+            {
+                if (!reg.all_of<TilemapComponent>(e)) // already added above
+                    AddItems(reg, e, m_items);
+            }
+
+            RadixSort(m_items, m_scratch);
+            return m_items;
+        }
+
+        if (m_changed.empty())
+            return m_items;
+
+        // Drop every item of a changed entity...
+        m_items.erase(std::remove_if(m_items.begin(), m_items.end(), [this](const Item& item)
+            {
+                const size_t index = (size_t)entt::to_entity(item.entity);
+                return index < m_changedMark.size() && m_changedMark[index] != entt::null;
+            }), m_items.end());
+
+        // ...then sort just the re-added ones and merge them in
+        m_added.clear();
+        for (entt::entity e : m_changed)
+        {
+            m_changedMark[(size_t)entt::to_entity(e)] = entt::null;
+            AddItems(reg, e, m_added);
+        }
+        m_changed.clear();
+
+        RadixSort(m_added, m_scratch);
+
+        m_scratch.resize(m_items.size() + m_added.size());
+        std::merge(m_items.begin(), m_items.end(), m_added.begin(), m_added.end(), m_scratch.begin(),
+            [](const Item& a, const Item& b) { return a.key < b.key; });
+        m_items.swap(m_scratch);
+        return m_items;
+    }
+
+    void RenderQueue::RadixSort(std::vector<Item>& items, std::vector<Item>& scratch)
+    {
+        const size_t n = items.size();
+        if (n < 2)
+            return;
+
+        scratch.resize(n);
+
+        // Bytes where every key agrees would be no-op passes (the layer byte often is)
+        uint64_t allOnes = ~0ull;
+        uint64_t anyOnes = 0;
+        for (const Item& item : items)
+        {
+            allOnes &= item.key;
+            anyOnes |= item.key;
+        }
+        const uint64_t varying = allOnes ^ anyOnes;
+
+        Item* src = items.data();
+        Item* dst = scratch.data();
+
+        for (uint32_t shift = 0; shift < 64; shift += 8)
+        {
+            if (((varying >> shift) & 0xFFu) == 0)
+                continue;
+
+            size_t offsets[256] = {};
+            for (size_t i = 0; i < n; ++i)
+                ++offsets[(src[i].key >> shift) & 0xFFu];
+
+            size_t sum = 0;
+            for (size_t& o : offsets)
+            {
+                const size_t count = o;
+                o = sum;
+                sum += count;
+            }
+
+            for (size_t i = 0; i < n; ++i)
+                dst[offsets[(src[i].key >> shift) & 0xFFu]++] = src[i];
+
+            std::swap(src, dst);
+        }
+
+        if (src != items.data())
+            items.swap(scratch);
+    }
+}
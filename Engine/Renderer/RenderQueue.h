@@ -0,0 +1,60 @@
+#pragma once
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace my2d
+{
+    // Draw order for a scene's sprites and tile layers, sorted by (layer, kind, texture, order).
+    // Tile layers come before sprites on the same layer; sprites group by texture; `order` keeps it stable.
+    //
+    // Kept up to date from the registry's SpriteRenderer/Tilemap signals: added/changed/removed entities are
+    // patched in (radix sort of the new items + merge) instead of re-sorting the scene every frame.
+    // Layers/textures written in place (no patch/replace) need MarkChanged (Scene::MarkSpriteChanged).
+    class RenderQueue
+    {
+    public:
+        static constexpr uint16_t SpriteItem = 0xFFFF;
+
+        struct Item
+        {
+            uint64_t key = 0;
+            entt::entity entity = entt::null;
+            uint16_t tileLayer = SpriteItem; // index into TilemapComponent::layers, or SpriteItem
+        };
+
+        void Connect(entt::registry& reg);
+        void Disconnect(entt::registry& reg);
+
+        // Applies pending changes and returns the sorted list. Entries may reference entities
+        // that lost their TransformComponent; callers skip those.
+        const std::vector<Item>& Update(entt::registry& reg);
+
+        const std::vector<Item>& Items() const { return m_items; }
+
+        // Sprite/tilemap of e written in place: its items are rebuilt on the next Update.
+        void MarkChanged(entt::entity e);
+
+        // Drops everything and re-adds every sprite/tilemap on the next Update (full radix sort).
+        void Invalidate() { m_rebuild = true; }
+
+        // LSD radix sort on Item::key (8-bit digits, passes where every key agrees are skipped).
+        static void RadixSort(std::vector<Item>& items, std::vector<Item>& scratch);
+
+    private:
+        void OnChanged(entt::registry& reg, entt::entity e);
+        void OnRemoved(entt::registry& reg, entt::entity e);
+        void AddItems(entt::registry& reg, entt::entity e, std::vector<Item>& out);
+
+    private:
+        std::vector<Item> m_items;
+        std::vector<Item> m_added;
+        std::vector<Item> m_scratch;
+
+        std::vector<entt::entity> m_changed;   // re-add (or drop) these on the next Update
+        std::vector<entt::entity> m_changedMark; // by entity index, dedupes m_changed
+        uint32_t m_nextOrder = 0;
+        bool m_rebuild = true;
+    };
+}
@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "Renderer/RenderSnapshot.h"
+#include "Renderer/Renderer2D.h"
+#include "Renderer/Texture2D.h"
+#include "Core/Profiler.h"
+
+namespace my2d
+{
+    void RenderSnapshot::Clear()
+    {
+        m_items.clear();
+        m_textures.clear();
+        m_lastTexture = 0;
+        frame = 0;
+    }
+
+    uint32_t RenderSnapshot::TextureIndex(const std::shared_ptr<Texture2D>& texture)
+    {
+        // Draws come in runs (tile layers, sprite batches), so the last one usually matches
+        if (m_lastTexture < m_textures.size() && m_textures[m_lastTexture] == texture)
+            return m_lastTexture;
+
+        for (uint32_t i = 0; i < (uint32_t)m_textures.size(); ++i)
+        {
+            if (m_textures[i] == texture)
+                return m_lastTexture = i;
+        }
+
+        m_textures.push_back(texture);
+        return m_lastTexture = (uint32_t)m_textures.size() - 1;
+    }
+
+    void RenderSnapshot::Add(const std::shared_ptr<Texture2D>& texture,
+        const glm::vec2& worldPos,
+        const glm::vec2& worldSize,
+        const SDL_Rect* srcRect,
+        float rotationDeg,
+        SDL_RendererFlip flip,
+        SDL_Color tint)
+    {
+        if (!texture) return;
+
+        RenderItem item;
+        item.texture = TextureIndex(texture);
+        item.hasSrc = srcRect != nullptr;
+        if (srcRect) item.src = *srcRect;
+        item.worldPos = worldPos;
+        item.worldSize = worldSize;
+        item.rotationDeg = rotationDeg;
+        item.flip = flip;
+        item.tint = tint;
+        m_items.push_back(item);
+    }
+
+    void RenderSnapshot::Submit(Renderer2D& renderer) const
+    {
+        MY2D_PROFILE_SCOPE("RenderSnapshot::Submit");
+
+        for (const auto& tex : m_textures)
+            tex->Upload(renderer.GetRenderer());
+
+        renderer.GetCamera() = camera;
+
+        for (const RenderItem& item : m_items)
+        {
+            renderer.DrawTexture(
+                *m_textures[item.texture],
+                item.worldPos,
+                item.worldSize,
+                item.hasSrc ? &item.src : nullptr,
+                item.rotationDeg,
+                item.flip,
+                item.tint
+            );
+        }
+    }
+}
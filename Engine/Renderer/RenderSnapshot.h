@@ -0,0 +1,61 @@
+#pragma once
+#include "Platform/Sdl.h"
+#include "Renderer/Camera2D.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace my2d
+{
+    class Texture2D;
+    class Renderer2D;
+
+    struct RenderItem
+    {
+        uint32_t texture = 0; // index into RenderSnapshot::Textures()
+        SDL_Rect src{};
+        bool hasSrc = false;
+        glm::vec2 worldPos{ 0.0f, 0.0f };
+        glm::vec2 worldSize{ 0.0f, 0.0f };
+        float rotationDeg = 0.0f;
+        SDL_RendererFlip flip = SDL_FLIP_NONE;
+        SDL_Color tint{ 255, 255, 255, 255 };
+    };
+
+    // Everything the render stage needs for one frame, in draw order.
+    // Built by the simulation, then read-only until the render stage hands it back.
+    // Holds references to its textures so they outlive any asset cache clear in the meantime.
+    class RenderSnapshot
+    {
+    public:
+        // Keeps capacity, so steady-state frames don't allocate.
+        void Clear();
+
+        void Add(const std::shared_ptr<Texture2D>& texture,
+            const glm::vec2& worldPos,
+            const glm::vec2& worldSize,
+            const SDL_Rect* srcRect = nullptr,
+            float rotationDeg = 0.0f,
+            SDL_RendererFlip flip = SDL_FLIP_NONE,
+            SDL_Color tint = { 255, 255, 255, 255 });
+
+        // Render thread only: uploads pending textures and draws every item with this snapshot's camera.
+        void Submit(Renderer2D& renderer) const;
+
+        const std::vector<RenderItem>& Items() const { return m_items; }
+        const std::vector<std::shared_ptr<Texture2D>>& Textures() const { return m_textures; }
+
+        Camera2D camera;
+        uint64_t frame = 0;
+
+    private:
+        uint32_t TextureIndex(const std::shared_ptr<Texture2D>& texture);
+
+    private:
+        std::vector<RenderItem> m_items;
+        std::vector<std::shared_ptr<Texture2D>> m_textures;
+        uint32_t m_lastTexture = 0;
+    };
+}
@@ -2,16 +2,63 @@
 #include "Renderer/Texture2D.h"
 #include "Platform/SdlImage.h"
 
+#include <atomic>
+#include <mutex>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 namespace my2d
 {
+    static std::atomic<bool> s_deferredGpu{ false };
+    static std::mutex s_pendingMutex;
+    static std::vector<SDL_Texture*> s_pendingDestroy;
+
+    // The last reference can drop on any thread; in deferred mode the handle goes to the render thread
+    static void ReleaseNative(SDL_Texture* tex)
+    {
+        if (!tex) return;
+
+        if (s_deferredGpu.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(s_pendingMutex);
+            s_pendingDestroy.push_back(tex);
+            return;
+        }
+
+        SDL_DestroyTexture(tex);
+    }
+
+    void Texture2D::SetDeferredGpu(bool deferred)
+    {
+        s_deferredGpu.store(deferred, std::memory_order_release);
+    }
+
+    bool Texture2D::IsDeferredGpu()
+    {
+        return s_deferredGpu.load(std::memory_order_acquire);
+    }
+
+    void Texture2D::DestroyPending()
+    {
+        std::vector<SDL_Texture*> pending;
+        {
+            std::lock_guard<std::mutex> lock(s_pendingMutex);
+            pending.swap(s_pendingDestroy);
+        }
+
+        for (SDL_Texture* tex : pending)
+            SDL_DestroyTexture(tex);
+    }
+
     Texture2D::~Texture2D()
     {
-        if (m_texture)
+        ReleaseNative(m_texture);
+        m_texture = nullptr;
+
+        if (m_surface)
         {
-            SDL_DestroyTexture(m_texture);
-            m_texture = nullptr;
+            SDL_FreeSurface(m_surface);
+            m_surface = nullptr;
         }
     }
 
@@ -24,14 +71,17 @@ namespace my2d
     {
         if (this == &other) return *this;
 
-        if (m_texture) SDL_DestroyTexture(m_texture);
+        ReleaseNative(m_texture);
+        if (m_surface) SDL_FreeSurface(m_surface);
 
         m_texture = other.m_texture;
+        m_surface = other.m_surface;
         m_width = other.m_width;
         m_height = other.m_height;
         m_path = std::move(other.m_path);
 
         other.m_texture = nullptr;
+        other.m_surface = nullptr;
         other.m_width = 0;
         other.m_height = 0;
 
@@ -53,10 +103,21 @@ namespace my2d
             return false;
         }
 
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surface);
         m_width = surface->w;
         m_height = surface->h;
+        m_path = path;
+
+        // Renderer belongs to another thread: keep the pixels until it uploads them
+        if (s_deferredGpu.load(std::memory_order_acquire))
+        {
+            ReleaseNative(m_texture);
+            m_texture = nullptr;
+            if (m_surface) SDL_FreeSurface(m_surface);
+            m_surface = surface;
+            return true;
+        }
 
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surface);
         SDL_FreeSurface(surface);
 
         if (!tex)
@@ -70,8 +131,30 @@ namespace my2d
 
         if (m_texture) SDL_DestroyTexture(m_texture);
         m_texture = tex;
-        m_path = path;
 
         return true;
     }
+
+    bool Texture2D::Upload(SDL_Renderer* renderer)
+    {
+        if (m_texture)
+            return true;
+
+        if (!renderer || !m_surface)
+            return false;
+
+        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, m_surface);
+        SDL_FreeSurface(m_surface);
+        m_surface = nullptr;
+
+        if (!tex)
+        {
+            spdlog::error("SDL_CreateTextureFromSurface failed for '{}': {}", m_path, SDL_GetError());
+            return false;
+        }
+
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        m_texture = tex;
+        return true;
+    }
 }
\ No newline at end of file
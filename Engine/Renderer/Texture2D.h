@@ -19,6 +19,15 @@ namespace my2d
 
         bool LoadFromFile(SDL_Renderer* renderer, const std::string& path);
 
+        // Pipelined rendering: loads only decode pixels (any thread); the SDL texture is created by Upload()
+        // and destroyed by DestroyPending(), both on the thread that owns the renderer.
+        static void SetDeferredGpu(bool deferred);
+        static bool IsDeferredGpu();
+        static void DestroyPending();
+
+        bool IsUploaded() const { return m_texture != nullptr; }
+        bool Upload(SDL_Renderer* renderer);
+
         SDL_Texture* GetNative() const { return m_texture; }
         int Width() const { return m_width; }
         int Height() const { return m_height; }
@@ -26,6 +35,7 @@ namespace my2d
 
     private:
         SDL_Texture* m_texture = nullptr;
+        SDL_Surface* m_surface = nullptr; // decoded pixels waiting for Upload() (deferred mode)
         int m_width = 0;
         int m_height = 0;
         std::string m_path;
@@ -21,12 +21,15 @@ namespace my2d
         return r;
     }
 
-    void TilemapRenderer2D::DrawLayer(
+    // fn(tex, worldPos, worldSize, src, rotationDeg, flip, tint) for every visible tile
+    template<typename Fn>
+    static void ForEachVisibleTile(
         const TilemapComponent& tilemap,
         const TransformComponent& transform,
         const TileLayer& layer,
         AssetManager& assets,
-        Renderer2D& renderer)
+        const Camera2D& cam,
+        Fn&& fn)
     {
         if (!layer.visible) return;
 
@@ -62,8 +65,6 @@ namespace my2d
             return;
         }
 
-        const auto& cam = renderer.GetCamera();
-
         const float halfW = cam.ViewportW() * 0.5f / cam.Zoom();
         const float halfH = cam.ViewportH() * 0.5f / cam.Zoom();
 
@@ -158,16 +159,39 @@ namespace my2d
                 const glm::vec2 worldPos =
                     origin + glm::vec2((float)(x * tilemap.tileWidth), (float)(y * tilemap.tileHeight));
 
-                renderer.DrawTexture(
-                    *tex,
-                    worldPos,
-                    { (float)tilemap.tileWidth, (float)tilemap.tileHeight },
-                    &src,
-                    rotationDeg,
-                    flip,
-                    layer.tint
-                );
+                fn(tex, worldPos, glm::vec2((float)tilemap.tileWidth, (float)tilemap.tileHeight), src, rotationDeg, flip, layer.tint);
             }
         }
     }
+
+    void TilemapRenderer2D::DrawLayer(
+        const TilemapComponent& tilemap,
+        const TransformComponent& transform,
+        const TileLayer& layer,
+        AssetManager& assets,
+        Renderer2D& renderer)
+    {
+        ForEachVisibleTile(tilemap, transform, layer, assets, renderer.GetCamera(),
+            [&](const std::shared_ptr<Texture2D>& tex, const glm::vec2& pos, const glm::vec2& size,
+                const SDL_Rect& src, float rotationDeg, SDL_RendererFlip flip, SDL_Color tint)
+            {
+                renderer.DrawTexture(*tex, pos, size, &src, rotationDeg, flip, tint);
+            });
+    }
+
+    void TilemapRenderer2D::AppendLayer(
+        const TilemapComponent& tilemap,
+        const TransformComponent& transform,
+        const TileLayer& layer,
+        AssetManager& assets,
+        const Camera2D& camera,
+        RenderSnapshot& out)
+    {
+        ForEachVisibleTile(tilemap, transform, layer, assets, camera,
+            [&](const std::shared_ptr<Texture2D>& tex, const glm::vec2& pos, const glm::vec2& size,
+                const SDL_Rect& src, float rotationDeg, SDL_RendererFlip flip, SDL_Color tint)
+            {
+                out.Add(tex, pos, size, &src, rotationDeg, flip, tint);
+            });
+    }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "Renderer/Renderer2D.h"
+#include "Renderer/RenderSnapshot.h"
 #include "Assets/AssetManager.h"
 #include "Scene/Components.h"
 
@@ -14,5 +15,14 @@ namespace my2d
             const TileLayer& layer,
             AssetManager& assets,
             Renderer2D& renderer);
+
+        // Same tiles as DrawLayer, culled against `camera`, appended to a snapshot instead of drawn.
+        void AppendLayer(
+            const TilemapComponent& tilemap,
+            const TransformComponent& transform,
+            const TileLayer& layer,
+            AssetManager& assets,
+            const Camera2D& camera,
+            RenderSnapshot& out);
     };
 }
\ No newline at end of file
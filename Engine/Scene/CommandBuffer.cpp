@@ -0,0 +1,51 @@
+#include "pch.h"
+#include "Scene/CommandBuffer.h"
+#include "Scene/Scene.h"
+#include "Physics/PhysicsSystem.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+
+namespace my2d
+{
+    void CommandBuffer::Flush(Scene& scene)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_destroy.empty() && m_edits.empty())
+                return;
+
+            m_destroyFlushing.swap(m_destroy);
+            m_editsFlushing.swap(m_edits);
+        }
+
+        MY2D_PROFILE_SCOPE("CommandBuffer::Flush");
+
+        auto& reg = scene.Registry();
+
+        for (auto& fn : m_editsFlushing)
+            fn(reg);
+        m_editsFlushing.clear();
+
+        // Children go with their parent
+        auto& doomed = m_destroyFlushing;
+        const size_t queued = doomed.size();
+        for (size_t i = 0; i < queued; ++i)
+        {
+            if (reg.valid(doomed[i]))
+                scene.Hierarchy().CollectDescendants(reg, doomed[i], doomed);
+        }
+
+        // Same entity queued twice, or already destroyed some other way
+        std::sort(doomed.begin(), doomed.end());
+        doomed.erase(std::unique(doomed.begin(), doomed.end()), doomed.end());
+        doomed.erase(std::remove_if(doomed.begin(), doomed.end(), [&](entt::entity e) { return !reg.valid(e); }), doomed.end());
+
+        if (!doomed.empty())
+        {
+            Physics_DestroyRuntimeForEntities(scene, doomed.data(), doomed.size());
+            reg.destroy(doomed.begin(), doomed.end());
+        }
+        doomed.clear();
+    }
+}
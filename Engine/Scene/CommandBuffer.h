@@ -0,0 +1,80 @@
+#pragma once
+#include <entt/entt.hpp>
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace my2d
+{
+    class Scene;
+
+    // Structural changes (destroy / add / remove component) queued by systems and applied together
+    // at the frame's sync points (Scene::FlushCommands, called by the Engine after the post-physics
+    // step and after the variable update).
+    //
+    // Queued entities stay alive and fully usable until the flush, so systems can queue from inside
+    // view loops. Queueing is thread-safe; flushing is not (main/sim thread only).
+    class CommandBuffer
+    {
+    public:
+        CommandBuffer() = default;
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        // Duplicates and entities that die before the flush are fine.
+        void Destroy(entt::entity e)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_destroy.push_back(e);
+        }
+
+        // emplace_or_replace at flush time (skipped if the entity is gone by then)
+        template<typename T>
+        void Add(entt::entity e, T value)
+        {
+            Push([e, value = std::move(value)](entt::registry& reg) mutable
+                {
+                    if (reg.valid(e))
+                        reg.emplace_or_replace<T>(e, std::move(value));
+                });
+        }
+
+        template<typename T>
+        void Remove(entt::entity e)
+        {
+            Push([e](entt::registry& reg)
+                {
+                    if (reg.valid(e))
+                        reg.remove<T>(e);
+                });
+        }
+
+        bool Empty() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_destroy.empty() && m_edits.empty();
+        }
+
+        // Component edits in queue order, then every destroy (plus descendants) in one batch (Box2D bodies released first).
+        // Commands queued while flushing wait for the next flush.
+        void Flush(Scene& scene);
+
+    private:
+        void Push(std::function<void(entt::registry&)> fn)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_edits.push_back(std::move(fn));
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<entt::entity> m_destroy;
+        std::vector<std::function<void(entt::registry&)>> m_edits;
+
+        // Swapped in during Flush so the queues keep their capacity (no steady-state allocations)
+        std::vector<entt::entity> m_destroyFlushing;
+        std::vector<std::function<void(entt::registry&)>> m_editsFlushing;
+    };
+}
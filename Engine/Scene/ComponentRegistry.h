@@ -0,0 +1,460 @@
+#pragma once
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Scene/Components.h"
+
+namespace my2d
+{
+    // Compile-time description of every serialized component: which fields exist, under what name, and
+    // whether they're authored data or runtime state. The JSON loader/saver (SceneSerializer), the cooked
+    // .scene.bin (CookedScene) and SceneSnapshot all walk these tables instead of listing fields by hand,
+    // so a new field or component is added here once.
+    //
+    // Adding a component: a Reflect<> specialization below, then append it to SerializedComponents.
+
+    enum FieldFlags : uint8_t
+    {
+        kFieldSaved = 1 << 0,    // authored: JSON, cooked file, snapshot
+        kFieldRuntime = 1 << 1,  // runtime state: snapshot only, reset to the default on load
+        kFieldTileData = 1 << 2, // std::vector<int> of tiles: JSON may store it as "<name>Data" (rle16)
+    };
+
+    template<typename T, typename V>
+    struct FieldDesc
+    {
+        using Owner = T;
+        using Value = V;
+
+        const char* name;
+        V T::* member;
+        uint8_t flags;
+    };
+
+    template<typename T, typename V>
+    constexpr FieldDesc<T, V> Field(const char* name, V T::* member, uint8_t extraFlags = 0)
+    {
+        return { name, member, (uint8_t)(kFieldSaved | extraFlags) };
+    }
+
+    template<typename T, typename V>
+    constexpr FieldDesc<T, V> RuntimeField(const char* name, V T::* member)
+    {
+        return { name, member, kFieldRuntime };
+    }
+
+    struct ReflectDefaults
+    {
+        // Key of the component object in a scene/prefab entity; nullptr for the ones stored at entity level
+        // (tag, prefab) or not stored in JSON at all
+        static constexpr const char* kKey = nullptr;
+
+        // Loaded over the existing component (patch) instead of replacing it with a fresh one
+        static constexpr bool kOverlay = false;
+    };
+
+    // Specialized per type below; unspecialized types aren't reflected
+    template<typename T>
+    struct Reflect {};
+
+    template<typename T, typename = void>
+    struct IsReflected : std::false_type {};
+
+    template<typename T>
+    struct IsReflected<T, std::void_t<decltype(Reflect<T>::kFields)>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool kIsReflected = IsReflected<T>::value;
+
+    template<typename T>
+    struct IsVector : std::false_type {};
+
+    template<typename T, typename A>
+    struct IsVector<std::vector<T, A>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool kIsVector = IsVector<T>::value;
+
+    // fn(const FieldDesc<T, V>&) for every field, in table order
+    template<typename T, typename Fn>
+    constexpr void ForEachField(Fn&& fn)
+    {
+        std::apply([&fn](const auto&... field) { (fn(field), ...); }, Reflect<T>::kFields);
+    }
+
+    // ---- tables ----
+
+    template<> struct Reflect<TransformComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Transform";
+        static constexpr bool kOverlay = true; // always there (CreateEntity); a prefab may have set it already
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("position", &TransformComponent::position),
+            Field("rotationDeg", &TransformComponent::rotationDeg),
+            Field("scale", &TransformComponent::scale));
+    };
+
+    template<> struct Reflect<TagComponent> : ReflectDefaults
+    {
+        static constexpr auto kFields = std::make_tuple(Field("tag", &TagComponent::tag));
+    };
+
+    template<> struct Reflect<SpriteRendererComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "SpriteRenderer";
+        using C = SpriteRendererComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("texturePath", &C::texturePath),
+            Field("size", &C::size),
+            Field("tint", &C::tint),
+            Field("layer", &C::layer),
+            Field("useSourceRect", &C::useSourceRect),
+            Field("sourceRect", &C::sourceRect),
+            Field("flip", &C::flip),
+            Field("atlasPath", &C::atlasPath),
+            Field("regionName", &C::regionName),
+            Field("pivot", &C::pivot),
+            Field("offset", &C::offset));
+    };
+
+    template<> struct Reflect<AnimatorComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Animator";
+        using C = AnimatorComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("animSetPath", &C::animSetPath),
+            Field("clip", &C::clip),
+            Field("playing", &C::playing),
+            Field("speed", &C::speed),
+            RuntimeField("time", &C::time),
+            RuntimeField("frameIndex", &C::frameIndex));
+    };
+
+    template<> struct Reflect<Tileset> : ReflectDefaults
+    {
+        static constexpr auto kFields = std::make_tuple(
+            Field("texturePath", &Tileset::texturePath),
+            Field("tileWidth", &Tileset::tileWidth),
+            Field("tileHeight", &Tileset::tileHeight),
+            Field("columns", &Tileset::columns),
+            Field("margin", &Tileset::margin),
+            Field("spacing", &Tileset::spacing));
+    };
+
+    template<> struct Reflect<TileLayer> : ReflectDefaults
+    {
+        static constexpr auto kFields = std::make_tuple(
+            Field("name", &TileLayer::name),
+            Field("layer", &TileLayer::layer),
+            Field("visible", &TileLayer::visible),
+            Field("tint", &TileLayer::tint),
+            Field("tiles", &TileLayer::tiles, kFieldTileData));
+    };
+
+    template<> struct Reflect<TilemapComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Tilemap";
+        using C = TilemapComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("width", &C::width),
+            Field("height", &C::height),
+            Field("tileWidth", &C::tileWidth),
+            Field("tileHeight", &C::tileHeight),
+            Field("tileset", &C::tileset),
+            Field("layers", &C::layers),
+            RuntimeField("viewportW", &C::viewportW),
+            RuntimeField("viewportH", &C::viewportH));
+    };
+
+    // runtimeBodies isn't listed: the bodies are rebuilt by BuildTilemapColliders
+    template<> struct Reflect<TilemapColliderComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "TilemapCollider";
+        using C = TilemapColliderComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("collisionLayerIndex", &C::collisionLayerIndex),
+            Field("friction", &C::friction),
+            Field("restitution", &C::restitution),
+            Field("isSensor", &C::isSensor),
+            Field("slopeUpRightTiles", &C::slopeUpRightTiles),
+            Field("slopeUpLeftTiles", &C::slopeUpLeftTiles),
+            Field("slopeFriction", &C::slopeFriction));
+    };
+
+    template<> struct Reflect<RigidBody2DComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "RigidBody2D";
+        using C = RigidBody2DComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("type", &C::type),
+            Field("enabled", &C::enabled),
+            Field("fixedRotation", &C::fixedRotation),
+            Field("enableSleep", &C::enableSleep),
+            Field("isBullet", &C::isBullet),
+            Field("gravityScale", &C::gravityScale),
+            Field("linearDamping", &C::linearDamping),
+            Field("angularDamping", &C::angularDamping),
+            RuntimeField("prevPosition", &C::prevPosition),
+            RuntimeField("prevRotationDeg", &C::prevRotationDeg));
+    };
+
+    template<> struct Reflect<BoxCollider2DComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "BoxCollider2D";
+        using C = BoxCollider2DComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("size", &C::size),
+            Field("offset", &C::offset),
+            Field("enabled", &C::enabled),
+            Field("density", &C::density),
+            Field("friction", &C::friction),
+            Field("restitution", &C::restitution),
+            Field("isSensor", &C::isSensor),
+            Field("categoryBits", &C::categoryBits),
+            Field("maskBits", &C::maskBits));
+    };
+
+    template<> struct Reflect<PlatformerControllerComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "PlatformerController";
+        using C = PlatformerControllerComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("moveSpeedPx", &C::moveSpeedPx),
+            Field("accelPx", &C::accelPx),
+            Field("decelPx", &C::decelPx),
+            Field("jumpSpeedPx", &C::jumpSpeedPx),
+            Field("coyoteTime", &C::coyoteTime),
+            Field("jumpBufferTime", &C::jumpBufferTime),
+            Field("groundCheckDistancePx", &C::groundCheckDistancePx),
+            Field("groundRayInsetPx", &C::groundRayInsetPx),
+            Field("left", &C::left),
+            Field("right", &C::right),
+            Field("jump", &C::jump),
+            Field("dash", &C::dash),
+            Field("dashSpeedPx", &C::dashSpeedPx),
+            Field("dashTime", &C::dashTime),
+            Field("dashCooldown", &C::dashCooldown),
+            Field("maxGroundSlopeDeg", &C::maxGroundSlopeDeg),
+            Field("maxJumpSlopeDeg", &C::maxJumpSlopeDeg),
+            RuntimeField("facing", &C::facing),
+            RuntimeField("isDashing", &C::isDashing),
+            RuntimeField("dashTimer", &C::dashTimer),
+            RuntimeField("dashCooldownTimer", &C::dashCooldownTimer),
+            RuntimeField("dashDir", &C::dashDir),
+            RuntimeField("jumpableGround", &C::jumpableGround),
+            RuntimeField("grounded", &C::grounded),
+            RuntimeField("coyoteTimer", &C::coyoteTimer),
+            RuntimeField("jumpBufferTimer", &C::jumpBufferTimer));
+    };
+
+    template<> struct Reflect<PersistentFlagComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "PersistentFlag";
+        static constexpr auto kFields = std::make_tuple(Field("flag", &PersistentFlagComponent::flag));
+    };
+
+    template<> struct Reflect<GrantProgressionComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "GrantProgression";
+        using C = GrantProgressionComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("setFlag", &C::setFlag),
+            Field("unlockAbility", &C::unlockAbility),
+            Field("ability", &C::ability),
+            Field("radiusPx", &C::radiusPx));
+    };
+
+    template<> struct Reflect<GateComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Gate";
+        using C = GateComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("requireAllAbilities", &C::requireAllAbilities),
+            Field("requireAnyAbilities", &C::requireAnyAbilities),
+            Field("requireAllFlags", &C::requireAllFlags),
+            Field("requireAnyFlags", &C::requireAnyFlags),
+            Field("invert", &C::invert),
+            Field("openWhenSatisfied", &C::openWhenSatisfied),
+            Field("openBehavior", &C::openBehavior),
+            Field("overrideTint", &C::overrideTint),
+            Field("closedTint", &C::closedTint),
+            Field("openTint", &C::openTint),
+            Field("hideWhenOpen", &C::hideWhenOpen),
+            RuntimeField("initialized", &C::initialized),
+            RuntimeField("isOpen", &C::isOpen));
+    };
+
+    template<> struct Reflect<PlayerSpawnComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "PlayerSpawn";
+        static constexpr auto kFields = std::make_tuple(Field("name", &PlayerSpawnComponent::name));
+    };
+
+    template<> struct Reflect<DoorComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Door";
+        using C = DoorComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("targetScene", &C::targetScene),
+            Field("targetSpawn", &C::targetSpawn),
+            Field("triggerSize", &C::triggerSize),
+            Field("requireInteract", &C::requireInteract),
+            Field("interactKey", &C::interactKey),
+            Field("autoTrigger", &C::autoTrigger),
+            RuntimeField("cooldownTimer", &C::cooldownTimer));
+    };
+
+    template<> struct Reflect<FacingComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Facing";
+        static constexpr auto kFields = std::make_tuple(Field("facing", &FacingComponent::facing));
+    };
+
+    template<> struct Reflect<TeamComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Team";
+        static constexpr auto kFields = std::make_tuple(Field("team", &TeamComponent::team));
+    };
+
+    template<> struct Reflect<HealthComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Health";
+        static constexpr auto kFields = std::make_tuple(
+            Field("maxHp", &HealthComponent::maxHp),
+            Field("hp", &HealthComponent::hp));
+    };
+
+    template<> struct Reflect<HurtboxComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "Hurtbox";
+        static constexpr auto kFields = std::make_tuple(Field("enabled", &HurtboxComponent::enabled));
+    };
+
+    template<> struct Reflect<MeleeAttackComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "MeleeAttack";
+        using C = MeleeAttackComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("attackKey", &C::attackKey),
+            Field("useInput", &C::useInput),
+            Field("damage", &C::damage),
+            Field("activeTime", &C::activeTime),
+            Field("cooldown", &C::cooldown),
+            Field("hitboxSizePx", &C::hitboxSizePx),
+            Field("hitboxOffsetPx", &C::hitboxOffsetPx),
+            Field("allowAimUp", &C::allowAimUp),
+            Field("allowAimDown", &C::allowAimDown),
+            Field("allowDownAttackOnGround", &C::allowDownAttackOnGround),
+            Field("aimUpKey", &C::aimUpKey),
+            Field("aimDownKey", &C::aimDownKey),
+            Field("hitboxSizeUpPx", &C::hitboxSizeUpPx),
+            Field("hitboxOffsetUpPx", &C::hitboxOffsetUpPx),
+            Field("hitboxSizeDownPx", &C::hitboxSizeDownPx),
+            Field("hitboxOffsetDownPx", &C::hitboxOffsetDownPx),
+            Field("knockbackSpeedPx", &C::knockbackSpeedPx),
+            Field("knockbackUpPx", &C::knockbackUpPx),
+            Field("victimInvuln", &C::victimInvuln),
+            Field("targetMaskBits", &C::targetMaskBits),
+            Field("pogoOnDownHit", &C::pogoOnDownHit),
+            Field("pogoReboundSpeedPx", &C::pogoReboundSpeedPx),
+            RuntimeField("attackRequested", &C::attackRequested),
+            RuntimeField("activeTimer", &C::activeTimer),
+            RuntimeField("cooldownTimer", &C::cooldownTimer));
+    };
+
+    template<> struct Reflect<EnemyAIComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "EnemyAI";
+        using C = EnemyAIComponent;
+
+        static constexpr auto kFields = std::make_tuple(
+            Field("patrolSpeedPx", &C::patrolSpeedPx),
+            Field("chaseSpeedPx", &C::chaseSpeedPx),
+            Field("aggroRangePx", &C::aggroRangePx),
+            Field("deaggroRangePx", &C::deaggroRangePx),
+            Field("attackRangePx", &C::attackRangePx),
+            Field("ledgeCheckDownPx", &C::ledgeCheckDownPx),
+            Field("wallCheckForwardPx", &C::wallCheckForwardPx),
+            Field("canPatrol", &C::canPatrol),
+            Field("canChase", &C::canChase),
+            RuntimeField("aggro", &C::aggro));
+    };
+
+    template<> struct Reflect<InvincibilityComponent> : ReflectDefaults
+    {
+        static constexpr auto kFields = std::make_tuple(RuntimeField("timer", &InvincibilityComponent::timer));
+    };
+
+    template<> struct Reflect<RemoveIfHasAbilityComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "RemoveIfHasAbility";
+        static constexpr auto kFields = std::make_tuple(Field("ability", &RemoveIfHasAbilityComponent::ability));
+    };
+
+    template<> struct Reflect<RemoveIfHasFlagComponent> : ReflectDefaults
+    {
+        static constexpr const char* kKey = "RemoveIfHasFlag";
+        static constexpr auto kFields = std::make_tuple(Field("flag", &RemoveIfHasFlagComponent::flag));
+    };
+
+    template<> struct Reflect<PrefabComponent> : ReflectDefaults
+    {
+        static constexpr auto kFields = std::make_tuple(Field("prefabPath", &PrefabComponent::prefabPath));
+    };
+
+    // ---- the component list ----
+
+    template<typename... Ts>
+    struct ComponentList {};
+
+    // fn(std::type_identity<T>{}) for every type in the list, in order
+    template<typename... Ts, typename Fn>
+    constexpr void ForEachComponent(ComponentList<Ts...>, Fn&& fn)
+    {
+        (fn(std::type_identity<Ts>{}), ...);
+    }
+
+    // Every component that is saved, cooked and snapshotted. Id (entity table) and Hierarchy (parent ids)
+    // are handled by each format itself; WorldTransform is recomputed by SetParent.
+    // Cooked block types are indices into this list: append only (or bump CookedScene's version).
+    using SerializedComponents = ComponentList<
+        TransformComponent, TagComponent, SpriteRendererComponent, AnimatorComponent, TilemapComponent,
+        TilemapColliderComponent, RigidBody2DComponent, BoxCollider2DComponent, PlatformerControllerComponent,
+        PersistentFlagComponent, GrantProgressionComponent, GateComponent, PlayerSpawnComponent, DoorComponent,
+        FacingComponent, TeamComponent, HealthComponent, HurtboxComponent, MeleeAttackComponent, EnemyAIComponent,
+        InvincibilityComponent, RemoveIfHasAbilityComponent, RemoveIfHasFlagComponent, PrefabComponent>;
+
+    // ---- runtime handles ----
+    // Physics ids and pointers that never survive a save, cook or restore (not fields of any table)
+
+    inline void ClearRuntimeHandles(RigidBody2DComponent& c)
+    {
+        c.bodyId = b2_nullBodyId;
+        c.hasPrevTransform = false;
+    }
+
+    inline void ClearRuntimeHandles(BoxCollider2DComponent& c) { c.shapeId = b2_nullShapeId; }
+
+    inline void ClearRuntimeHandles(MeleeAttackComponent& c)
+    {
+        c.hitboxShapeId = b2_nullShapeId;
+        c.runtimeUserData = nullptr;
+    }
+
+    template<typename T>
+    void ClearRuntimeHandles(T&) {}
+}
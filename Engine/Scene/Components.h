@@ -5,6 +5,8 @@
 #include <cstdint>
 
 #include <glm/vec2.hpp>
+#include <entt/entt.hpp>
+#include "Core/StringId.h"
 #include "Platform/Sdl.h"
 #include "Physics/Box2D.h"
 
@@ -22,9 +24,10 @@ namespace my2d
         uint64_t id = 0;
     };
 
+    // Indexed by Scene (FindEntityByTag): change it with emplace/replace/patch, not by writing the field
     struct TagComponent
     {
-        std::string tag;
+        StringId tag;
     };
 
     struct TransformComponent
@@ -34,6 +37,31 @@ namespace my2d
         glm::vec2 scale{ 1.0f, 1.0f };
     };
 
+    // Parent/child links (intrusive list of children). Change them through Scene::SetParent/ClearParent.
+    // A child's TransformComponent is relative to its parent.
+    struct HierarchyComponent
+    {
+        entt::entity parent = entt::null;
+        entt::entity firstChild = entt::null;
+        entt::entity nextSibling = entt::null;
+        entt::entity prevSibling = entt::null;
+
+        // runtime: queued for the next world transform update
+        bool dirty = false;
+    };
+
+    // Cached world transform of a child entity (roots don't have one: their TransformComponent is the world).
+    // Written by Scene::UpdateWorldTransforms; read it through WorldTransformOf().
+    struct WorldTransformComponent
+    {
+        TransformComponent world;
+
+        // runtime: world transform from the previous fixed step, for render interpolation
+        glm::vec2 prevPosition{ 0.0f, 0.0f };
+        float prevRotationDeg = 0.0f;
+        bool hasPrevTransform = false;
+    };
+
     struct SpriteRendererComponent
     {
         std::string texturePath;          // legacy path
@@ -55,9 +83,10 @@ namespace my2d
         SDL_RendererFlip flip = SDL_FLIP_NONE;
     };
 
+    // Indexed by Scene (FindSpawn), same rule as TagComponent
     struct PlayerSpawnComponent
     {
-        std::string name = "start";
+        StringId name{ "start" };
     };
 
     struct DoorComponent
@@ -164,6 +193,11 @@ namespace my2d
 
         // runtime
         b2BodyId bodyId = b2_nullBodyId;
+
+        // runtime: transform from the previous fixed step, for render interpolation
+        glm::vec2 prevPosition{ 0.0f, 0.0f };
+        float prevRotationDeg = 0.0f;
+        bool hasPrevTransform = false;
     };
 
     struct BoxCollider2DComponent
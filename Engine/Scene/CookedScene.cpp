@@ -0,0 +1,882 @@
+#include "pch.h"
+#include "Scene/CookedScene.h"
+#include "Scene/Scene.h"
+#include "Scene/Components.h"
+#include "Scene/ComponentRegistry.h"
+#include "Core/MappedFile.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include <spdlog/spdlog.h>
+
+namespace my2d
+{
+    namespace
+    {
+        constexpr uint32_t kMagic = 0x4253594Du; // "MYSB"
+        constexpr uint32_t kVersion = 2;
+        constexpr size_t kSectionAlign = 16;
+
+        // ---- file layout ----
+        // [FileHeader][ids u64 x entityCount][LinkEntry x linkCount][BlockEntry x blockCount]
+        // [per block: rows u32 x count, records x count]...[SourceEntry x sourceCount][blob]
+        // Every section starts 16-byte aligned; offsets are from the start of the file.
+
+        struct StrRef { uint32_t offset = 0; uint32_t size = 0; };    // bytes in the blob
+        struct ArrayRef { uint32_t offset = 0; uint32_t count = 0; }; // elements in the blob
+
+        struct FileHeader
+        {
+            uint32_t magic = kMagic;
+            uint32_t version = kVersion;
+            uint64_t layoutHash = 0;
+
+            uint32_t entityCount = 0;
+            uint32_t linkCount = 0;
+            uint32_t blockCount = 0;
+            uint32_t sourceCount = 0;
+
+            uint64_t idsOffset = 0;
+            uint64_t linksOffset = 0;
+            uint64_t blocksOffset = 0;
+            uint64_t sourcesOffset = 0;
+            uint64_t blobOffset = 0;
+            uint64_t blobSize = 0;
+        };
+
+        struct LinkEntry { uint32_t child = 0; uint32_t parent = 0; }; // rows
+
+        struct BlockEntry
+        {
+            uint32_t type = 0; // index in SerializedComponents
+            uint32_t recordSize = 0;
+            uint32_t count = 0;
+            uint32_t pad = 0;
+            uint64_t rowsOffset = 0;
+            uint64_t recordsOffset = 0;
+        };
+
+        struct SourceEntry
+        {
+            StrRef path;
+            uint32_t exists = 0;
+            uint32_t pad = 0;
+            uint64_t size = 0;
+            int64_t writeTime = 0;
+        };
+
+        // ---- string/array table ----
+
+        struct BlobWriter
+        {
+            std::vector<uint8_t> data;
+            std::unordered_map<std::string, StrRef> strings; // identical strings share one copy
+
+            StrRef Str(const std::string& s)
+            {
+                if (auto it = strings.find(s); it != strings.end())
+                    return it->second;
+
+                const StrRef ref{ (uint32_t)data.size(), (uint32_t)s.size() };
+                data.insert(data.end(), s.begin(), s.end());
+                strings.emplace(s, ref);
+                return ref;
+            }
+
+            template<typename T>
+            ArrayRef Array(const T* items, size_t count)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                data.resize((data.size() + alignof(T) - 1) / alignof(T) * alignof(T));
+
+                const ArrayRef ref{ (uint32_t)data.size(), (uint32_t)count };
+                const auto* p = reinterpret_cast<const uint8_t*>(items);
+                data.insert(data.end(), p, p + count * sizeof(T));
+                return ref;
+            }
+
+            template<typename T>
+            ArrayRef Array(const std::vector<T>& v) { return Array(v.data(), v.size()); }
+        };
+
+        // Out-of-range refs clear ok and read as empty
+        struct BlobReader
+        {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+            bool ok = true;
+            std::unordered_map<uint64_t, StringId> ids; // by string ref: tags repeat a lot
+
+            std::string_view Str(StrRef r)
+            {
+                if ((size_t)r.offset + r.size > size)
+                {
+                    ok = false;
+                    return {};
+                }
+                return std::string_view(reinterpret_cast<const char*>(data + r.offset), r.size);
+            }
+
+            StringId Id(StrRef r)
+            {
+                const uint64_t key = ((uint64_t)r.offset << 32) | r.size;
+                if (auto it = ids.find(key); it != ids.end())
+                    return it->second;
+
+                const StringId id(Str(r));
+                ids.emplace(key, id);
+                return id;
+            }
+
+            template<typename T>
+            const T* Array(ArrayRef r)
+            {
+                if ((size_t)r.offset + (size_t)r.count * sizeof(T) > size || (r.offset % alignof(T)) != 0)
+                {
+                    ok = false;
+                    return nullptr;
+                }
+                return reinterpret_cast<const T*>(data + r.offset);
+            }
+
+            // r.count records of recordSize bytes each
+            const uint8_t* Records(ArrayRef r, size_t recordSize)
+            {
+                if (r.offset > size || (size - r.offset) / recordSize < r.count)
+                {
+                    ok = false;
+                    return nullptr;
+                }
+                return data + r.offset;
+            }
+
+            template<typename T>
+            std::vector<T> Vec(ArrayRef r)
+            {
+                const T* p = Array<T>(r);
+                return p ? std::vector<T>(p, p + r.count) : std::vector<T>{};
+            }
+        };
+
+        // ---- records ----
+        // Plain components (trivially copyable, no interned strings) are written as they are (runtime handles
+        // cleared) and inserted straight from the mapped file. The rest get a packed record generated from the
+        // saved fields of their table (ComponentRegistry.h): StrRef for strings, ArrayRef for vectors, nested
+        // tables inline, runtime fields left out. Packed records are unaligned and read with memcpy.
+
+        template<typename T>
+        constexpr bool HasStringId()
+        {
+            bool found = false;
+            ForEachField<T>([&found](const auto& f)
+                {
+                    using V = typename std::decay_t<decltype(f)>::Value;
+                    found = found || std::is_same_v<V, StringId>;
+                });
+            return found;
+        }
+
+        template<typename T>
+        constexpr bool kCookPlain = std::is_trivially_copyable_v<T> && !HasStringId<T>();
+
+        template<typename T>
+        constexpr size_t RecordSize();
+
+        template<typename V>
+        constexpr size_t EncodedSize()
+        {
+            if constexpr (std::is_same_v<V, std::string> || std::is_same_v<V, StringId>)
+                return sizeof(StrRef);
+            else if constexpr (kIsVector<V>)
+                return sizeof(ArrayRef);
+            else if constexpr (kIsReflected<V>)
+                return RecordSize<V>();
+            else
+            {
+                static_assert(std::is_trivially_copyable_v<V>, "no cooked encoding for this field type");
+                return sizeof(V);
+            }
+        }
+
+        template<typename T>
+        constexpr size_t RecordSize()
+        {
+            if constexpr (kCookPlain<T>)
+                return sizeof(T);
+            else
+            {
+                size_t size = 0;
+                ForEachField<T>([&size](const auto& f)
+                    {
+                        if (f.flags & kFieldSaved)
+                            size += EncodedSize<typename std::decay_t<decltype(f)>::Value>();
+                    });
+                return size;
+            }
+        }
+
+        template<typename P>
+        void Put(uint8_t*& out, const P& v)
+        {
+            std::memcpy(out, &v, sizeof(P));
+            out += sizeof(P);
+        }
+
+        template<typename P>
+        P Get(const uint8_t*& in)
+        {
+            P v;
+            std::memcpy(&v, in, sizeof(P));
+            in += sizeof(P);
+            return v;
+        }
+
+        template<typename T>
+        void EncodeRecord(const T& c, uint8_t* out, BlobWriter& b);
+
+        template<typename T>
+        void DecodeRecord(T& c, const uint8_t* in, BlobReader& b);
+
+        template<typename V>
+        void EncodeValue(const V& v, uint8_t*& out, BlobWriter& b)
+        {
+            if constexpr (std::is_same_v<V, std::string>)
+                Put(out, b.Str(v));
+            else if constexpr (std::is_same_v<V, StringId>)
+                Put(out, b.Str(v.Str()));
+            else if constexpr (kIsVector<V>)
+            {
+                using E = typename V::value_type;
+                if constexpr (std::is_same_v<E, std::string>)
+                {
+                    std::vector<StrRef> refs;
+                    refs.reserve(v.size());
+                    for (const auto& s : v)
+                        refs.push_back(b.Str(s));
+                    Put(out, b.Array(refs));
+                }
+                else if constexpr (kIsReflected<E>)
+                {
+                    constexpr size_t kSize = RecordSize<E>();
+                    std::vector<uint8_t> records(v.size() * kSize);
+                    for (size_t i = 0; i < v.size(); ++i)
+                        EncodeRecord(v[i], records.data() + i * kSize, b);
+
+                    ArrayRef ref = b.Array(records);
+                    ref.count = (uint32_t)v.size(); // records, not bytes
+                    Put(out, ref);
+                }
+                else
+                {
+                    Put(out, b.Array(v));
+                }
+            }
+            else if constexpr (kIsReflected<V>)
+            {
+                EncodeRecord(v, out, b);
+                out += RecordSize<V>();
+            }
+            else if constexpr (std::is_same_v<V, bool>)
+                Put(out, (uint8_t)v);
+            else
+                Put(out, v);
+        }
+
+        template<typename V>
+        void DecodeValue(V& v, const uint8_t*& in, BlobReader& b)
+        {
+            if constexpr (std::is_same_v<V, std::string>)
+                v = b.Str(Get<StrRef>(in));
+            else if constexpr (std::is_same_v<V, StringId>)
+                v = b.Id(Get<StrRef>(in));
+            else if constexpr (kIsVector<V>)
+            {
+                using E = typename V::value_type;
+                const ArrayRef ref = Get<ArrayRef>(in);
+                v.clear();
+                if constexpr (std::is_same_v<E, std::string>)
+                {
+                    if (const StrRef* refs = b.Array<StrRef>(ref))
+                    {
+                        v.reserve(ref.count);
+                        for (uint32_t i = 0; i < ref.count; ++i)
+                            v.emplace_back(b.Str(refs[i]));
+                    }
+                }
+                else if constexpr (kIsReflected<E>)
+                {
+                    constexpr size_t kSize = RecordSize<E>();
+                    if (const uint8_t* records = b.Records(ref, kSize))
+                    {
+                        v.resize(ref.count);
+                        for (uint32_t i = 0; i < ref.count; ++i)
+                            DecodeRecord(v[i], records + i * kSize, b);
+                    }
+                }
+                else
+                {
+                    v = b.Vec<E>(ref);
+                }
+            }
+            else if constexpr (kIsReflected<V>)
+            {
+                DecodeRecord(v, in, b);
+                in += RecordSize<V>();
+            }
+            else if constexpr (std::is_same_v<V, bool>)
+                v = Get<uint8_t>(in) != 0;
+            else
+                v = Get<V>(in);
+        }
+
+        template<typename T>
+        void EncodeRecord(const T& c, uint8_t* out, BlobWriter& b)
+        {
+            if constexpr (kCookPlain<T>)
+            {
+                T r = c;
+                ClearRuntimeHandles(r);
+                std::memcpy(out, &r, sizeof(T));
+            }
+            else
+            {
+                ForEachField<T>([&](const auto& f)
+                    {
+                        if (f.flags & kFieldSaved)
+                            EncodeValue(c.*f.member, out, b);
+                    });
+            }
+        }
+
+        // Into a default-constructed T: runtime fields keep their defaults
+        template<typename T>
+        void DecodeRecord(T& c, const uint8_t* in, BlobReader& b)
+        {
+            if constexpr (kCookPlain<T>)
+                std::memcpy(&c, in, sizeof(T));
+            else
+            {
+                ForEachField<T>([&](const auto& f)
+                    {
+                        if (f.flags & kFieldSaved)
+                            DecodeValue(c.*f.member, in, b);
+                    });
+            }
+        }
+
+        // Field names and encoded sizes (plus member offsets for plain records), so reordering or renaming
+        // a field invalidates old files too
+        void Mix(uint64_t& h, uint64_t v)
+        {
+            h ^= v;
+            h *= 1099511628211ull;
+        }
+
+        void MixName(uint64_t& h, const char* name)
+        {
+            for (const char* p = name; *p; ++p)
+                Mix(h, (uint8_t)*p);
+        }
+
+        // Not a constant expression (member pointer -> offset), hence the runtime layout hash
+        template<typename T, typename V>
+        size_t OffsetOf(V T::* member)
+        {
+            static const T probe{};
+            return (size_t)(reinterpret_cast<const uint8_t*>(&(probe.*member)) - reinterpret_cast<const uint8_t*>(&probe));
+        }
+
+        template<typename T>
+        void MixLayout(uint64_t& h)
+        {
+            Mix(h, RecordSize<T>() * 64 + alignof(T));
+            if constexpr (kCookPlain<T>)
+            {
+                // Copied as raw bytes: where each field sits matters, saved or not
+                ForEachField<T>([&h](const auto& f)
+                    {
+                        using V = typename std::decay_t<decltype(f)>::Value;
+                        MixName(h, f.name);
+                        Mix(h, OffsetOf(f.member));
+                        Mix(h, sizeof(V));
+                        if constexpr (kIsReflected<V>)
+                            MixLayout<V>(h);
+                    });
+            }
+            else
+            {
+                ForEachField<T>([&h](const auto& f)
+                    {
+                        using V = typename std::decay_t<decltype(f)>::Value;
+                        if (!(f.flags & kFieldSaved))
+                            return;
+
+                        MixName(h, f.name);
+                        Mix(h, EncodedSize<V>());
+
+                        if constexpr (kIsReflected<V>)
+                            MixLayout<V>(h);
+                        else if constexpr (kIsVector<V>)
+                        {
+                            if constexpr (kIsReflected<typename V::value_type>)
+                                MixLayout<typename V::value_type>(h);
+                            else
+                                Mix(h, sizeof(typename V::value_type));
+                        }
+                    });
+            }
+        }
+
+        template<typename... Ts>
+        uint64_t LayoutHash(ComponentList<Ts...>)
+        {
+            uint64_t h = 14695981039346656037ull;
+            Mix(h, kVersion);
+            (MixLayout<Ts>(h), ...);
+            return h;
+        }
+
+        // Block type = index in SerializedComponents
+        uint64_t CurrentLayoutHash()
+        {
+            static const uint64_t s_hash = LayoutHash(SerializedComponents{});
+            return s_hash;
+        }
+
+        // ---- writing ----
+
+        size_t AlignUp(size_t v) { return (v + kSectionAlign - 1) / kSectionAlign * kSectionAlign; }
+
+        struct FileWriter
+        {
+            std::vector<uint8_t> out;
+
+            size_t Section()
+            {
+                out.resize(AlignUp(out.size()));
+                return out.size();
+            }
+
+            template<typename T>
+            size_t Append(const T* items, size_t count)
+            {
+                const size_t at = Section();
+                const auto* p = reinterpret_cast<const uint8_t*>(items);
+                out.insert(out.end(), p, p + count * sizeof(T));
+                return at;
+            }
+        };
+
+        // rows by entity index (~0u = not written)
+        using RowMap = std::vector<uint32_t>;
+        constexpr uint32_t kNoRow = 0xFFFFFFFFu;
+
+        uint32_t RowOf(const RowMap& rows, entt::entity e)
+        {
+            const size_t index = (size_t)entt::to_entity(e);
+            return index < rows.size() ? rows[index] : kNoRow;
+        }
+
+        struct PendingBlock
+        {
+            BlockEntry entry;
+            std::vector<uint32_t> rows;
+            std::vector<uint8_t> records;
+        };
+
+        template<typename T>
+        void CollectBlock(uint32_t type, entt::registry& reg, const RowMap& rowMap, BlobWriter& blob, std::vector<PendingBlock>& blocks)
+        {
+            constexpr size_t kSize = RecordSize<T>();
+
+            // Views walk the pool back to front; keep the pool's own order
+            std::vector<entt::entity> ents;
+            for (auto e : reg.view<T>())
+            {
+                if (RowOf(rowMap, e) != kNoRow)
+                    ents.push_back(e);
+            }
+            if (ents.empty())
+                return;
+            std::reverse(ents.begin(), ents.end());
+
+            PendingBlock& block = blocks.emplace_back();
+            block.entry.type = type;
+            block.entry.recordSize = (uint32_t)kSize;
+            block.entry.count = (uint32_t)ents.size();
+            block.rows.reserve(ents.size());
+            block.records.resize(ents.size() * kSize);
+
+            for (size_t i = 0; i < ents.size(); ++i)
+            {
+                block.rows.push_back(RowOf(rowMap, ents[i]));
+                EncodeRecord(reg.get<T>(ents[i]), block.records.data() + i * kSize, blob);
+            }
+        }
+
+        template<typename... Ts>
+        void CollectBlocks(ComponentList<Ts...>, entt::registry& reg, const RowMap& rows, BlobWriter& blob, std::vector<PendingBlock>& blocks)
+        {
+            uint32_t type = 0;
+            (CollectBlock<Ts>(type++, reg, rows, blob, blocks), ...);
+        }
+
+        // ---- reading ----
+
+        struct MappedView
+        {
+            const uint8_t* data = nullptr;
+            size_t size = 0;
+
+            template<typename T>
+            const T* At(uint64_t offset, size_t count) const
+            {
+                if (offset % alignof(T) != 0 || offset > size || (size - offset) / sizeof(T) < count)
+                    return nullptr;
+                return reinterpret_cast<const T*>(data + offset);
+            }
+        };
+
+        using Inserter = std::function<void(entt::registry&, const std::vector<entt::entity>&)>;
+
+        bool HasDuplicateIds(const uint64_t* ids, size_t count)
+        {
+            std::vector<uint64_t> sorted(ids, ids + count);
+            std::sort(sorted.begin(), sorted.end());
+            return std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end();
+        }
+
+        // Validates and decodes one block; the returned inserter does the registry work later, so a bad
+        // file is rejected before the scene is touched
+        template<typename T>
+        bool DecodeBlock(const BlockEntry& block, const MappedView& file, uint32_t entityCount, BlobReader& blob, std::vector<Inserter>& out)
+        {
+            constexpr size_t kSize = RecordSize<T>();
+
+            if (block.recordSize != kSize)
+                return false;
+
+            const uint32_t* rows = file.At<uint32_t>(block.rowsOffset, block.count);
+            if (!rows || block.count > entityCount)
+                return false;
+
+            // One component per entity: a repeated row would make the range insert assert (or, in release,
+            // corrupt the pool)
+            std::vector<bool> seen(entityCount);
+            for (uint32_t i = 0; i < block.count; ++i)
+            {
+                if (rows[i] >= entityCount || seen[rows[i]])
+                    return false;
+                seen[rows[i]] = true;
+            }
+
+            const uint32_t count = block.count;
+            if constexpr (kCookPlain<T>)
+            {
+                const T* records = file.At<T>(block.recordsOffset, count);
+                if (!records)
+                    return false;
+
+                // Straight from the mapped records into the pool
+                out.push_back([rows, records, count](entt::registry& reg, const std::vector<entt::entity>& ents)
+                    {
+                        std::vector<entt::entity> targets(count);
+                        for (uint32_t i = 0; i < count; ++i)
+                            targets[i] = ents[rows[i]];
+                        reg.insert<T>(targets.begin(), targets.end(), records);
+                    });
+            }
+            else
+            {
+                const uint8_t* records = file.At<uint8_t>(block.recordsOffset, (size_t)count * kSize);
+                if (!records)
+                    return false;
+
+                std::vector<T> comps(count);
+                for (uint32_t i = 0; i < count; ++i)
+                    DecodeRecord(comps[i], records + (size_t)i * kSize, blob);
+
+                out.push_back([rows, count, comps = std::move(comps)](entt::registry& reg, const std::vector<entt::entity>& ents) mutable
+                    {
+                        std::vector<entt::entity> targets(count);
+                        for (uint32_t i = 0; i < count; ++i)
+                            targets[i] = ents[rows[i]];
+                        reg.insert<T>(targets.begin(), targets.end(), std::make_move_iterator(comps.begin()));
+                    });
+            }
+            return true;
+        }
+
+        template<typename... Ts>
+        bool DecodeBlockOfType(ComponentList<Ts...>, const BlockEntry& block, const MappedView& file, uint32_t entityCount,
+            BlobReader& blob, std::vector<Inserter>& out)
+        {
+            uint32_t type = 0;
+            bool known = false, ok = false;
+            ((type++ == block.type ? (known = true, ok = DecodeBlock<Ts>(block, file, entityCount, blob, out)) : false), ...);
+            return known && ok;
+        }
+
+        bool SourcesUpToDate(const MappedView& file, const FileHeader& header, BlobReader& blob)
+        {
+            namespace fs = std::filesystem;
+
+            const SourceEntry* sources = file.At<SourceEntry>(header.sourcesOffset, header.sourceCount);
+            if (!sources)
+                return false;
+
+            for (uint32_t i = 0; i < header.sourceCount; ++i)
+            {
+                const std::string_view path = blob.Str(sources[i].path);
+                if (!blob.ok)
+                    return false;
+
+                std::error_code ec;
+                const fs::path p(path);
+                const bool exists = fs::is_regular_file(p, ec);
+                if (exists != (sources[i].exists != 0))
+                    return false;
+                if (!exists)
+                    continue;
+
+                const uint64_t size = (uint64_t)fs::file_size(p, ec);
+                const int64_t writeTime = (int64_t)fs::last_write_time(p, ec).time_since_epoch().count();
+                if (ec || size != sources[i].size || writeTime != sources[i].writeTime)
+                    return false;
+            }
+            return true;
+        }
+
+        // Header + sources check shared by Load and IsUpToDate
+        bool OpenCooked(MappedFile& mapped, const std::string& binPath, MappedView& file, FileHeader& header, BlobReader& blob)
+        {
+            if (!mapped.Open(binPath) || mapped.Size() < sizeof(FileHeader))
+                return false;
+
+            file = { mapped.Data(), mapped.Size() };
+            std::memcpy(&header, file.data, sizeof(header));
+            if (header.magic != kMagic || header.version != kVersion || header.layoutHash != CurrentLayoutHash())
+                return false;
+
+            const uint8_t* blobData = file.At<uint8_t>(header.blobOffset, header.blobSize);
+            if (!blobData)
+                return false;
+            blob.data = blobData;
+            blob.size = (size_t)header.blobSize;
+
+            return SourcesUpToDate(file, header, blob);
+        }
+    }
+
+    std::string CookedScene::PathFor(const std::string& jsonPath)
+    {
+        std::filesystem::path p(jsonPath);
+        if (p.extension() == ".json")
+            p.replace_extension(".bin");
+        else
+            p += ".bin";
+        return p.string();
+    }
+
+    bool CookedScene::IsUpToDate(const std::string& binPath)
+    {
+        MappedFile mapped;
+        MappedView file;
+        FileHeader header;
+        BlobReader blob;
+        return OpenCooked(mapped, binPath, file, header, blob);
+    }
+
+    bool CookedScene::Write(Scene& scene, const std::string& binPath, const std::vector<std::string>& sources)
+    {
+        MY2D_PROFILE_SCOPE("CookedScene::Write");
+        MY2D_ALLOC_SCOPE(Scene);
+
+        namespace fs = std::filesystem;
+        auto& reg = scene.Registry();
+
+        // Rows follow creation order, so the cooked load creates entities in the same order as the JSON one
+        std::vector<entt::entity> ents;
+        std::vector<uint64_t> ids;
+        for (auto [e, id] : reg.view<IdComponent>().each())
+            ents.push_back(e);
+        std::reverse(ents.begin(), ents.end());
+
+        RowMap rows;
+        ids.reserve(ents.size());
+        for (entt::entity e : ents)
+        {
+            const size_t index = (size_t)entt::to_entity(e);
+            if (index >= rows.size())
+                rows.resize(index + 1, kNoRow);
+            rows[index] = (uint32_t)ids.size();
+            ids.push_back(reg.get<IdComponent>(e).id);
+        }
+
+        // Load rejects these, so a cooked copy would never be used
+        if (HasDuplicateIds(ids.data(), ids.size()))
+        {
+            spdlog::warn("CookedScene: not cooking '{}', the scene has duplicate entity ids", binPath);
+            return false;
+        }
+
+        std::vector<LinkEntry> links;
+        for (auto [e, h] : reg.view<HierarchyComponent>().each())
+        {
+            const uint32_t child = RowOf(rows, e);
+            const uint32_t parent = (h.parent != entt::null) ? RowOf(rows, h.parent) : kNoRow;
+            if (child != kNoRow && parent != kNoRow)
+                links.push_back({ child, parent });
+        }
+
+        BlobWriter blob;
+        std::vector<PendingBlock> blocks;
+        CollectBlocks(SerializedComponents{}, reg, rows, blob, blocks);
+
+        std::vector<SourceEntry> sourceEntries;
+        for (const std::string& src : sources)
+        {
+            SourceEntry& s = sourceEntries.emplace_back();
+            s.path = blob.Str(src);
+
+            std::error_code ec;
+            const fs::path p(src);
+            s.exists = fs::is_regular_file(p, ec) ? 1u : 0u;
+            if (s.exists)
+            {
+                s.size = (uint64_t)fs::file_size(p, ec);
+                s.writeTime = (int64_t)fs::last_write_time(p, ec).time_since_epoch().count();
+            }
+        }
+
+        FileHeader header;
+        header.layoutHash = CurrentLayoutHash();
+        header.entityCount = (uint32_t)ids.size();
+        header.linkCount = (uint32_t)links.size();
+        header.blockCount = (uint32_t)blocks.size();
+        header.sourceCount = (uint32_t)sourceEntries.size();
+
+        FileWriter w;
+        w.out.resize(sizeof(FileHeader));
+        header.idsOffset = w.Append(ids.data(), ids.size());
+        header.linksOffset = w.Append(links.data(), links.size());
+
+        // Block table first (fixed size), data after it
+        header.blocksOffset = w.Section();
+        w.out.resize(w.out.size() + blocks.size() * sizeof(BlockEntry));
+        for (PendingBlock& block : blocks)
+        {
+            block.entry.rowsOffset = w.Append(block.rows.data(), block.rows.size());
+            block.entry.recordsOffset = w.Append(block.records.data(), block.records.size());
+        }
+        for (size_t i = 0; i < blocks.size(); ++i)
+            std::memcpy(w.out.data() + header.blocksOffset + i * sizeof(BlockEntry), &blocks[i].entry, sizeof(BlockEntry));
+
+        header.sourcesOffset = w.Append(sourceEntries.data(), sourceEntries.size());
+        header.blobOffset = w.Append(blob.data.data(), blob.data.size());
+        header.blobSize = blob.data.size();
+        std::memcpy(w.out.data(), &header, sizeof(header));
+
+        // Write next to it and swap in, so a reader never maps a half-written file
+        const fs::path target(binPath);
+        fs::path tmp = target;
+        tmp += ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                spdlog::warn("CookedScene: cannot write '{}'", tmp.string());
+                return false;
+            }
+            out.write(reinterpret_cast<const char*>(w.out.data()), (std::streamsize)w.out.size());
+            if (!out)
+            {
+                spdlog::warn("CookedScene: write failed for '{}'", tmp.string());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        fs::rename(tmp, target, ec);
+        if (ec)
+        {
+            spdlog::warn("CookedScene: cannot replace '{}': {}", target.string(), ec.message());
+            fs::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool CookedScene::Load(Scene& scene, const std::string& binPath)
+    {
+        MY2D_PROFILE_SCOPE("CookedScene::Load");
+        MY2D_ALLOC_SCOPE(Scene);
+
+        MappedFile mapped;
+        MappedView file;
+        FileHeader header;
+        BlobReader blob;
+        if (!OpenCooked(mapped, binPath, file, header, blob))
+            return false;
+
+        const uint64_t* ids = file.At<uint64_t>(header.idsOffset, header.entityCount);
+        const LinkEntry* links = file.At<LinkEntry>(header.linksOffset, header.linkCount);
+        const BlockEntry* blocks = file.At<BlockEntry>(header.blocksOffset, header.blockCount);
+        if (!ids || !links || !blocks || HasDuplicateIds(ids, header.entityCount))
+        {
+            spdlog::warn("CookedScene: '{}' is corrupt", binPath);
+            return false;
+        }
+
+        for (uint32_t i = 0; i < header.linkCount; ++i)
+        {
+            if (links[i].child >= header.entityCount || links[i].parent >= header.entityCount)
+            {
+                spdlog::warn("CookedScene: '{}' is corrupt", binPath);
+                return false;
+            }
+        }
+
+        std::vector<Inserter> inserters;
+        inserters.reserve(header.blockCount);
+        std::vector<bool> seenTypes; // one block per component type, or the inserts would collide
+        for (uint32_t i = 0; i < header.blockCount; ++i)
+        {
+            const uint32_t type = blocks[i].type;
+            const bool repeated = type < seenTypes.size() && seenTypes[type];
+            if (repeated || !DecodeBlockOfType(SerializedComponents{}, blocks[i], file, header.entityCount, blob, inserters) || !blob.ok)
+            {
+                spdlog::warn("CookedScene: '{}' is corrupt", binPath);
+                return false;
+            }
+
+            if (type >= seenTypes.size())
+                seenTypes.resize((size_t)type + 1);
+            seenTypes[type] = true;
+        }
+
+        // Everything checked: build the scene
+        auto& reg = scene.Registry();
+        reg.clear();
+
+        std::vector<entt::entity> ents;
+        scene.CreateEntitiesWithIds(ids, header.entityCount, ents);
+
+        for (const Inserter& insert : inserters)
+            insert(reg, ents);
+
+        for (uint32_t i = 0; i < header.linkCount; ++i)
+            scene.SetParent(ents[links[i].child], ents[links[i].parent]);
+
+        return true;
+    }
+}
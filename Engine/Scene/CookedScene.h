@@ -0,0 +1,40 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace my2d
+{
+    class Scene;
+
+    // .scene.bin: a scene as it comes out of the JSON loader (prefabs applied, runtime fields at their
+    // defaults), stored as fixed-layout component records plus one string/array table. The records are
+    // generated from the component tables in ComponentRegistry.h.
+    //
+    // Load() maps the file and creates everything in bulk: ids first, then one range insert per
+    // component type (plain components straight out of the mapped records). JSON stays the authoring
+    // format: SceneSerializer::Cook writes the cooked file offline, and SceneSerializer::LoadFromFile uses
+    // it when it is up to date (falling back to the JSON, re-cooking only with auto-cook on).
+    //
+    // A cooked file lists the files it was built from (scene json + prefabs, with size and write time)
+    // and a hash of the record layouts (saved field names and sizes, plus every field's offset in records
+    // copied as raw bytes); either changing makes it stale.
+    // Bump kVersion in the .cpp when a field changes meaning without changing name or size.
+    class CookedScene
+    {
+    public:
+        // "Scenes/room.scene.json" -> "Scenes/room.scene.bin"
+        static std::string PathFor(const std::string& jsonPath);
+
+        // Every entity with an IdComponent. sources: the files the scene was loaded from; paths that
+        // don't exist are recorded as missing (appearing later also makes the file stale). Refuses a scene
+        // with duplicate ids.
+        static bool Write(Scene& scene, const std::string& binPath, const std::vector<std::string>& sources);
+
+        // False, with the scene untouched, when the file is missing, stale or corrupt (including duplicate
+        // ids, or an entity listed twice in one component block).
+        static bool Load(Scene& scene, const std::string& binPath);
+
+        // Missing or stale (sources changed, other engine build); doesn't read past the header/sources.
+        static bool IsUpToDate(const std::string& binPath);
+    };
+}
@@ -0,0 +1,11 @@
+#include "pch.h"
+#include "Scene/Prefab.h"
+#include "Scene/SceneSerializer.h"
+
+namespace my2d
+{
+    bool Prefab::LoadFromFile(const std::string& path)
+    {
+        return SceneSerializer::LoadPrefab(path, *this);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <entt/entt.hpp>
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Scene/Components.h"
+
+namespace my2d
+{
+    // A prefab file parsed once into ready-to-copy components (AssetManager::GetPrefab caches them).
+    // Stamp() range-inserts every component onto freshly created entities; Scene::Instantiate is the
+    // usual way in. Id/Tag/Transform are handled by the caller (Tag() and Transform() are the defaults).
+    class Prefab
+    {
+    public:
+        // {"prefabVersion":1, "entity": {...}} or the entity object directly
+        bool LoadFromFile(const std::string& path);
+
+        const std::string& Path() const { return m_path; }
+        const std::string& Tag() const { return m_tag; }
+        const TransformComponent& Transform() const { return m_transform; }
+        size_t ComponentCount() const { return m_stamps.size(); }
+
+        // Entities in [first, last) must not have any of the prefab's components yet.
+        void Stamp(entt::registry& reg, const entt::entity* first, const entt::entity* last) const
+        {
+            for (const auto& stamp : m_stamps)
+                stamp(reg, first, last);
+        }
+
+        // Used by the loader (SceneSerializer::LoadPrefab)
+        void SetPath(std::string path) { m_path = std::move(path); }
+        void SetTag(std::string tag) { m_tag = std::move(tag); }
+        void SetTransform(const TransformComponent& tc) { m_transform = tc; }
+
+        template<typename T>
+        void AddComponent(T value)
+        {
+            m_stamps.push_back([value = std::move(value)](entt::registry& reg, const entt::entity* first, const entt::entity* last)
+                {
+                    reg.insert<T>(first, last, value);
+                });
+        }
+
+    private:
+        std::string m_path;
+        std::string m_tag = "Entity";
+        TransformComponent m_transform;
+        std::vector<std::function<void(entt::registry&, const entt::entity*, const entt::entity*)>> m_stamps;
+    };
+}
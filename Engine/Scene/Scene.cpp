@@ -3,11 +3,17 @@
 #include "Core/Engine.h"
 #include "Assets/AssetManager.h"
 #include "Renderer/Renderer2D.h"
+#include "Renderer/RenderSnapshot.h"
 #include "Renderer/Texture2D.h"
 #include "Renderer/TilemapRenderer2D.h"
 #include "Renderer/AnimationSystem.h"
+#include "Physics/PhysicsSystem.h"
+#include "Scene/Prefab.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 #include <random>
 #include <Renderer/SpriteAtlas.h>
@@ -21,20 +27,133 @@ namespace my2d
             return (uint32_t)rd();
         }();
 
-    static uint32_t s_counter = 1;
+    // Atomic: scenes can be created and loaded from more than one thread at a time
+    static std::atomic<uint32_t> s_counter{ 1 };
 
     static uint64_t GenerateId()
     {
         // Upper 32 bits = run salt, lower 32 bits = incrementing counter
-        return (uint64_t(s_salt) << 32) | uint64_t(s_counter++);
+        return (uint64_t(s_salt) << 32) | uint64_t(s_counter.fetch_add(1, std::memory_order_relaxed));
     }
 
     static void TrackLoadedId(uint64_t id)
     {
         const uint32_t hi = uint32_t(id >> 32);
         const uint32_t lo = uint32_t(id & 0xFFFFFFFFu);
-        if (hi == s_salt)
-            s_counter = std::max(s_counter, lo + 1);
+        if (hi != s_salt)
+            return;
+
+        // Atomic max: never moves the counter back under an id another thread just generated
+        uint32_t current = s_counter.load(std::memory_order_relaxed);
+        while (current < lo + 1 && !s_counter.compare_exchange_weak(current, lo + 1, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Scene::Scene()
+    {
+        m_registry.on_construct<IdComponent>().connect<&Scene::OnIdConstruct>(*this);
+        m_registry.on_update<IdComponent>().connect<&Scene::OnIdConstruct>(*this);
+        m_registry.on_destroy<IdComponent>().connect<&Scene::OnIdDestroy>(*this);
+
+        constexpr auto addTag = &Scene::OnNameConstruct<TagComponent, &TagComponent::tag, &Scene::m_tagIndex>;
+        constexpr auto removeTag = &Scene::OnNameDestroy<TagComponent, &TagComponent::tag, &Scene::m_tagIndex>;
+        m_registry.on_construct<TagComponent>().connect<addTag>(*this);
+        m_registry.on_update<TagComponent>().connect<addTag>(*this);
+        m_registry.on_destroy<TagComponent>().connect<removeTag>(*this);
+
+        constexpr auto addSpawn = &Scene::OnNameConstruct<PlayerSpawnComponent, &PlayerSpawnComponent::name, &Scene::m_spawnIndex>;
+        constexpr auto removeSpawn = &Scene::OnNameDestroy<PlayerSpawnComponent, &PlayerSpawnComponent::name, &Scene::m_spawnIndex>;
+        m_registry.on_construct<PlayerSpawnComponent>().connect<addSpawn>(*this);
+        m_registry.on_update<PlayerSpawnComponent>().connect<addSpawn>(*this);
+        m_registry.on_destroy<PlayerSpawnComponent>().connect<removeSpawn>(*this);
+
+        m_renderQueue.Connect(m_registry);
+        m_spatial.Connect(m_registry);
+        m_transforms.Connect(m_registry);
+        m_hierarchy.Connect(m_registry);
+
+        m_registry.on_construct<SpriteRendererComponent>().connect<&Scene::OnSpriteChanged>(*this);
+        m_registry.on_update<SpriteRendererComponent>().connect<&Scene::OnSpriteChanged>(*this);
+
+        // Create the owning group up front so the pools are packed from the first entity on
+        PhysicsGroup();
+    }
+
+    template<typename C, StringId C::*Field, Scene::NameIndex Scene::*Index>
+    void Scene::OnNameConstruct(entt::registry& reg, entt::entity e)
+    {
+        const StringId name = reg.get<C>(e).*Field;
+        NameIndex& index = this->*Index;
+
+        auto [first, last] = index.equal_range(name);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second == e)
+                return;
+        }
+        index.emplace(name, e);
+    }
+
+    template<typename C, StringId C::*Field, Scene::NameIndex Scene::*Index>
+    void Scene::OnNameDestroy(entt::registry& reg, entt::entity e)
+    {
+        const StringId name = reg.get<C>(e).*Field;
+        NameIndex& index = this->*Index;
+
+        auto [first, last] = index.equal_range(name);
+        for (auto it = first; it != last; ++it)
+        {
+            if (it->second == e)
+            {
+                index.erase(it);
+                return;
+            }
+        }
+    }
+
+    // Index entries outlive in-place edits (replace/patch only add the new name); check the component still agrees
+    template<typename C, StringId C::*Field>
+    static bool HasName(const entt::registry& reg, entt::entity e, StringId name)
+    {
+        if (!reg.valid(e)) return false;
+        const C* c = reg.try_get<C>(e);
+        return c && (c->*Field) == name;
+    }
+
+    void Scene::OnIdConstruct(entt::registry& reg, entt::entity e)
+    {
+        const uint64_t id = reg.get<IdComponent>(e).id;
+
+        auto [it, inserted] = m_idIndex.try_emplace(id, e);
+        if (!inserted && it->second != e)
+        {
+            if (reg.valid(it->second) && reg.all_of<IdComponent>(it->second) && reg.get<IdComponent>(it->second).id == id)
+                spdlog::warn("Scene: duplicate entity id {:016x}, lookups now return the newer entity", id);
+            it->second = e;
+        }
+    }
+
+    void Scene::OnIdDestroy(entt::registry& reg, entt::entity e)
+    {
+        const uint64_t id = reg.get<IdComponent>(e).id;
+
+        // Only drop the entry if it still points at this entity (a duplicate may have taken it over)
+        auto it = m_idIndex.find(id);
+        if (it != m_idIndex.end() && it->second == e)
+            m_idIndex.erase(it);
+    }
+
+    entt::entity Scene::LookupId(uint64_t id) const
+    {
+        auto it = m_idIndex.find(id);
+        if (it == m_idIndex.end())
+            return entt::null;
+
+        // Entries go stale if an IdComponent is patched in place (old id is not known then); verify
+        const entt::entity e = it->second;
+        const IdComponent* idc = m_registry.valid(e) ? m_registry.try_get<IdComponent>(e) : nullptr;
+        return (idc && idc->id == id) ? e : entt::null;
     }
 
     Entity Scene::CreateEntity(const std::string& name)
@@ -51,141 +170,302 @@ namespace my2d
 
         entity.Add<IdComponent>(IdComponent{ id });
         entity.Add<TransformComponent>();
-        entity.Add<TagComponent>(TagComponent{ name });
+        entity.Add<TagComponent>(TagComponent{ StringId(name) });
 
         return entity;
     }
 
+    void Scene::CreateEntitiesWithIds(const uint64_t* ids, size_t count, std::vector<entt::entity>& out)
+    {
+        out.resize(count);
+        if (count == 0)
+            return;
+
+        m_registry.create(out.begin(), out.end());
+
+        m_spawnIds.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            TrackLoadedId(ids[i]);
+            m_spawnIds[i].id = ids[i];
+        }
+        ReserveIds(count);
+
+        m_registry.insert<IdComponent>(out.begin(), out.end(), m_spawnIds.begin());
+    }
+
     Entity Scene::FindEntityById(uint64_t id)
     {
-        auto view = m_registry.view<IdComponent>();
-        for (auto e : view)
+        const entt::entity e = LookupId(id);
+        return (e != entt::null) ? Entity(e, this) : Entity{};
+    }
+
+    void Scene::FindEntitiesByIds(const std::vector<uint64_t>& ids, std::vector<entt::entity>& out) const
+    {
+        out.resize(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+            out[i] = LookupId(ids[i]);
+    }
+
+    Entity Scene::FindEntityByTag(StringId tag)
+    {
+        auto [first, last] = m_tagIndex.equal_range(tag);
+        for (auto it = first; it != last; ++it)
         {
-            if (view.get<IdComponent>(e).id == id)
-                return Entity(e, this);
+            if (HasName<TagComponent, &TagComponent::tag>(m_registry, it->second, tag))
+                return Entity(it->second, this);
+        }
+        return {};
+    }
+
+    void Scene::FindEntitiesByTag(StringId tag, std::vector<entt::entity>& out) const
+    {
+        out.clear();
+        auto [first, last] = m_tagIndex.equal_range(tag);
+        for (auto it = first; it != last; ++it)
+        {
+            if (HasName<TagComponent, &TagComponent::tag>(m_registry, it->second, tag))
+                out.push_back(it->second);
+        }
+    }
+
+    Entity Scene::FindSpawn(StringId name)
+    {
+        auto [first, last] = m_spawnIndex.equal_range(name);
+        for (auto it = first; it != last; ++it)
+        {
+            if (HasName<PlayerSpawnComponent, &PlayerSpawnComponent::name>(m_registry, it->second, name))
+                return Entity(it->second, this);
         }
         return {};
     }
 
     void Scene::DestroyEntity(Entity e)
     {
-        if (e)
-            m_registry.destroy(e.Handle());
+        if (!e)
+            return;
+
+        // Children go with their parent
+        std::vector<entt::entity> doomed;
+        m_hierarchy.CollectDescendants(m_registry, e.Handle(), doomed);
+        doomed.push_back(e.Handle());
+        m_registry.destroy(doomed.begin(), doomed.end());
+    }
+
+    void Scene::Instantiate(const Prefab& prefab, size_t count, const TransformComponent* transforms, std::vector<entt::entity>* out)
+    {
+        if (count == 0)
+            return;
+
+        MY2D_PROFILE_SCOPE("Scene::Instantiate");
+        MY2D_ALLOC_SCOPE(Scene);
+
+        auto& ents = m_spawnScratch;
+        ents.resize(count);
+        m_registry.create(ents.begin(), ents.end());
+
+        m_spawnIds.resize(count);
+        for (IdComponent& id : m_spawnIds)
+            id.id = GenerateId();
+        ReserveIds(count);
+
+        const entt::entity* first = ents.data();
+        const entt::entity* last = first + count;
+
+        m_registry.insert<IdComponent>(first, last, m_spawnIds.begin());
+        if (transforms)
+            m_registry.insert<TransformComponent>(first, last, transforms);
+        else
+            m_registry.insert<TransformComponent>(first, last, prefab.Transform());
+        m_registry.insert<TagComponent>(first, last, TagComponent{ StringId(prefab.Tag()) });
+        m_registry.insert<PrefabComponent>(first, last, PrefabComponent{ prefab.Path() });
+
+        prefab.Stamp(m_registry, first, last);
+
+        if (out)
+            out->insert(out->end(), first, last);
+    }
+
+    bool Scene::SetParent(entt::entity child, entt::entity parent)
+    {
+        if (!m_hierarchy.SetParent(m_registry, child, parent))
+            return false;
+
+        for (entt::entity e : m_hierarchy.LastUpdated())
+            OnWorldMoved(e);
+        return true;
+    }
+
+    void Scene::UpdateWorldTransforms(bool fixedStep)
+    {
+        for (entt::entity e : m_hierarchy.Update(m_registry, fixedStep))
+            OnWorldMoved(e);
+    }
+
+    void Scene::OnWorldMoved(entt::entity e)
+    {
+        m_transforms.MarkMoved(e);
+        m_spatial.MarkChanged(e);
+        if (m_registry.all_of<RigidBody2DComponent>(e))
+            m_movedChildBodies.push_back(e);
     }
 
     void Scene::OnUpdate(Engine& engine, double dt)
     {
+        MY2D_ALLOC_SCOPE(Scene);
         AnimationSystem_Update(engine, *this, (float)dt);
     }
 
-    void Scene::OnRender(Engine& engine)
+    void Scene::OnSpriteChanged(entt::registry& reg, entt::entity e)
     {
-        auto spriteView = m_registry.view<TransformComponent, SpriteRendererComponent>();
-        auto tilemapView = m_registry.view<TransformComponent, TilemapComponent>();
+        (void)reg;
+        const size_t index = (size_t)entt::to_entity(e);
+        if (index < m_spriteGeometry.size())
+            m_spriteGeometry[index].entity = entt::null;
+    }
 
-        // Determine layer range across tilemap layers + sprites
-        bool hasAny = false;
-        int minLayer = 0;
-        int maxLayer = 0;
+    // Cached pivot/offset math; only entities whose transform version moved (or whose sprite changed) redo it
+    static const SpriteGeometry& GetSpriteGeometry(std::vector<SpriteGeometry>& cache, const TransformTracker& transforms,
+        entt::entity e, const TransformComponent& tc, const SpriteRendererComponent& sc)
+    {
+        const size_t index = (size_t)entt::to_entity(e);
+        if (index >= cache.size())
+            cache.resize(index + 1);
+
+        SpriteGeometry& g = cache[index];
+        const uint32_t version = transforms.Version(e);
+        if (g.entity == e && g.transformVersion == version)
+            return g;
+
+        const glm::vec2 worldSize = { sc.size.x * tc.scale.x, sc.size.y * tc.scale.y };
+        const glm::vec2 pivotScaled = { sc.pivot.x * worldSize.x, sc.pivot.y * worldSize.y };
+        const glm::vec2 offsetScaled = { sc.offset.x * tc.scale.x, sc.offset.y * tc.scale.y };
+
+        g.entity = e;
+        g.transformVersion = version;
+        g.localOffset = offsetScaled - pivotScaled;
+        g.worldSize = worldSize;
+        return g;
+    }
 
-        for (auto e : spriteView)
-        {
-            const auto& s = spriteView.get<SpriteRendererComponent>(e);
-            if (!hasAny) { minLayer = maxLayer = s.layer; hasAny = true; }
-            else { minLayer = std::min(minLayer, s.layer); maxLayer = std::max(maxLayer, s.layer); }
-        }
+    // Sprites can draw up to one step of movement away from their grid bounds (interpolation)
+    static constexpr float CullMarginPx = 64.0f;
 
-        for (auto e : tilemapView)
+    // Runs the view query that ForEachDrawable culls sprites against
+    static void QueryVisible(SpatialGrid& grid, entt::registry& registry, const Camera2D& cam)
+    {
+        glm::vec2 viewMin, viewMax;
+        cam.WorldBounds(viewMin, viewMax);
+        grid.QueryAABB(registry, viewMin - glm::vec2(CullMarginPx), viewMax + glm::vec2(CullMarginPx));
+    }
+
+    // Walks tilemap layers + sprites in render queue order (layer, then tiles before sprites, then texture).
+    // tiles(tm, tc, layer) for each tilemap layer, sprite(tex, pos, size, src, rot, flip, tint) for each sprite.
+    // Sprites outside the last QueryVisible() are skipped; tile layers cull per tile.
+    template<typename TileFn, typename SpriteFn>
+    static void ForEachDrawable(entt::registry& registry, RenderQueue& queue, const SpatialGrid& visible,
+        std::vector<SpriteGeometry>& geometry, const TransformTracker& transforms,
+        AssetManager& assets, float alpha, TileFn&& tiles, SpriteFn&& sprite)
+    {
+        for (const RenderQueue::Item& item : queue.Update(registry))
         {
-            const auto& tm = tilemapView.get<TilemapComponent>(e);
-            for (const auto& layer : tm.layers)
+            const entt::entity e = item.entity;
+            if (item.tileLayer == RenderQueue::SpriteItem && !visible.InLastQuery(e))
+                continue;
+
+            const TransformComponent* local = registry.try_get<TransformComponent>(e);
+            if (!local) continue;
+
+            const WorldTransformComponent* wt = registry.try_get<WorldTransformComponent>(e);
+            const TransformComponent* transform = wt ? &wt->world : local;
+
+            // Tile layer
+            if (item.tileLayer != RenderQueue::SpriteItem)
+            {
+                // Layers removed in place without MarkSpriteChanged: skipped until it's re-added
+                const auto* tm = registry.try_get<TilemapComponent>(e);
+                if (tm && item.tileLayer < tm->layers.size())
+                    tiles(*tm, *transform, tm->layers[item.tileLayer]);
+                continue;
+            }
+
+            // Sprite
+            const auto* sprite = registry.try_get<SpriteRendererComponent>(e);
+            if (!sprite) continue;
+            const auto& sc = *sprite;
+            // Children blend their cached world transform; bodies on children follow the parent
+            const TransformComponent tc = wt
+                ? Hierarchy_InterpolatedTransform(*wt, alpha)
+                : Physics_InterpolatedTransform(*transform, registry.try_get<RigidBody2DComponent>(e), alpha);
+
+            // Pivot/offset drawing (scale isn't interpolated, so the cache keys on the real transform)
+            const SpriteGeometry& g = GetSpriteGeometry(geometry, transforms, e, *transform, sc);
+            const glm::vec2& worldSize = g.worldSize;
+            const glm::vec2 drawPos = tc.position + g.localOffset;
+
+            // Atlas mode
+            if (!sc.atlasPath.empty() && !sc.regionName.empty())
             {
-                if (!hasAny) { minLayer = maxLayer = layer.layer; hasAny = true; }
-                else { minLayer = std::min(minLayer, layer.layer); maxLayer = std::max(maxLayer, layer.layer); }
+                auto atlas = assets.GetAtlas(sc.atlasPath);
+                if (!atlas) continue;
+
+                const SpriteRegion* region = atlas->GetRegion(sc.regionName);
+                if (!region || !region->texture) continue;
+
+                sprite(region->texture, drawPos, worldSize, &region->rect, tc.rotationDeg, sc.flip, sc.tint);
+            }
+            else
+            {
+                // Legacy texturePath mode
+                if (sc.texturePath.empty()) continue;
+
+                auto tex = assets.GetTexture(sc.texturePath);
+                if (!tex) continue;
+
+                const SDL_Rect* src = sc.useSourceRect ? &sc.sourceRect : nullptr;
+                sprite(tex, drawPos, worldSize, src, tc.rotationDeg, sc.flip, sc.tint);
             }
         }
+    }
 
-        if (!hasAny) return;
+    void Scene::OnRender(Engine& engine, float alpha)
+    {
+        MY2D_PROFILE_SCOPE("Scene::OnRender");
+        MY2D_ALLOC_SCOPE(Renderer);
 
         TilemapRenderer2D tileRenderer;
+        Renderer2D& renderer = engine.GetRenderer2D();
 
-        // Render by layer in ascending order (shared integer layer space)
-        for (int L = minLayer; L <= maxLayer; ++L)
-        {
-            // Tilemaps for this layer
-            for (auto e : tilemapView)
+        QueryVisible(m_spatial, m_registry, renderer.GetCamera());
+        ForEachDrawable(m_registry, m_renderQueue, m_spatial, m_spriteGeometry, m_transforms, engine.GetAssets(), alpha,
+            [&](const TilemapComponent& tm, const TransformComponent& tc, const TileLayer& layer)
             {
-                auto& tc = tilemapView.get<TransformComponent>(e);
-                auto& tm = tilemapView.get<TilemapComponent>(e);
-
-                
-                for (const auto& layer : tm.layers)
-                {
-                    if (layer.layer != L) continue;
-                    tileRenderer.DrawLayer(tm, tc, layer, engine.GetAssets(), engine.GetRenderer2D());
-                }
-            }
+                tileRenderer.DrawLayer(tm, tc, layer, engine.GetAssets(), renderer);
+            },
+            [&](const std::shared_ptr<Texture2D>& tex, const glm::vec2& pos, const glm::vec2& size,
+                const SDL_Rect* src, float rotationDeg, SDL_RendererFlip flip, SDL_Color tint)
+            {
+                renderer.DrawTexture(*tex, pos, size, src, rotationDeg, flip, tint);
+            });
+    }
 
-            // Sprites for this layer
-            for (auto e : spriteView)
+    void Scene::BuildRenderSnapshot(Engine& engine, float alpha, RenderSnapshot& out)
+    {
+        MY2D_PROFILE_SCOPE("Scene::BuildRenderSnapshot");
+        MY2D_ALLOC_SCOPE(Renderer);
+
+        TilemapRenderer2D tileRenderer;
+
+        QueryVisible(m_spatial, m_registry, out.camera);
+        ForEachDrawable(m_registry, m_renderQueue, m_spatial, m_spriteGeometry, m_transforms, engine.GetAssets(), alpha,
+            [&](const TilemapComponent& tm, const TransformComponent& tc, const TileLayer& layer)
             {
-                auto& tc = spriteView.get<TransformComponent>(e);
-                auto& sc = spriteView.get<SpriteRendererComponent>(e);
-
-                if (sc.layer != L) continue;
-
-                // Pivot/offset drawing
-                const glm::vec2 worldSize = { sc.size.x * tc.scale.x, sc.size.y * tc.scale.y };
-                const glm::vec2 pivotScaled = { sc.pivot.x * worldSize.x, sc.pivot.y * worldSize.y };
-                const glm::vec2 offsetScaled = { sc.offset.x * tc.scale.x, sc.offset.y * tc.scale.y };
-                const glm::vec2 drawPos = tc.position + offsetScaled - pivotScaled;
-
-                const SDL_Rect* src = nullptr;
-                SDL_Rect atlasRect{};
-
-                // Atlas mode
-                if (!sc.atlasPath.empty() && !sc.regionName.empty())
-                {
-                    auto atlas = engine.GetAssets().GetAtlas(sc.atlasPath);
-                    if (!atlas) continue;
-
-                    const SpriteRegion* region = atlas->GetRegion(sc.regionName);
-                    if (!region || !region->texture) continue;
-
-                    atlasRect = region->rect;
-                    src = &atlasRect;
-
-                    engine.GetRenderer2D().DrawTexture(
-                        *region->texture,
-                        drawPos,
-                        worldSize,
-                        src,
-                        tc.rotationDeg,
-                        sc.flip,
-                        sc.tint
-                    );
-                }
-                else
-                {
-                    // Legacy texturePath mode
-                    if (sc.texturePath.empty()) continue;
-
-                    auto tex = engine.GetAssets().GetTexture(sc.texturePath);
-                    if (!tex) continue;
-
-                    src = sc.useSourceRect ? &sc.sourceRect : nullptr;
-
-                    engine.GetRenderer2D().DrawTexture(
-                        *tex,
-                        drawPos,
-                        worldSize,
-                        src,
-                        tc.rotationDeg,
-                        sc.flip,
-                        sc.tint
-                    );
-                }
-            }
-        }
+                tileRenderer.AppendLayer(tm, tc, layer, engine.GetAssets(), out.camera, out);
+            },
+            [&](const std::shared_ptr<Texture2D>& tex, const glm::vec2& pos, const glm::vec2& size,
+                const SDL_Rect* src, float rotationDeg, SDL_RendererFlip flip, SDL_Color tint)
+            {
+                out.Add(tex, pos, size, src, rotationDeg, flip, tint);
+            });
     }
 }
\ No newline at end of file
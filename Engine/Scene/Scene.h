@@ -1,28 +1,170 @@
 #pragma once
 #include <entt/entt.hpp>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "Scene/Entity.h"
 #include "Scene/Components.h"
+#include "Scene/SpatialGrid.h"
+#include "Scene/CommandBuffer.h"
+#include "Scene/TransformTracker.h"
+#include "Scene/TransformHierarchy.h"
+#include "Renderer/RenderQueue.h"
 
 namespace my2d
 {
     class Engine;
+    class RenderSnapshot;
+    class Prefab;
+
+    // Sprite draw geometry derived from Transform scale + SpriteRenderer size/pivot/offset.
+    // Kept per entity index; recomputed when the transform version moves or the sprite is edited.
+    struct SpriteGeometry
+    {
+        entt::entity entity = entt::null; // null = stale
+        uint32_t transformVersion = 0;
+        glm::vec2 localOffset{ 0.0f }; // scaled offset - scaled pivot, added to the (interpolated) position
+        glm::vec2 worldSize{ 0.0f };
+    };
 
     class Scene
     {
     public:
+        Scene();
+
+        // The id index is wired to this instance's registry signals
+        Scene(const Scene&) = delete;
+        Scene& operator=(const Scene&) = delete;
+
         Entity CreateEntity(const std::string& name = "Entity");
         Entity CreateEntityWithId(uint64_t id, const std::string& name = "Entity");
-        Entity FindEntityById(uint64_t id);
         void DestroyEntity(Entity e);
 
+        // Bulk create with known ids (loaders, snapshot restore): IdComponent only, no Transform/Tag.
+        // out is resized to count, out[i] has ids[i].
+        void CreateEntitiesWithIds(const uint64_t* ids, size_t count, std::vector<entt::entity>& out);
+
+        // Bulk spawn of `count` prefab copies: entities, ids and every component are created with range inserts.
+        // transforms: one per entity, or null for the prefab's own. New handles are appended to out if given.
+        // Structural change, like CreateEntity: not from inside a view loop over the same components.
+        void Instantiate(const Prefab& prefab, size_t count, const TransformComponent* transforms = nullptr,
+            std::vector<entt::entity>* out = nullptr);
+
+        // Deferred structural changes, applied by FlushCommands (see CommandBuffer).
+        // Use these from systems instead of destroying inside view loops.
+        CommandBuffer& Commands() { return m_commands; }
+        const TransformHierarchy& Hierarchy() const { return m_hierarchy; }
+        void QueueDestroy(entt::entity e) { m_commands.Destroy(e); }
+
+        // Sync point: the Engine calls this on App::GetActiveScene() after OnPostFixedUpdate and after OnUpdate.
+        void FlushCommands() { m_commands.Flush(*this); }
+
+        // O(1): IdComponent id -> entity, kept in sync by the registry's IdComponent signals.
+        Entity FindEntityById(uint64_t id);
+
+        // out[i] = entity for ids[i] (entt::null when missing). For serializers resolving references in one pass.
+        void FindEntitiesByIds(const std::vector<uint64_t>& ids, std::vector<entt::entity>& out) const;
+
+        // Pre-size the index before creating `count` more entities (scene loads).
+        void ReserveIds(size_t count) { m_idIndex.reserve(m_idIndex.size() + count); }
+
+        // O(1) tag lookups through an index fed by the TagComponent signals.
+        // FindEntityByTag returns any one of the matches.
+        Entity FindEntityByTag(StringId tag);
+        void FindEntitiesByTag(StringId tag, std::vector<entt::entity>& out) const;
+
+        // PlayerSpawnComponent by name, same kind of index.
+        Entity FindSpawn(StringId name);
+
+        // Entities whose bounds (Transform + sprite/collider/door/pickup extents) touch the box/circle.
+        // Broad-phase only: callers still run their exact test. The list is valid until the next query.
+        const std::vector<entt::entity>& QueryAABB(const glm::vec2& min, const glm::vec2& max) { return m_spatial.QueryAABB(m_registry, min, max); }
+        const std::vector<entt::entity>& QueryRadius(const glm::vec2& center, float radius) { return m_spatial.QueryRadius(m_registry, center, radius); }
+
+        // Transform written in place (no patch/replace): the change tracker, the spatial grid (next query)
+        // and the sprite geometry cache (next draw) pick it up.
+        void MarkTransformChanged(entt::entity e)
+        {
+            m_transforms.MarkMoved(e);
+            m_spatial.MarkChanged(e);
+            m_hierarchy.MarkDirty(m_registry, e);
+        }
+
+        // SpriteRenderer/Tilemap written in place after it was first drawn (layer, texture, atlas, size):
+        // the render queue re-sorts it, the spatial grid and the sprite geometry cache refresh it.
+        void MarkSpriteChanged(entt::entity e)
+        {
+            m_renderQueue.MarkChanged(e);
+            m_spatial.MarkChanged(e);
+            OnSpriteChanged(m_registry, e);
+        }
+
+        // Child's TransformComponent becomes relative to parent (kept as is). entt::null = ClearParent.
+        // Destroying an entity (DestroyEntity / QueueDestroy) takes its whole subtree with it.
+        bool SetParent(entt::entity child, entt::entity parent);
+        // Back to a root at the same world placement
+        void ClearParent(entt::entity child) { m_hierarchy.ClearParent(m_registry, child); }
+
+        // Recompute cached world transforms under everything that moved. The Engine calls it at the sync
+        // points (fixedStep after OnPostFixedUpdate: children blend between steps; after OnUpdate: they snap).
+        void UpdateWorldTransforms(bool fixedStep);
+
+        // Entities with a RigidBody2D whose world transform was rewritten (UpdateWorldTransforms, SetParent)
+        // since the last Physics_SyncChildBodies, which moves their bodies and clears the list.
+        std::vector<entt::entity>& MovedChildBodies() { return m_movedChildBodies; }
+
+        SpatialGrid& Spatial() { return m_spatial; }
+        const TransformTracker& Transforms() const { return m_transforms; }
+        const TransformStats& GetTransformStats() const { return m_transforms.Stats(); }
+
+        // End of a frame (after the last FlushCommands): rolls the moved-transform counts into the stats.
+        void EndFrame() { m_transforms.EndFrame(); }
+
         void OnUpdate(Engine& engine, double dt);
-        void OnRender(Engine& engine);
+        // alpha blends bodies between the last two fixed steps (Engine::RenderAlpha(), 1 = latest step).
+        void OnRender(Engine& engine, float alpha = 1.0f);
+
+        // Same draws as OnRender, recorded into `out` (tiles culled against out.camera) for pipelined rendering.
+        void BuildRenderSnapshot(Engine& engine, float alpha, RenderSnapshot& out);
 
         entt::registry& Registry() { return m_registry; }
 
+        // Owning group for the hot physics set: Transform/RigidBody2D/BoxCollider2D of every body are packed
+        // at the front of their pools in the same order, so each() walks three arrays in lockstep.
+        // Component references to these types move when another entity joins/leaves the group:
+        // don't hold one across an emplace/remove of Transform/RigidBody2D/BoxCollider2D.
+        auto PhysicsGroup() { return m_registry.group<TransformComponent, RigidBody2DComponent, BoxCollider2DComponent>(); }
+
     private:
+        using NameIndex = std::unordered_multimap<StringId, entt::entity>;
+
+        entt::entity LookupId(uint64_t id) const;
+        void OnIdConstruct(entt::registry& reg, entt::entity e);
+        void OnIdDestroy(entt::registry& reg, entt::entity e);
+        void OnSpriteChanged(entt::registry& reg, entt::entity e);
+        void OnWorldMoved(entt::entity e);
+
+        template<typename C, StringId C::*Field, NameIndex Scene::*Index>
+        void OnNameConstruct(entt::registry& reg, entt::entity e);
+        template<typename C, StringId C::*Field, NameIndex Scene::*Index>
+        void OnNameDestroy(entt::registry& reg, entt::entity e);
+
+    private:
+        std::unordered_map<uint64_t, entt::entity> m_idIndex;
+        NameIndex m_tagIndex;
+        NameIndex m_spawnIndex;
+        RenderQueue m_renderQueue;
+        SpatialGrid m_spatial;
+        CommandBuffer m_commands;
+        TransformTracker m_transforms;
+        TransformHierarchy m_hierarchy;
+        std::vector<SpriteGeometry> m_spriteGeometry; // by entity index
+        std::vector<entt::entity> m_movedChildBodies;
+        std::vector<entt::entity> m_spawnScratch;
+        std::vector<IdComponent> m_spawnIds;
+
+        // Declared last so it is destroyed first: its signals point at the members above
         entt::registry m_registry;
     };
 
@@ -3,10 +3,24 @@
 
 #include "Scene/Scene.h"
 #include "Scene/Components.h"
+#include "Scene/ComponentRegistry.h"
+#include "Scene/Prefab.h"
+#include "Scene/CookedScene.h"
+#include "Scene/TileCodec.h"
+#include "Assets/AssetManager.h"
+#include "Core/JobSystem.h"
+#include "Core/MappedFile.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <fstream>
 #include <filesystem>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
 
 #include <spdlog/spdlog.h>
 
@@ -15,11 +29,13 @@ namespace my2d
     using json = nlohmann::json;
 
     // ---- helpers ----
-    static json Vec2ToJson(const glm::vec2& v) { return json{ {"x", v.x}, {"y", v.y} }; }
-    static glm::vec2 JsonToVec2(const json& j, glm::vec2 def = { 0,0 })
+    // Child lookup by reference. j.value(key, json{}) copies the whole subtree just to read a field.
+    static const json& JsonChild(const json& j, const char* key)
     {
-        if (!j.is_object()) return def;
-        return { j.value("x", def.x), j.value("y", def.y) };
+        static const json s_missing;
+        if (!j.is_object()) return s_missing;
+        const auto it = j.find(key);
+        return (it != j.end()) ? *it : s_missing;
     }
 
     static std::string JoinRelativeToFile2(const std::string& filePath, const std::string& rel)
@@ -40,30 +56,6 @@ namespace my2d
         return true;
     }
 
-    static json ColorToJson(const SDL_Color& c) { return json{ {"r", c.r}, {"g", c.g}, {"b", c.b}, {"a", c.a} }; }
-    static SDL_Color JsonToColor(const json& j, SDL_Color def = { 255,255,255,255 })
-    {
-        if (!j.is_object()) return def;
-        SDL_Color c = def;
-        c.r = (Uint8)j.value("r", (int)def.r);
-        c.g = (Uint8)j.value("g", (int)def.g);
-        c.b = (Uint8)j.value("b", (int)def.b);
-        c.a = (Uint8)j.value("a", (int)def.a);
-        return c;
-    }
-
-    static json RectToJson(const SDL_Rect& r) { return json{ {"x", r.x}, {"y", r.y}, {"w", r.w}, {"h", r.h} }; }
-    static SDL_Rect JsonToRect(const json& j, SDL_Rect def = { 0,0,0,0 })
-    {
-        if (!j.is_object()) return def;
-        SDL_Rect r = def;
-        r.x = j.value("x", def.x);
-        r.y = j.value("y", def.y);
-        r.w = j.value("w", def.w);
-        r.h = j.value("h", def.h);
-        return r;
-    }
-
     static const char* BodyTypeToString(BodyType2D t)
     {
         switch (t)
@@ -102,42 +94,6 @@ namespace my2d
         return def;
     }
 
-    static json AbilityListToJson(const std::vector<AbilityId>& v)
-    {
-        json arr = json::array();
-        for (auto a : v)
-            arr.push_back(std::string(AbilityName(a)));
-        return arr;
-    }
-
-    static std::vector<AbilityId> AbilityListFromJson(const json& j)
-    {
-        std::vector<AbilityId> out;
-        if (!j.is_array()) return out;
-        for (auto& it : j)
-        {
-            if (!it.is_string()) continue;
-            AbilityId a{};
-            if (AbilityFromName(it.get<std::string>(), a))
-                out.push_back(a);
-        }
-        return out;
-    }
-
-
-    // ---- Facing ----
-    static void SaveFacing(json& e, const FacingComponent& c)
-    {
-        e["Facing"] = json{ {"facing", c.facing} };
-    }
-
-    static void LoadFacing(entt::registry& reg, entt::entity e, const json& j)
-    {
-        auto& c = reg.emplace_or_replace<FacingComponent>(e);
-        c.facing = j.value("facing", c.facing);
-    }
-
-    // ---- Team ----
     static const char* TeamToString(Team t)
     {
         switch (t)
@@ -155,649 +111,716 @@ namespace my2d
         return Team::Neutral;
     }
 
-    static void SaveTeam(json& e, const TeamComponent& c)
+    // ---- field values ----
+    // One ToJson/FromJson pair per field type of the component tables (ComponentRegistry.h).
+    // FromJson leaves the value alone and returns false when the JSON has the wrong type, so a bad
+    // field keeps its default just like a missing one.
+
+    static json ToJson(const glm::vec2& v) { return json{ {"x", v.x}, {"y", v.y} }; }
+    static bool FromJson(const json& j, glm::vec2& v)
     {
-        e["Team"] = json{ {"team", TeamToString(c.team)} };
+        if (!j.is_object()) return false;
+        v = { j.value("x", v.x), j.value("y", v.y) };
+        return true;
     }
 
-    static void LoadTeam(entt::registry& reg, entt::entity e, const json& j)
+    static json ToJson(const SDL_Color& c) { return json{ {"r", c.r}, {"g", c.g}, {"b", c.b}, {"a", c.a} }; }
+    static bool FromJson(const json& j, SDL_Color& c)
     {
-        auto& c = reg.emplace_or_replace<TeamComponent>(e);
-        c.team = TeamFromString(j.value("team", std::string(TeamToString(c.team))));
+        if (!j.is_object()) return false;
+        c.r = (Uint8)j.value("r", (int)c.r);
+        c.g = (Uint8)j.value("g", (int)c.g);
+        c.b = (Uint8)j.value("b", (int)c.b);
+        c.a = (Uint8)j.value("a", (int)c.a);
+        return true;
     }
 
-    // ---- Health ----
-    static void SaveHealth(json& e, const HealthComponent& c)
+    static json ToJson(const SDL_Rect& r) { return json{ {"x", r.x}, {"y", r.y}, {"w", r.w}, {"h", r.h} }; }
+    static bool FromJson(const json& j, SDL_Rect& r)
     {
-        e["Health"] = json{ {"maxHp", c.maxHp}, {"hp", c.hp} };
+        if (!j.is_object()) return false;
+        r.x = j.value("x", r.x);
+        r.y = j.value("y", r.y);
+        r.w = j.value("w", r.w);
+        r.h = j.value("h", r.h);
+        return true;
     }
 
-    static void LoadHealth(entt::registry& reg, entt::entity e, const json& j)
+    static json ToJson(const StringId& s) { return s.Str(); }
+    static bool FromJson(const json& j, StringId& s)
     {
-        auto& c = reg.emplace_or_replace<HealthComponent>(e);
-        c.maxHp = j.value("maxHp", c.maxHp);
-        c.hp = j.value("hp", c.hp);
+        if (!j.is_string()) return false;
+        s = StringId(j.get_ref<const std::string&>());
+        return true;
     }
 
-    // ---- Hurtbox ----
-    static void SaveHurtbox(json& e, const HurtboxComponent& c)
+    static json ToJson(BodyType2D t) { return BodyTypeToString(t); }
+    static bool FromJson(const json& j, BodyType2D& t)
     {
-        e["Hurtbox"] = json{ {"enabled", c.enabled} };
+        if (!j.is_string()) return false;
+        t = BodyTypeFromString(j.get_ref<const std::string&>(), t);
+        return true;
     }
 
-    static void LoadHurtbox(entt::registry& reg, entt::entity e, const json& j)
+    static json ToJson(GateOpenBehavior b) { return GateBehaviorToString(b); }
+    static bool FromJson(const json& j, GateOpenBehavior& b)
     {
-        auto& c = reg.emplace_or_replace<HurtboxComponent>(e);
-        c.enabled = j.value("enabled", c.enabled);
+        if (!j.is_string()) return false;
+        b = GateBehaviorFromString(j.get_ref<const std::string&>(), b);
+        return true;
     }
 
-    // ---- MeleeAttack (CONFIG ONLY; do NOT serialize runtime timers/shape ids) ----
-    static void SaveMeleeAttack(json& e, const MeleeAttackComponent& c)
+    static json ToJson(Team t) { return TeamToString(t); }
+    static bool FromJson(const json& j, Team& t)
     {
-        e["MeleeAttack"] = json{
-            {"attackKey", (int)c.attackKey},
-            {"useInput", c.useInput},
-
-            {"damage", c.damage},
-            {"activeTime", c.activeTime},
-            {"cooldown", c.cooldown},
-
-            {"hitboxSizePx", Vec2ToJson(c.hitboxSizePx)},
-            {"hitboxOffsetPx", Vec2ToJson(c.hitboxOffsetPx)},
-
-            {"allowAimUp", c.allowAimUp},
-            {"allowAimDown", c.allowAimDown},
-            {"allowDownAttackOnGround", c.allowDownAttackOnGround},
-            {"aimUpKey", (int)c.aimUpKey},
-            {"aimDownKey", (int)c.aimDownKey},
-
-            {"hitboxSizeUpPx", Vec2ToJson(c.hitboxSizeUpPx)},
-            {"hitboxOffsetUpPx", Vec2ToJson(c.hitboxOffsetUpPx)},
-            {"hitboxSizeDownPx", Vec2ToJson(c.hitboxSizeDownPx)},
-            {"hitboxOffsetDownPx", Vec2ToJson(c.hitboxOffsetDownPx)},
-
-            {"knockbackSpeedPx", c.knockbackSpeedPx},
-            {"knockbackUpPx", c.knockbackUpPx},
-            {"victimInvuln", c.victimInvuln},
-            {"targetMaskBits", c.targetMaskBits},
-
-            {"pogoOnDownHit", c.pogoOnDownHit},
-            {"pogoReboundSpeedPx", c.pogoReboundSpeedPx}
-        };
+        if (!j.is_string()) return false;
+        t = TeamFromString(j.get_ref<const std::string&>());
+        return true;
     }
 
-    static void LoadMeleeAttack(entt::registry& reg, entt::entity e, const json& j)
+    static json ToJson(AbilityId a) { return std::string(AbilityName(a)); }
+    static bool FromJson(const json& j, AbilityId& a)
     {
-        auto& c = reg.emplace_or_replace<MeleeAttackComponent>(e);
-
-        c.attackKey = (SDL_Scancode)j.value("attackKey", (int)c.attackKey);
-        c.useInput = j.value("useInput", c.useInput);
+        return j.is_string() && AbilityFromName(j.get_ref<const std::string&>(), a);
+    }
 
-        c.damage = j.value("damage", c.damage);
-        c.activeTime = (float)j.value("activeTime", (double)c.activeTime);
-        c.cooldown = (float)j.value("cooldown", (double)c.cooldown);
+    template<typename T> static void WriteFields(json& j, const T& c);
+    template<typename T> static void ReadFields(const json& j, T& c);
 
-        c.hitboxSizePx = JsonToVec2(j.value("hitboxSizePx", json{}), c.hitboxSizePx);
-        c.hitboxOffsetPx = JsonToVec2(j.value("hitboxOffsetPx", json{}), c.hitboxOffsetPx);
+    // Nested tables as objects, vectors as arrays, the rest as plain JSON values
+    template<typename V>
+    static json ToJson(const V& v)
+    {
+        if constexpr (kIsReflected<V>)
+        {
+            json j = json::object();
+            WriteFields(j, v);
+            return j;
+        }
+        else if constexpr (kIsVector<V>)
+        {
+            json arr = json::array();
+            for (const auto& item : v)
+                arr.push_back(ToJson(item));
+            return arr;
+        }
+        else if constexpr (std::is_enum_v<V>)
+        {
+            return (int)v; // SDL scancodes and flip flags
+        }
+        else
+        {
+            return json(v);
+        }
+    }
 
-        c.allowAimUp = j.value("allowAimUp", c.allowAimUp);
-        c.allowAimDown = j.value("allowAimDown", c.allowAimDown);
-        c.allowDownAttackOnGround = j.value("allowDownAttackOnGround", c.allowDownAttackOnGround);
-        c.aimUpKey = (SDL_Scancode)j.value("aimUpKey", (int)c.aimUpKey);
-        c.aimDownKey = (SDL_Scancode)j.value("aimDownKey", (int)c.aimDownKey);
+    template<typename V>
+    static bool FromJson(const json& j, V& v)
+    {
+        if constexpr (kIsReflected<V>)
+        {
+            if (!j.is_object()) return false;
+            ReadFields(j, v);
+            return true;
+        }
+        else if constexpr (kIsVector<V>)
+        {
+            if (!j.is_array()) return false;
+            v.clear();
+            v.reserve(j.size());
+            for (const json& it : j)
+            {
+                typename V::value_type item{};
+                if (FromJson(it, item)) // entries of the wrong type (or unknown names) are skipped
+                    v.push_back(std::move(item));
+            }
+            return true;
+        }
+        else if constexpr (std::is_same_v<V, bool>)
+        {
+            if (!j.is_boolean()) return false;
+            v = j.get<bool>();
+            return true;
+        }
+        else if constexpr (std::is_arithmetic_v<V>)
+        {
+            if (!j.is_number()) return false;
+            v = j.get<V>();
+            return true;
+        }
+        else if constexpr (std::is_enum_v<V>)
+        {
+            if (!j.is_number_integer()) return false;
+            v = (V)j.get<int>();
+            return true;
+        }
+        else
+        {
+            static_assert(std::is_same_v<V, std::string>, "no JSON conversion for this field type");
+            if (!j.is_string()) return false;
+            v = j.get<std::string>();
+            return true;
+        }
+    }
 
-        c.hitboxSizeUpPx = JsonToVec2(j.value("hitboxSizeUpPx", json{}), c.hitboxSizeUpPx);
-        c.hitboxOffsetUpPx = JsonToVec2(j.value("hitboxOffsetUpPx", json{}), c.hitboxOffsetUpPx);
-        c.hitboxSizeDownPx = JsonToVec2(j.value("hitboxSizeDownPx", json{}), c.hitboxSizeDownPx);
-        c.hitboxOffsetDownPx = JsonToVec2(j.value("hitboxOffsetDownPx", json{}), c.hitboxOffsetDownPx);
+    static bool s_compactTiles = true;
 
-        c.knockbackSpeedPx = (float)j.value("knockbackSpeedPx", (double)c.knockbackSpeedPx);
-        c.knockbackUpPx = (float)j.value("knockbackUpPx", (double)c.knockbackUpPx);
-        c.victimInvuln = (float)j.value("victimInvuln", (double)c.victimInvuln);
-        c.targetMaskBits = (uint64_t)j.value("targetMaskBits", (uint64_t)c.targetMaskBits);
+    // "<name>Data" (+ "<name>Encoding") as written by WriteFields; false if it isn't there (legacy int array)
+    static bool ReadTileData(const json& j, const char* name, std::vector<int>& tiles)
+    {
+        const std::string key = name;
+        const json& data = JsonChild(j, (key + "Data").c_str());
+        if (!data.is_string())
+            return false;
 
-        c.pogoOnDownHit = j.value("pogoOnDownHit", c.pogoOnDownHit);
-        c.pogoReboundSpeedPx = (float)j.value("pogoReboundSpeedPx", (double)c.pogoReboundSpeedPx);
+        const json& layerName = JsonChild(j, "name");
+        const std::string layer = layerName.is_string() ? layerName.get<std::string>() : std::string();
 
-        // runtime reset
-        c.activeTimer = 0.0f;
-        c.cooldownTimer = 0.0f;
-        c.hitboxShapeId = b2_nullShapeId;
-        c.runtimeUserData = nullptr;
-        c.attackRequested = false;
+        const json& encoding = JsonChild(j, (key + "Encoding").c_str());
+        if (!encoding.is_string() || encoding.get_ref<const std::string&>() != "rle16")
+        {
+            spdlog::error("SceneSerializer: tile layer '{}' has unknown {}Encoding", layer, key);
+        }
+        else if (!DecodeTiles(data.get_ref<const std::string&>(), tiles))
+        {
+            spdlog::error("SceneSerializer: tile layer '{}' has corrupt {}Data", layer, key);
+            tiles.clear();
+        }
+        return true;
     }
 
-    // ---- EnemyAI ----
-    static void SaveEnemyAI(json& e, const EnemyAIComponent& c)
-    {
-        e["EnemyAI"] = json{
-            {"patrolSpeedPx", c.patrolSpeedPx},
-            {"chaseSpeedPx", c.chaseSpeedPx},
-            {"aggroRangePx", c.aggroRangePx},
-            {"deaggroRangePx", c.deaggroRangePx},
-            {"attackRangePx", c.attackRangePx},
-            {"ledgeCheckDownPx", c.ledgeCheckDownPx},
-            {"wallCheckForwardPx", c.wallCheckForwardPx},
-            {"canPatrol", c.canPatrol},
-            {"canChase", c.canChase}
-        };
-    }
+    // ---- components, field table driven ----
+    // Only kFieldSaved fields: runtime ones keep their defaults on load.
 
-    static void LoadEnemyAI(entt::registry& reg, entt::entity e, const json& j)
+    template<typename T>
+    static void WriteFields(json& j, const T& c)
     {
-        auto& c = reg.emplace_or_replace<EnemyAIComponent>(e);
-        c.patrolSpeedPx = (float)j.value("patrolSpeedPx", (double)c.patrolSpeedPx);
-        c.chaseSpeedPx = (float)j.value("chaseSpeedPx", (double)c.chaseSpeedPx);
-        c.aggroRangePx = (float)j.value("aggroRangePx", (double)c.aggroRangePx);
-        c.deaggroRangePx = (float)j.value("deaggroRangePx", (double)c.deaggroRangePx);
-        c.attackRangePx = (float)j.value("attackRangePx", (double)c.attackRangePx);
-        c.ledgeCheckDownPx = (float)j.value("ledgeCheckDownPx", (double)c.ledgeCheckDownPx);
-        c.wallCheckForwardPx = (float)j.value("wallCheckForwardPx", (double)c.wallCheckForwardPx);
-        c.canPatrol = j.value("canPatrol", c.canPatrol);
-        c.canChase = j.value("canChase", c.canChase);
+        ForEachField<T>([&](const auto& f)
+            {
+                if (!(f.flags & kFieldSaved))
+                    return;
 
-        // runtime reset
-        c.aggro = false;
+                const auto& v = c.*f.member;
+                if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::vector<int>>)
+                {
+                    // One string instead of width*height numbers; layers the codec can't hold stay an array
+                    std::string encoded;
+                    if ((f.flags & kFieldTileData) && s_compactTiles && EncodeTiles(v, encoded))
+                    {
+                        const std::string key = f.name;
+                        j[key + "Encoding"] = "rle16";
+                        j[key + "Data"] = std::move(encoded);
+                        return;
+                    }
+                }
+                j[f.name] = ToJson(v);
+            });
     }
 
-    static void SavePlayerSpawn(json& e, const PlayerSpawnComponent& c)
+    template<typename T>
+    static void ReadFields(const json& j, T& c)
     {
-        e["PlayerSpawn"] = json{ {"name", c.name} };
-    }
+        ForEachField<T>([&](const auto& f)
+            {
+                if (!(f.flags & kFieldSaved))
+                    return;
 
-    static void SaveDoor(json& e, const DoorComponent& c)
-    {
-        e["Door"] = json{
-            {"targetScene", c.targetScene},
-            {"targetSpawn", c.targetSpawn},
-            {"triggerSize", Vec2ToJson(c.triggerSize)},
-            {"requireInteract", c.requireInteract},
-            {"interactKey", (int)c.interactKey},
-            {"autoTrigger", c.autoTrigger}
-        };
-    }
-
-    // ---- component save ----
-    static void SaveTransform(json& e, const TransformComponent& c)
-    {
-        e["Transform"] = json{
-            {"position", Vec2ToJson(c.position)},
-            {"rotationDeg", c.rotationDeg},
-            {"scale", Vec2ToJson(c.scale)}
-        };
-    }
-
-    static void SaveSprite(json& e, const SpriteRendererComponent& c)
-    {
-        e["SpriteRenderer"] = json{
-            {"texturePath", c.texturePath},
-            {"size", Vec2ToJson(c.size)},
-            {"tint", ColorToJson(c.tint)},
-            {"layer", c.layer},
-            {"useSourceRect", c.useSourceRect},
-            {"sourceRect", RectToJson(c.sourceRect)},
-            {"flip", (int)c.flip},
-            {"atlasPath", c.atlasPath},
-            {"regionName", c.regionName},
-            {"pivot", Vec2ToJson(c.pivot)},
-            {"offset", Vec2ToJson(c.offset)},
-        };
-    }
-
-    static void SaveTilemap(json& e, const TilemapComponent& tm)
-    {
-        json j;
-        j["width"] = tm.width;
-        j["height"] = tm.height;
-        j["tileWidth"] = tm.tileWidth;
-        j["tileHeight"] = tm.tileHeight;
-
-        j["tileset"] = json{
-            {"texturePath", tm.tileset.texturePath},
-            {"tileWidth", tm.tileset.tileWidth},
-            {"tileHeight", tm.tileset.tileHeight},
-            {"columns", tm.tileset.columns},
-            {"margin", tm.tileset.margin},
-            {"spacing", tm.tileset.spacing}
-        };
-
-        json layers = json::array();
-        for (const auto& L : tm.layers)
-        {
-            json jl;
-            jl["name"] = L.name;
-            jl["layer"] = L.layer;
-            jl["visible"] = L.visible;
-            jl["tint"] = ColorToJson(L.tint);
-
-            // tiles can be big; still ok for now
-            jl["tiles"] = L.tiles;
-            layers.push_back(std::move(jl));
-        }
-
-        j["layers"] = std::move(layers);
-        e["Tilemap"] = std::move(j);
-    }
-
-    static void SaveTilemapCollider(json& e, const TilemapColliderComponent& c)
-    {
-        e["TilemapCollider"] = json{
-            {"collisionLayerIndex", c.collisionLayerIndex},
-            {"friction", c.friction},
-            {"restitution", c.restitution},
-            {"isSensor", c.isSensor},
-            {"slopeUpRightTiles", c.slopeUpRightTiles},
-            {"slopeUpLeftTiles", c.slopeUpLeftTiles},
-            {"slopeFriction", c.slopeFriction}
-        };
+                auto& v = c.*f.member;
+                if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::vector<int>>)
+                {
+                    if ((f.flags & kFieldTileData) && ReadTileData(j, f.name, v))
+                        return;
+                }
+                FromJson(JsonChild(j, f.name), v);
+            });
     }
 
-    static void SaveRigidBody(json& e, const RigidBody2DComponent& c)
+    template<typename T>
+    static void SaveComponent(json& e, const T& c)
     {
-        e["RigidBody2D"] = json{
-            {"type", BodyTypeToString(c.type)},
-            {"enabled", c.enabled},
-            {"fixedRotation", c.fixedRotation},
-            {"enableSleep", c.enableSleep},
-            {"isBullet", c.isBullet},
-            {"gravityScale", c.gravityScale},
-            {"linearDamping", c.linearDamping},
-            {"angularDamping", c.angularDamping}
-        };
-    }
-
-    static void SaveBoxCollider(json& e, const BoxCollider2DComponent& c)
-    {
-        e["BoxCollider2D"] = json{
-            {"size", Vec2ToJson(c.size)},
-            {"offset", Vec2ToJson(c.offset)},
-            {"enabled", c.enabled},
-            {"density", c.density},
-            {"friction", c.friction},
-            {"restitution", c.restitution},
-            {"isSensor", c.isSensor},
-            {"categoryBits", c.categoryBits},
-            {"maskBits", c.maskBits}
-        };
-    }
-
-    static void SavePlatformer(json& e, const PlatformerControllerComponent& c)
-    {
-        e["PlatformerController"] = json{
-            {"moveSpeedPx", c.moveSpeedPx},
-            {"accelPx", c.accelPx},
-            {"decelPx", c.decelPx},
-            {"jumpSpeedPx", c.jumpSpeedPx},
-            {"coyoteTime", c.coyoteTime},
-            {"jumpBufferTime", c.jumpBufferTime},
-            {"groundCheckDistancePx", c.groundCheckDistancePx},
-            {"groundRayInsetPx", c.groundRayInsetPx},
-            {"left", (int)c.left},
-            {"right", (int)c.right},
-            {"jump", (int)c.jump},
-            {"dash", (int)c.dash},
-            {"dashSpeedPx", c.dashSpeedPx},
-            {"dashTime", c.dashTime},
-            {"dashCooldown", c.dashCooldown},
-            {"maxGroundSlopeDeg", c.maxGroundSlopeDeg},
-            {"maxJumpSlopeDeg", c.maxJumpSlopeDeg}
-        };
+        json j = json::object();
+        WriteFields(j, c);
+        e[Reflect<T>::kKey] = std::move(j);
     }
 
-    static void SavePersistentFlag(json& e, const PersistentFlagComponent& c)
-    {
-        e["PersistentFlag"] = json{ {"flag", c.flag} };
-    }
-
-    static void SaveGrantProgression(json& e, const GrantProgressionComponent& c)
+    template<typename T>
+    static void LoadComponent(entt::registry& reg, entt::entity e, const json& j)
     {
-        e["GrantProgression"] = json{
-            {"setFlag", c.setFlag},
-            {"unlockAbility", c.unlockAbility},
-            {"ability", std::string(AbilityName(c.ability))},
-            {"radiusPx", c.radiusPx}
-        };
+        if constexpr (Reflect<T>::kOverlay)
+        {
+            // Over what's there (defaults or the prefab's), through patch so the transform listeners see it
+            reg.get_or_emplace<T>(e);
+            reg.patch<T>(e, [&j](T& c) { ReadFields(j, c); });
+        }
+        else
+        {
+            // Built first, then emplaced, so indexed components (PlayerSpawn) are seen with their final values
+            T c{};
+            ReadFields(j, c);
+            reg.emplace_or_replace<T>(e, std::move(c));
+        }
     }
 
-    static void SaveGate(json& e, const GateComponent& c)
+    using ComponentLoader = void (*)(entt::registry&, entt::entity, const json&);
+
+    // Entity key -> loader for every component with a JSON key, built once from SerializedComponents
+    static const std::unordered_map<std::string_view, ComponentLoader>& ComponentLoaders()
     {
-        e["Gate"] = json{
-            {"requireAllAbilities", AbilityListToJson(c.requireAllAbilities)},
-            {"requireAnyAbilities", AbilityListToJson(c.requireAnyAbilities)},
-            {"requireAllFlags", c.requireAllFlags},
-            {"requireAnyFlags", c.requireAnyFlags},
-            {"invert", c.invert},
-            {"openWhenSatisfied", c.openWhenSatisfied},
-            {"openBehavior", GateBehaviorToString(c.openBehavior)},
-            {"overrideTint", c.overrideTint},
-            {"closedTint", ColorToJson(c.closedTint)},
-            {"openTint", ColorToJson(c.openTint)},
-            {"hideWhenOpen", c.hideWhenOpen}
-        };
+        static const std::unordered_map<std::string_view, ComponentLoader> s_loaders = []
+            {
+                std::unordered_map<std::string_view, ComponentLoader> loaders;
+                ForEachComponent(SerializedComponents{}, [&loaders](auto type)
+                    {
+                        using T = typename decltype(type)::type;
+                        if constexpr (Reflect<T>::kKey != nullptr)
+                            loaders.emplace(Reflect<T>::kKey, &LoadComponent<T>);
+                    });
+                return loaders;
+            }();
+        return s_loaders;
     }
 
-    static void LoadPlayerSpawn(entt::registry& reg, entt::entity e, const json& j)
+    // One hash lookup per key of the entity object; the non-component keys (id, tag, prefab, parent) just miss
+    static void LoadComponents(entt::registry& reg, entt::entity h, const json& je)
     {
-        auto& c = reg.emplace_or_replace<PlayerSpawnComponent>(e);
-        c.name = j.value("name", c.name);
-    }
-
-    static void LoadDoor(entt::registry& reg, entt::entity e, const json& j)
-    {
-        auto& c = reg.emplace_or_replace<DoorComponent>(e);
-        c.targetScene = j.value("targetScene", c.targetScene);
-        c.targetSpawn = j.value("targetSpawn", c.targetSpawn);
-        c.triggerSize = JsonToVec2(j.value("triggerSize", json{}), c.triggerSize);
-        c.requireInteract = j.value("requireInteract", c.requireInteract);
-        c.interactKey = (SDL_Scancode)j.value("interactKey", (int)c.interactKey);
-        c.autoTrigger = j.value("autoTrigger", c.autoTrigger);
+        if (!je.is_object())
+            return;
+
+        const auto& loaders = ComponentLoaders();
+        for (auto it = je.begin(); it != je.end(); ++it)
+        {
+            if (const auto found = loaders.find(it.key()); found != loaders.end())
+                found->second(reg, h, it.value());
+        }
+    }
 
-        // runtime reset
-        c.cooldownTimer = 0.0f;
-    }
-
-    // ---- component load ----
-    static void LoadTransform(entt::registry& reg, entt::entity e, const json& j)
+    static void SaveComponents(const entt::registry& reg, entt::entity ent, json& e)
     {
-        auto& c = reg.get<TransformComponent>(e);
-        c.position = JsonToVec2(j.value("position", json{}), c.position);
-        c.rotationDeg = j.value("rotationDeg", c.rotationDeg);
-        c.scale = JsonToVec2(j.value("scale", json{}), c.scale);
+        ForEachComponent(SerializedComponents{}, [&](auto type)
+            {
+                using T = typename decltype(type)::type;
+                if constexpr (Reflect<T>::kKey != nullptr)
+                {
+                    if (const T* c = reg.try_get<T>(ent))
+                        SaveComponent(e, *c);
+                }
+            });
     }
 
-    static void LoadSprite(entt::registry& reg, entt::entity e, const json& j)
+    // ---- main API ----
+    // Everything LoadComponents put on the prefab's scratch entity, except the overlay Transform
+    // (that one is the prefab's default transform)
+    static void CapturePrefabComponents(const entt::registry& reg, entt::entity e, Prefab& out)
     {
-        auto& c = reg.emplace_or_replace<SpriteRendererComponent>(e);
-        c.texturePath = j.value("texturePath", c.texturePath);
-        c.size = JsonToVec2(j.value("size", json{}), c.size);
-        c.tint = JsonToColor(j.value("tint", json{}), c.tint);
-        c.layer = j.value("layer", c.layer);
-        c.useSourceRect = j.value("useSourceRect", c.useSourceRect);
-        c.sourceRect = JsonToRect(j.value("sourceRect", json{}), c.sourceRect);
-        c.flip = (SDL_RendererFlip)j.value("flip", (int)c.flip);
-        c.atlasPath = j.value("atlasPath", c.atlasPath);
-        c.regionName = j.value("regionName", c.regionName);
-        c.pivot = JsonToVec2(j.value("pivot", json{}), c.pivot);
-        c.offset = JsonToVec2(j.value("offset", json{}), c.offset);
+        ForEachComponent(SerializedComponents{}, [&](auto type)
+            {
+                using T = typename decltype(type)::type;
+                if constexpr (Reflect<T>::kKey != nullptr && !Reflect<T>::kOverlay)
+                {
+                    if (const T* c = reg.try_get<T>(e))
+                        out.AddComponent(*c);
+                }
+            });
     }
 
-    static void LoadTilemap(entt::registry& reg, entt::entity e, const json& j)
+    bool SceneSerializer::LoadPrefab(const std::string& path, Prefab& out)
     {
-        auto& tm = reg.emplace_or_replace<TilemapComponent>(e);
-        tm.width = j.value("width", tm.width);
-        tm.height = j.value("height", tm.height);
-        tm.tileWidth = j.value("tileWidth", tm.tileWidth);
-        tm.tileHeight = j.value("tileHeight", tm.tileHeight);
+        MY2D_PROFILE_SCOPE("SceneSerializer::LoadPrefab");
+        MY2D_ALLOC_SCOPE(Scene);
 
-        if (j.contains("tileset") && j["tileset"].is_object())
+        json prefRoot;
+        try
         {
-            const auto& ts = j["tileset"];
-            tm.tileset.texturePath = ts.value("texturePath", tm.tileset.texturePath);
-            tm.tileset.tileWidth = ts.value("tileWidth", tm.tileset.tileWidth);
-            tm.tileset.tileHeight = ts.value("tileHeight", tm.tileset.tileHeight);
-            tm.tileset.columns = ts.value("columns", tm.tileset.columns);
-            tm.tileset.margin = ts.value("margin", tm.tileset.margin);
-            tm.tileset.spacing = ts.value("spacing", tm.tileset.spacing);
+            if (!LoadJsonFile2(path, prefRoot))
+                return false;
         }
-
-        tm.layers.clear();
-        if (j.contains("layers") && j["layers"].is_array())
+        catch (const std::exception& ex)
         {
-            for (auto& it : j["layers"])
-            {
-                TileLayer L;
-                L.name = it.value("name", L.name);
-                L.layer = it.value("layer", L.layer);
-                L.visible = it.value("visible", L.visible);
-                L.tint = JsonToColor(it.value("tint", json{}), L.tint);
+            spdlog::error("SceneSerializer: prefab JSON parse failed for '{}': {}", path, ex.what());
+            return false;
+        }
 
-                if (it.contains("tiles") && it["tiles"].is_array())
-                    L.tiles = it["tiles"].get<std::vector<int>>();
+        // prefab file can be either:
+        // A) {"prefabVersion":1, "entity": { ...entity json... }}
+        // B) { ...entity json... } directly
+        const json& base = (prefRoot.contains("entity") && prefRoot["entity"].is_object()) ? prefRoot["entity"] : prefRoot;
 
-                tm.layers.push_back(std::move(L));
-            }
-        }
+        // Same loaders as scene entities, on a scratch entity, then copied out by value
+        entt::registry reg;
+        const entt::entity h = reg.create();
+        reg.emplace<TransformComponent>(h);
+        LoadComponents(reg, h, base);
+
+        out = Prefab{};
+        out.SetPath(path);
+        if (base.contains("tag") && base["tag"].is_string())
+            out.SetTag(base["tag"].get<std::string>());
+        out.SetTransform(reg.get<TransformComponent>(h));
+
+        CapturePrefabComponents(reg, h, out);
+        return true;
     }
 
-    static void LoadTilemapCollider(entt::registry& reg, entt::entity e, const json& j)
+    bool SceneSerializer::SaveToFile(const Scene& scene, const std::string& path)
     {
-        auto& c = reg.emplace_or_replace<TilemapColliderComponent>(e);
-        c.collisionLayerIndex = j.value("collisionLayerIndex", c.collisionLayerIndex);
-        c.friction = j.value("friction", c.friction);
-        c.restitution = j.value("restitution", c.restitution);
-        c.isSensor = j.value("isSensor", c.isSensor);
+        MY2D_ALLOC_SCOPE(Scene);
 
-        if (j.contains("slopeUpRightTiles")) c.slopeUpRightTiles = j["slopeUpRightTiles"].get<std::vector<int>>();
-        if (j.contains("slopeUpLeftTiles")) c.slopeUpLeftTiles = j["slopeUpLeftTiles"].get<std::vector<int>>();
-        c.slopeFriction = j.value("slopeFriction", c.slopeFriction);
+        const auto& reg = const_cast<Scene&>(scene).Registry(); // entt view needs non-const registry
 
-        c.runtimeBodies.clear(); // runtime only
-    }
+        json root;
+        root["sceneVersion"] = 1;
+        root["entities"] = json::array();
 
-    static void LoadRigidBody(entt::registry& reg, entt::entity e, const json& j)
-    {
-        auto& c = reg.emplace_or_replace<RigidBody2DComponent>(e);
-        c.type = BodyTypeFromString(j.value("type", std::string(BodyTypeToString(c.type))), c.type);
-        c.enabled = j.value("enabled", c.enabled);
-        c.fixedRotation = j.value("fixedRotation", c.fixedRotation);
-        c.enableSleep = j.value("enableSleep", c.enableSleep);
-        c.isBullet = j.value("isBullet", c.isBullet);
-        c.gravityScale = j.value("gravityScale", c.gravityScale);
-        c.linearDamping = j.value("linearDamping", c.linearDamping);
-        c.angularDamping = j.value("angularDamping", c.angularDamping);
+        auto view = reg.view<IdComponent, TagComponent>();
+        for (auto ent : view)
+        {
+            const auto& idc = view.get<IdComponent>(ent);
+            const auto& tag = view.get<TagComponent>(ent);
+
+            json e;
+            e["id"] = idc.id;
+            e["tag"] = tag.tag.Str();
+            if (reg.any_of<PrefabComponent>(ent))
+                e["prefab"] = reg.get<PrefabComponent>(ent).prefabPath;
+
+            // Transform below is local to this parent
+            if (const auto* h = reg.try_get<HierarchyComponent>(ent))
+            {
+                if (h->parent != entt::null && reg.all_of<IdComponent>(h->parent))
+                    e["parent"] = reg.get<IdComponent>(h->parent).id;
+            }
+
+            SaveComponents(reg, ent, e);
 
-        c.bodyId = b2_nullBodyId; // runtime
+            root["entities"].push_back(std::move(e));
+        }
+        namespace fs = std::filesystem;
+        fs::path p(path);
+        p = p.lexically_normal().make_preferred();
+        fs::create_directories(p.parent_path());
+
+        std::ofstream out(p, std::ios::binary);
+        if (!out) return false;
+        out << root.dump(2);
+        return true;
     }
 
-    static void LoadBoxCollider(entt::registry& reg, entt::entity e, const json& j)
+    void SceneSerializer::SetCompactTiles(bool enabled)
     {
-        auto& c = reg.emplace_or_replace<BoxCollider2DComponent>(e);
-        c.size = JsonToVec2(j.value("size", json{}), c.size);
-        c.offset = JsonToVec2(j.value("offset", json{}), c.offset);
-        c.enabled = j.value("enabled", c.enabled);
-        c.density = j.value("density", c.density);
-        c.friction = j.value("friction", c.friction);
-        c.restitution = j.value("restitution", c.restitution);
-        c.isSensor = j.value("isSensor", c.isSensor);
-        c.categoryBits = j.value("categoryBits", c.categoryBits);
-        c.maskBits = j.value("maskBits", c.maskBits);
+        s_compactTiles = enabled;
+    }
+
+    static bool s_autoCook = false;
 
-        c.shapeId = b2_nullShapeId; // runtime
+    void SceneSerializer::SetAutoCook(bool enabled)
+    {
+        s_autoCook = enabled;
     }
 
-    static void LoadPlatformer(entt::registry& reg, entt::entity e, const json& j)
+    bool SceneSerializer::LoadFromFile(Scene& scene, const std::string& path, AssetManager* assets, JobSystem* jobs)
     {
-        auto& c = reg.emplace_or_replace<PlatformerControllerComponent>(e);
-        c.moveSpeedPx = j.value("moveSpeedPx", c.moveSpeedPx);
-        c.accelPx = j.value("accelPx", c.accelPx);
-        c.decelPx = j.value("decelPx", c.decelPx);
+        MY2D_PROFILE_SCOPE("SceneSerializer::LoadFromFile");
 
-        c.jumpSpeedPx = j.value("jumpSpeedPx", c.jumpSpeedPx);
-        c.coyoteTime = j.value("coyoteTime", c.coyoteTime);
-        c.jumpBufferTime = j.value("jumpBufferTime", c.jumpBufferTime);
-        c.groundCheckDistancePx = j.value("groundCheckDistancePx", c.groundCheckDistancePx);
-        c.groundRayInsetPx = j.value("groundRayInsetPx", c.groundRayInsetPx);
+        const std::string jsonPath = std::filesystem::path(path).lexically_normal().make_preferred().string();
+        const std::string binPath = CookedScene::PathFor(jsonPath);
 
-        c.left = (SDL_Scancode)j.value("left", (int)c.left);
-        c.right = (SDL_Scancode)j.value("right", (int)c.right);
-        c.jump = (SDL_Scancode)j.value("jump", (int)c.jump);
-        c.dash = (SDL_Scancode)j.value("dash", (int)c.dash);
+        if (CookedScene::Load(scene, binPath))
+            return true;
 
-        c.dashSpeedPx = j.value("dashSpeedPx", c.dashSpeedPx);
-        c.dashTime = j.value("dashTime", c.dashTime);
-        c.dashCooldown = j.value("dashCooldown", c.dashCooldown);
+        std::vector<std::string> sources;
+        std::vector<std::string>* sourcesOut = s_autoCook ? &sources : nullptr;
+        const bool loaded = jobs ? LoadFromJsonParallel(scene, jsonPath, *jobs, assets, sourcesOut)
+            : LoadFromJsonStream(scene, jsonPath, assets, sourcesOut);
+        if (!loaded)
+            return false;
 
-        c.maxGroundSlopeDeg = j.value("maxGroundSlopeDeg", c.maxGroundSlopeDeg);
-        c.maxJumpSlopeDeg = j.value("maxJumpSlopeDeg", c.maxJumpSlopeDeg);
+        // Straight after the load, so the cooked file holds exactly what the JSON produced
+        if (s_autoCook && CookedScene::Write(scene, binPath, sources))
+            spdlog::info("SceneSerializer: cooked '{}'", binPath);
 
-        // runtime reset
-        c.facing = 1;
-        c.isDashing = false;
-        c.dashTimer = 0.0f;
-        c.dashCooldownTimer = 0.0f;
-        c.dashDir = 1;
-        c.jumpableGround = false;
-        c.grounded = false;
-        c.coyoteTimer = 0.0f;
-        c.jumpBufferTimer = 0.0f;
+        return true;
     }
 
-    static void LoadPersistentFlag(entt::registry& reg, entt::entity e, const json& j)
+    bool SceneSerializer::Cook(const std::string& path, AssetManager* assets)
     {
-        auto& c = reg.emplace_or_replace<PersistentFlagComponent>(e);
-        c.flag = j.value("flag", c.flag);
+        const std::string jsonPath = std::filesystem::path(path).lexically_normal().make_preferred().string();
+
+        Scene scene;
+        std::vector<std::string> sources;
+        if (!LoadFromJsonStream(scene, jsonPath, assets, &sources))
+            return false;
+
+        return CookedScene::Write(scene, CookedScene::PathFor(jsonPath), sources);
     }
 
-    static void LoadGrantProgression(entt::registry& reg, entt::entity e, const json& j)
+    // Prefab lookup for one scene load, paths relative to the scene file. Goes through the asset cache when
+    // there is one; without it each prefab is still parsed only once per load. Every path asked for is
+    // added to sources (once).
+    class ScenePrefabs
     {
-        auto& c = reg.emplace_or_replace<GrantProgressionComponent>(e);
-        c.setFlag = j.value("setFlag", c.setFlag);
-        c.unlockAbility = j.value("unlockAbility", c.unlockAbility);
-        c.radiusPx = j.value("radiusPx", c.radiusPx);
+    public:
+        ScenePrefabs(const std::string& scenePath, AssetManager* assets, std::vector<std::string>* sources)
+            : m_scenePath(scenePath), m_assets(assets), m_sources(sources)
+        {
+        }
 
-        if (j.contains("ability") && j["ability"].is_string())
+        // Null (and logged) when the prefab can't be loaded
+        std::shared_ptr<Prefab> Get(const std::string& relPath)
         {
-            AbilityId a{};
-            if (AbilityFromName(j["ability"].get<std::string>(), a))
-                c.ability = a;
+            const std::string prefabFull = JoinRelativeToFile2(m_scenePath, relPath);
+
+            std::shared_ptr<Prefab> prefab = Find(prefabFull);
+            if (m_sources && std::find(m_sources->begin(), m_sources->end(), prefabFull) == m_sources->end())
+                m_sources->push_back(prefabFull);
+            if (!prefab)
+                spdlog::error("SceneSerializer: failed to load prefab '{}'", prefabFull);
+            return prefab;
         }
-    }
 
-    static void LoadGate(entt::registry& reg, entt::entity e, const json& j)
-    {
-        auto& c = reg.emplace_or_replace<GateComponent>(e);
+    private:
+        std::shared_ptr<Prefab> Find(const std::string& prefabPath)
+        {
+            if (m_assets)
+                return m_assets->GetPrefab(prefabPath);
 
-        c.requireAllAbilities = AbilityListFromJson(j.value("requireAllAbilities", json::array()));
-        c.requireAnyAbilities = AbilityListFromJson(j.value("requireAnyAbilities", json::array()));
+            if (auto it = m_localPrefabs.find(prefabPath); it != m_localPrefabs.end())
+                return it->second;
 
-        if (j.contains("requireAllFlags")) c.requireAllFlags = j["requireAllFlags"].get<std::vector<std::string>>();
-        if (j.contains("requireAnyFlags")) c.requireAnyFlags = j["requireAnyFlags"].get<std::vector<std::string>>();
+            auto loaded = std::make_shared<Prefab>();
+            if (!loaded->LoadFromFile(prefabPath))
+                loaded.reset();
+            m_localPrefabs.emplace(prefabPath, loaded); // failures cached too
+            return loaded;
+        }
 
-        c.invert = j.value("invert", c.invert);
-        c.openWhenSatisfied = j.value("openWhenSatisfied", c.openWhenSatisfied);
-        c.openBehavior = GateBehaviorFromString(j.value("openBehavior", std::string(GateBehaviorToString(c.openBehavior))), c.openBehavior);
+        std::string m_scenePath;
+        AssetManager* m_assets;
+        std::vector<std::string>* m_sources;
+        std::unordered_map<std::string, std::shared_ptr<Prefab>> m_localPrefabs;
+    };
 
-        c.overrideTint = j.value("overrideTint", c.overrideTint);
-        c.closedTint = JsonToColor(j.value("closedTint", json{}), c.closedTint);
-        c.openTint = JsonToColor(j.value("openTint", json{}), c.openTint);
-        c.hideWhenOpen = j.value("hideWhenOpen", c.hideWhenOpen);
+    // Parents can come after their children in the file: linked once everything exists
+    static void LinkParents(Scene& scene, const std::string& path, const std::vector<entt::entity>& children,
+        const std::vector<uint64_t>& parentIds)
+    {
+        if (children.empty())
+            return;
 
-        // runtime reset
-        c.initialized = false;
-        c.isOpen = false;
-    }
+        std::vector<entt::entity> parents;
+        scene.FindEntitiesByIds(parentIds, parents);
 
-    static void SaveAnimator(json& e, const AnimatorComponent& c)
-    {
-        e["Animator"] = json{
-            {"animSetPath", c.animSetPath},
-            {"clip", c.clip},
-            {"playing", c.playing},
-            {"speed", c.speed}
-        };
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            if (parents[i] == entt::null)
+            {
+                spdlog::warn("SceneSerializer: '{}' parent id {} not found, entity stays a root", path, parentIds[i]);
+                continue;
+            }
+            scene.SetParent(children[i], parents[i]);
+        }
     }
 
-    static void LoadAnimator(entt::registry& reg, entt::entity e, const json& j)
+    // Per-entity part of a JSON scene load, shared by the DOM and streaming loaders.
+    // Feed entities in file order with Load(), then LinkParents() once.
+    class SceneEntityLoader
     {
-        auto& c = reg.emplace_or_replace<AnimatorComponent>(e);
-        c.animSetPath = j.value("animSetPath", c.animSetPath);
-        c.clip = j.value("clip", c.clip);
-        c.playing = j.value("playing", c.playing);
-        c.speed = (float)j.value("speed", (double)c.speed);
+    public:
+        SceneEntityLoader(Scene& scene, const std::string& path, AssetManager* assets, std::vector<std::string>* sources)
+            : m_scene(scene), m_reg(scene.Registry()), m_path(path), m_prefabs(path, assets, sources)
+        {
+        }
 
-        // runtime reset
-        c.time = 0.0f;
-        c.frameIndex = 0;
-    }
+        void Load(const json& je)
+        {
+            const uint64_t id = je.value("id", 0ull);
 
-    // ---- main API ----
-    bool SceneSerializer::SaveToFile(const Scene& scene, const std::string& path)
-    {
-        const auto& reg = const_cast<Scene&>(scene).Registry(); // entt view needs non-const registry
+            // Choose tag: scene tag overrides prefab tag
+            std::string tag = je.value("tag", std::string("Entity"));
 
-        json root;
-        root["sceneVersion"] = 1;
-        root["entities"] = json::array();
+            // Optional prefab (parsed once per path, then copied)
+            std::shared_ptr<Prefab> prefab;
+            if (je.contains("prefab") && je["prefab"].is_string())
+            {
+                prefab = m_prefabs.Get(je["prefab"].get<std::string>());
+                if (prefab && !je.contains("tag"))
+                    tag = prefab->Tag(); // If scene didn't specify tag, allow prefab tag
+            }
 
-        auto view = reg.view<IdComponent, TagComponent>();
-        for (auto ent : view)
-        {
-            const auto& idc = view.get<IdComponent>(ent);
-            const auto& tag = view.get<TagComponent>(ent);
+            // Create entity with stable id
+            Entity ent = m_scene.CreateEntityWithId(id, tag);
+            const entt::entity h = ent.Handle();
+            auto& reg = m_reg;
 
-            json e;
-            e["id"] = idc.id;
-            e["tag"] = tag.tag;
-            if (reg.any_of<PrefabComponent>(ent))
-                e["prefab"] = reg.get<PrefabComponent>(ent).prefabPath;
+            // 1) Apply prefab components first (+ store the prefab link)
+            if (prefab)
+            {
+                auto& pc = reg.emplace_or_replace<PrefabComponent>(h);
+                pc.prefabPath = je["prefab"].get<std::string>();
+
+                reg.replace<TransformComponent>(h, prefab->Transform());
+                prefab->Stamp(reg, &h, &h + 1);
+            }
 
-            // Transform always exists in your CreateEntity, but be safe:
-            if (reg.any_of<TransformComponent>(ent))
-                SaveTransform(e, reg.get<TransformComponent>(ent));
+            // 2) Apply scene entity overrides second
+            LoadComponents(reg, h, je);
 
-            if (reg.any_of<SpriteRendererComponent>(ent))
-                SaveSprite(e, reg.get<SpriteRendererComponent>(ent));
+            if (je.contains("parent") && je["parent"].is_number_unsigned())
+            {
+                m_children.push_back(h);
+                m_parentIds.push_back(je["parent"].get<uint64_t>());
+            }
+        }
 
-            if (reg.any_of<TilemapComponent>(ent))
-                SaveTilemap(e, reg.get<TilemapComponent>(ent));
+        void LinkParents()
+        {
+            my2d::LinkParents(m_scene, m_path, m_children, m_parentIds);
+        }
 
-            if (reg.any_of<TilemapColliderComponent>(ent))
-                SaveTilemapCollider(e, reg.get<TilemapColliderComponent>(ent));
+    private:
+        Scene& m_scene;
+        entt::registry& m_reg;
+        std::string m_path;
+        ScenePrefabs m_prefabs;
 
-            if (reg.any_of<RigidBody2DComponent>(ent))
-                SaveRigidBody(e, reg.get<RigidBody2DComponent>(ent));
+        std::vector<entt::entity> m_children;
+        std::vector<uint64_t> m_parentIds;
+    };
 
-            if (reg.any_of<BoxCollider2DComponent>(ent))
-                SaveBoxCollider(e, reg.get<BoxCollider2DComponent>(ent));
+    // SAX handler for LoadFromJsonStream. Everything outside "entities" is skipped; each element of it is
+    // built into a small DOM of its own, handed to the loader as soon as it closes, then dropped.
+    class SceneEntityStream : public nlohmann::json_sax<json>
+    {
+    public:
+        explicit SceneEntityStream(SceneEntityLoader& loader) : m_loader(loader) {}
 
-            if (reg.any_of<PlatformerControllerComponent>(ent))
-                SavePlatformer(e, reg.get<PlatformerControllerComponent>(ent));
+        bool FoundEntities() const { return m_foundEntities; }
+        const std::string& Error() const { return m_error; }
+
+        bool null() override { return Value(nullptr); }
+        bool boolean(bool v) override { return Value(v); }
+        bool number_integer(number_integer_t v) override { return Value(v); }
+        bool number_unsigned(number_unsigned_t v) override { return Value(v); }
+        bool number_float(number_float_t v, const string_t&) override { return Value(v); }
+        bool string(string_t& v) override { return Value(std::move(v)); }
+        bool binary(binary_t& v) override { return Value(json::binary(std::move(v))); }
+
+        bool start_object(std::size_t) override
+        {
+            if (!m_stack.empty() || IsEntitySlot())
+                Push(json::object());
+            ++m_depth;
+            return true;
+        }
+
+        bool end_object() override
+        {
+            --m_depth;
+            if (m_stack.empty())
+                return true;
 
-            if (reg.any_of<AnimatorComponent>(ent))
-                SaveAnimator(e, reg.get<AnimatorComponent>(ent));
+            m_stack.pop_back();
+            if (m_stack.empty())
+            {
+                m_loader.Load(m_entity);
+                m_entity = json(); // only one entity's DOM is ever alive
+            }
+            return true;
+        }
 
-            if (reg.any_of<PersistentFlagComponent>(ent))
-                SavePersistentFlag(e, reg.get<PersistentFlagComponent>(ent));
+        bool start_array(std::size_t) override
+        {
+            if (!m_stack.empty() || IsEntitySlot())
+                Push(json::array());
+            else if (m_depth == 1 && m_key == "entities")
+                m_inEntities = m_foundEntities = true;
+            ++m_depth;
+            return true;
+        }
 
-            if (reg.any_of<GrantProgressionComponent>(ent))
-                SaveGrantProgression(e, reg.get<GrantProgressionComponent>(ent));
+        bool end_array() override
+        {
+            --m_depth;
+            if (!m_stack.empty())
+                m_stack.pop_back();
+            else if (m_depth == 1)
+                m_inEntities = false;
+            return true;
+        }
 
-            if (reg.any_of<GateComponent>(ent))
-                SaveGate(e, reg.get<GateComponent>(ent));
+        bool key(string_t& k) override
+        {
+            m_key = k;
+            return true;
+        }
 
-            if (reg.any_of<PlayerSpawnComponent>(ent))
-                SavePlayerSpawn(e, reg.get<PlayerSpawnComponent>(ent));
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override
+        {
+            m_error = ex.what();
+            return false;
+        }
 
-            if (reg.any_of<DoorComponent>(ent))
-                SaveDoor(e, reg.get<DoorComponent>(ent));
+    private:
+        // A value starting directly inside the "entities" array
+        bool IsEntitySlot() const { return m_inEntities && m_depth == 2; }
 
-            if (reg.any_of<FacingComponent>(ent)) SaveFacing(e, reg.get<FacingComponent>(ent));
-            if (reg.any_of<TeamComponent>(ent)) SaveTeam(e, reg.get<TeamComponent>(ent));
-            if (reg.any_of<HealthComponent>(ent)) SaveHealth(e, reg.get<HealthComponent>(ent));
-            if (reg.any_of<HurtboxComponent>(ent)) SaveHurtbox(e, reg.get<HurtboxComponent>(ent));
-            if (reg.any_of<MeleeAttackComponent>(ent)) SaveMeleeAttack(e, reg.get<MeleeAttackComponent>(ent));
-            if (reg.any_of<EnemyAIComponent>(ent)) SaveEnemyAI(e, reg.get<EnemyAIComponent>(ent));
+        template<typename T>
+        bool Value(T&& v)
+        {
+            if (!m_stack.empty())
+                Insert(json(std::forward<T>(v)));
+            return true;
+        }
 
-            root["entities"].push_back(std::move(e));
+        json* Insert(json&& v)
+        {
+            json& parent = *m_stack.back();
+            if (parent.is_array())
+            {
+                parent.push_back(std::move(v));
+                return &parent.back();
+            }
+            json& slot = parent[m_key];
+            slot = std::move(v);
+            return &slot;
         }
-        namespace fs = std::filesystem;
-        fs::path p(path);
-        p = p.lexically_normal().make_preferred();
-        fs::create_directories(p.parent_path());
 
-        std::ofstream out(p, std::ios::binary);
-        if (!out) return false;
-        out << root.dump(2);
-        return true;
-    }
+        // Children are only added to the innermost open value, so the pointers below it stay valid
+        void Push(json&& v)
+        {
+            if (m_stack.empty())
+            {
+                m_entity = std::move(v);
+                m_stack.push_back(&m_entity);
+            }
+            else
+            {
+                m_stack.push_back(Insert(std::move(v)));
+            }
+        }
 
-    bool SceneSerializer::LoadFromFile(Scene& scene, const std::string& path)
+        SceneEntityLoader& m_loader;
+        json m_entity;
+        std::vector<json*> m_stack;
+        std::string m_key;
+        int m_depth = 0;
+        bool m_inEntities = false;
+        bool m_foundEntities = false;
+        std::string m_error;
+    };
+
+    bool SceneSerializer::LoadFromJson(Scene& scene, const std::string& path, AssetManager* assets, std::vector<std::string>* sources)
     {
+        MY2D_PROFILE_SCOPE("SceneSerializer::LoadFromJson");
+        MY2D_ALLOC_SCOPE(Scene);
+
         namespace fs = std::filesystem;
 
         fs::path p(path);
         p = p.lexically_normal().make_preferred();
 
+        if (sources)
+            sources->push_back(p.string());
+
         if (!fs::exists(p))
         {
             spdlog::error("SceneSerializer: file does not exist: {}", p.string());
@@ -833,100 +856,464 @@ namespace my2d
             return false;
         }
 
+        scene.ReserveIds(root["entities"].size());
+
+        SceneEntityLoader loader(scene, p.string(), assets, sources);
         for (auto& je : root["entities"])
+            loader.Load(je);
+        loader.LinkParents();
+
+        return true;
+    }
+
+    bool SceneSerializer::LoadFromJsonStream(Scene& scene, const std::string& path, AssetManager* assets, std::vector<std::string>* sources)
+    {
+        MY2D_PROFILE_SCOPE("SceneSerializer::LoadFromJsonStream");
+        MY2D_ALLOC_SCOPE(Scene);
+
+        namespace fs = std::filesystem;
+
+        fs::path p(path);
+        p = p.lexically_normal().make_preferred();
+
+        if (sources)
+            sources->push_back(p.string());
+
+        std::ifstream in(p, std::ios::binary);
+        if (!in)
         {
-            const uint64_t id = je.value("id", 0ull);
+            spdlog::error("SceneSerializer: cannot open: {}", p.string());
+            spdlog::error("CWD: {}", fs::current_path().string());
+            return false;
+        }
 
-            // Choose tag: scene tag overrides prefab tag
-            std::string tag = je.value("tag", std::string("Entity"));
+        auto& reg = scene.Registry();
+        reg.clear();
 
-            // Optional prefab
-            nlohmann::json baseEntity;
-            bool hasPrefab = false;
+        SceneEntityLoader loader(scene, p.string(), assets, sources);
+        SceneEntityStream handler(loader);
 
-            if (je.contains("prefab") && je["prefab"].is_string())
-            {
-                const std::string prefabRel = je["prefab"].get<std::string>();
-                const std::string prefabFull = JoinRelativeToFile2(path, prefabRel);
+        bool ok = false;
+        try
+        {
+            ok = json::sax_parse(in, &handler);
+        }
+        catch (const std::exception& ex)
+        {
+            spdlog::error("SceneSerializer: load failed for '{}': {}", p.string(), ex.what());
+        }
+
+        if (ok && !handler.FoundEntities())
+        {
+            spdlog::error("SceneSerializer: '{}' missing 'entities' array", p.string());
+            ok = false;
+        }
+        else if (!ok && !handler.Error().empty())
+        {
+            spdlog::error("SceneSerializer: JSON parse failed for '{}': {}", p.string(), handler.Error());
+        }
+
+        // Entities are created while parsing: don't leave half a scene behind
+        if (!ok)
+        {
+            reg.clear();
+            return false;
+        }
+
+        loader.LinkParents();
+        return true;
+    }
 
-                nlohmann::json prefRoot;
-                if (!LoadJsonFile2(prefabFull, prefRoot))
+    // ---- parallel load ----
+    // Stage 1 (job threads): every entity object is parsed on its own and its components are built into the
+    // staging columns of its chunk. Nothing there touches the registry, the scene or the asset manager.
+    // Stage 2 (calling thread): entities are created in file order, then Id/Transform/Tag, the prefab stamps
+    // and each staged column go in with range inserts.
+
+    struct EntitySpan
+    {
+        size_t begin;
+        size_t end;
+    };
+
+    // Byte range of each object in the root's "entities" array, by bracket matching (strings and escapes
+    // skipped) without building any values. The spans themselves are parsed by the workers; everything
+    // around them (root object, separators, other keys) is validated here, so a malformed file is rejected
+    // like LoadFromJson rejects it. Elements that aren't objects are skipped, as the streaming loader does.
+    static bool FindEntitySpans(std::string_view text, std::vector<EntitySpan>& out, std::string& error)
+    {
+        out.clear();
+
+        std::vector<char> open; // closing bracket expected for each open one
+        std::string_view lastString; // last string at the root level: the key when a value starts
+        size_t entityBegin = 0;
+        bool inEntities = false;
+        bool found = false;
+
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            const char c = text[i];
+            if (c == '"')
+            {
+                const size_t start = ++i;
+                while (i < text.size() && text[i] != '"')
+                    i += (text[i] == '\\') ? 2 : 1;
+                if (i >= text.size())
                 {
-                    spdlog::error("SceneSerializer: failed to load prefab '{}'", prefabFull);
+                    error = "unterminated string";
+                    return false;
                 }
-                else
+                if (open.size() == 1)
+                    lastString = text.substr(start, i - start);
+            }
+            else if (c == '{' || c == '[')
+            {
+                if (open.empty() && c != '{')
+                {
+                    error = "root is not an object";
+                    return false;
+                }
+                if (inEntities && open.size() == 2 && c == '{')
+                    entityBegin = i;
+                else if (!found && open.size() == 1 && c == '[' && lastString == "entities")
+                    inEntities = found = true;
+                open.push_back(c == '{' ? '}' : ']');
+            }
+            else if (c == '}' || c == ']')
+            {
+                if (open.empty() || open.back() != c)
                 {
-                    // prefab file can be either:
-                    // A) {"prefabVersion":1, "entity": { ...entity json... }}
-                    // B) { ...entity json... } directly
-                    if (prefRoot.contains("entity") && prefRoot["entity"].is_object())
-                        baseEntity = prefRoot["entity"];
-                    else
-                        baseEntity = prefRoot;
-
-                    // If scene didn't specify tag, allow prefab tag
-                    if (!je.contains("tag") && baseEntity.contains("tag") && baseEntity["tag"].is_string())
-                        tag = baseEntity["tag"].get<std::string>();
-
-                    hasPrefab = true;
+                    error = "mismatched '" + std::string(1, c) + "' at byte " + std::to_string(i);
+                    return false;
                 }
+                open.pop_back();
+
+                if (inEntities && open.size() == 2 && c == '}')
+                    out.push_back({ entityBegin, i + 1 });
+                else if (inEntities && open.size() == 1)
+                    inEntities = false;
             }
+        }
 
-            // Create entity with stable id
-            Entity ent = scene.CreateEntityWithId(id, tag);
-            const entt::entity h = ent.Handle();
+        if (!open.empty())
+        {
+            error = "unexpected end of file";
+            return false;
+        }
+        if (!found)
+        {
+            error = "missing 'entities' array";
+            return false;
+        }
 
-            // Store prefab link (if any)
-            if (hasPrefab && je.contains("prefab") && je["prefab"].is_string())
+        // The file with every entity cut down to {}: small next to the entities, and one accept() over it
+        // checks all the JSON the workers won't see
+        std::string skeleton;
+        size_t at = 0;
+        for (const EntitySpan& span : out)
+        {
+            skeleton.append(text.substr(at, span.begin - at));
+            skeleton += "{}";
+            at = span.end;
+        }
+        skeleton.append(text.substr(at));
+        if (!json::accept(skeleton))
+        {
+            error = "malformed JSON outside the entity objects";
+            return false;
+        }
+        return true;
+    }
+
+    // One component type's values in a chunk, with the file-order index of the entity each one belongs to
+    template<typename T>
+    struct StagedColumn
+    {
+        std::vector<uint32_t> rows;
+        std::vector<T> values;
+    };
+
+    template<typename... Ts>
+    static std::tuple<StagedColumn<Ts>...> MakeStagedColumns(ComponentList<Ts...>);
+
+    using StagedColumns = decltype(MakeStagedColumns(SerializedComponents{}));
+
+    // The parts of an entity that need the scene or a prefab, resolved on commit
+    struct StagedEntity
+    {
+        uint64_t id = 0;
+        uint64_t parent = 0;
+        std::string tag;
+        std::string prefab;
+        bool hasTag = false;
+        bool hasPrefab = false;
+        bool hasParent = false;
+        TransformComponent transform;
+        json prefabTransform; // with a prefab: the "Transform" overrides, read over the prefab's transform
+    };
+
+    struct StagedChunk
+    {
+        std::vector<StagedEntity> entities;
+        StagedColumns columns;
+        std::string error;
+    };
+
+    // Built into a default T, like LoadComponent: the scene's component replaces the prefab's on commit
+    template<typename T>
+    static void StageComponent(StagedColumns& columns, uint32_t row, const json& j)
+    {
+        auto& column = std::get<StagedColumn<T>>(columns);
+        T c{};
+        ReadFields(j, c);
+        column.rows.push_back(row);
+        column.values.push_back(std::move(c));
+    }
+
+    using ComponentStager = void (*)(StagedColumns&, uint32_t, const json&);
+
+    // Same keys as ComponentLoaders, minus the overlay Transform (staged per entity)
+    static const std::unordered_map<std::string_view, ComponentStager>& ComponentStagers()
+    {
+        static const std::unordered_map<std::string_view, ComponentStager> s_stagers = []
             {
-                auto& pc = reg.emplace_or_replace<PrefabComponent>(h);
-                pc.prefabPath = je["prefab"].get<std::string>();
+                std::unordered_map<std::string_view, ComponentStager> stagers;
+                ForEachComponent(SerializedComponents{}, [&stagers](auto type)
+                    {
+                        using T = typename decltype(type)::type;
+                        if constexpr (Reflect<T>::kKey != nullptr && !Reflect<T>::kOverlay)
+                            stagers.emplace(Reflect<T>::kKey, &StageComponent<T>);
+                    });
+                return stagers;
+            }();
+        return s_stagers;
+    }
+
+    static void StageEntity(const json& je, uint32_t row, const std::unordered_map<std::string_view, ComponentStager>& stagers,
+        StagedChunk& chunk)
+    {
+        StagedEntity& se = chunk.entities.emplace_back();
+        se.id = je.value("id", 0ull);
+        se.tag = je.value("tag", std::string("Entity"));
+        se.hasTag = je.contains("tag");
+
+        if (je.contains("prefab") && je["prefab"].is_string())
+        {
+            se.prefab = je["prefab"].get<std::string>();
+            se.hasPrefab = true;
+        }
+        if (je.contains("parent") && je["parent"].is_number_unsigned())
+        {
+            se.parent = je["parent"].get<uint64_t>();
+            se.hasParent = true;
+        }
+
+        for (auto it = je.begin(); it != je.end(); ++it)
+        {
+            if (it.key() == Reflect<TransformComponent>::kKey)
+            {
+                if (se.hasPrefab)
+                    se.prefabTransform = it.value();
+                else
+                    ReadFields(it.value(), se.transform);
             }
+            else if (const auto found = stagers.find(it.key()); found != stagers.end())
+            {
+                found->second(chunk.columns, row, it.value());
+            }
+        }
+    }
 
-            // 1) Apply prefab components first
-            if (hasPrefab)
+    // Components the entity's prefab already stamped are replaced (the scene's win); the rest go in with one insert
+    template<typename T>
+    static void CommitColumn(entt::registry& reg, const std::vector<entt::entity>& ents, StagedColumn<T>& column,
+        std::vector<entt::entity>& handles)
+    {
+        handles.clear();
+        size_t kept = 0;
+        for (size_t i = 0; i < column.rows.size(); ++i)
+        {
+            const entt::entity e = ents[column.rows[i]];
+            if (reg.all_of<T>(e))
             {
-                if (baseEntity.contains("Transform")) LoadTransform(reg, h, baseEntity["Transform"]);
-                if (baseEntity.contains("SpriteRenderer")) LoadSprite(reg, h, baseEntity["SpriteRenderer"]);
-                if (baseEntity.contains("Animator")) LoadAnimator(reg, h, baseEntity["Animator"]);
-                if (baseEntity.contains("Tilemap")) LoadTilemap(reg, h, baseEntity["Tilemap"]);
-                if (baseEntity.contains("TilemapCollider")) LoadTilemapCollider(reg, h, baseEntity["TilemapCollider"]);
-                if (baseEntity.contains("RigidBody2D")) LoadRigidBody(reg, h, baseEntity["RigidBody2D"]);
-                if (baseEntity.contains("BoxCollider2D")) LoadBoxCollider(reg, h, baseEntity["BoxCollider2D"]);
-                if (baseEntity.contains("PlatformerController")) LoadPlatformer(reg, h, baseEntity["PlatformerController"]);
-                if (baseEntity.contains("PersistentFlag")) LoadPersistentFlag(reg, h, baseEntity["PersistentFlag"]);
-                if (baseEntity.contains("GrantProgression")) LoadGrantProgression(reg, h, baseEntity["GrantProgression"]);
-                if (baseEntity.contains("Gate")) LoadGate(reg, h, baseEntity["Gate"]);
-                // (Add your combat/AI loads here if you already implemented them)
-                if (baseEntity.contains("Facing")) LoadFacing(reg, h, baseEntity["Facing"]);
-                if (baseEntity.contains("Team")) LoadTeam(reg, h, baseEntity["Team"]);
-                if (baseEntity.contains("Health")) LoadHealth(reg, h, baseEntity["Health"]);
-                if (baseEntity.contains("Hurtbox")) LoadHurtbox(reg, h, baseEntity["Hurtbox"]);
-                if (baseEntity.contains("MeleeAttack")) LoadMeleeAttack(reg, h, baseEntity["MeleeAttack"]);
-                if (baseEntity.contains("EnemyAI")) LoadEnemyAI(reg, h, baseEntity["EnemyAI"]);
+                reg.replace<T>(e, std::move(column.values[i]));
+                continue;
             }
 
-            // 2) Apply scene entity overrides second
-            if (je.contains("Transform")) LoadTransform(reg, h, je["Transform"]);
-            if (je.contains("SpriteRenderer")) LoadSprite(reg, h, je["SpriteRenderer"]);
-            if (je.contains("Animator")) LoadAnimator(reg, h, je["Animator"]);
-            if (je.contains("Tilemap")) LoadTilemap(reg, h, je["Tilemap"]);
-            if (je.contains("TilemapCollider")) LoadTilemapCollider(reg, h, je["TilemapCollider"]);
-            if (je.contains("RigidBody2D")) LoadRigidBody(reg, h, je["RigidBody2D"]);
-            if (je.contains("BoxCollider2D")) LoadBoxCollider(reg, h, je["BoxCollider2D"]);
-            if (je.contains("PlatformerController")) LoadPlatformer(reg, h, je["PlatformerController"]);
-            if (je.contains("PersistentFlag")) LoadPersistentFlag(reg, h, je["PersistentFlag"]);
-            if (je.contains("GrantProgression")) LoadGrantProgression(reg, h, je["GrantProgression"]);
-            if (je.contains("Gate")) LoadGate(reg, h, je["Gate"]);
-            if (je.contains("Facing")) LoadFacing(reg, h, je["Facing"]);
-            if (je.contains("Team")) LoadTeam(reg, h, je["Team"]);
-            if (je.contains("Health")) LoadHealth(reg, h, je["Health"]);
-            if (je.contains("Hurtbox")) LoadHurtbox(reg, h, je["Hurtbox"]);
-            if (je.contains("MeleeAttack")) LoadMeleeAttack(reg, h, je["MeleeAttack"]);
-            if (je.contains("EnemyAI")) LoadEnemyAI(reg, h, je["EnemyAI"]);
+            if (kept != i)
+                column.values[kept] = std::move(column.values[i]);
+            ++kept;
+            handles.push_back(e);
         }
+        column.values.resize(kept);
 
-        return true;
+        reg.insert<T>(handles.begin(), handles.end(), column.values.begin());
     }
 
-}
\ No newline at end of file
+    static void CommitStaged(Scene& scene, const std::string& path, std::vector<StagedChunk>& chunks, size_t count,
+        ScenePrefabs& prefabs)
+    {
+        auto& reg = scene.Registry();
+
+        std::vector<uint64_t> ids;
+        ids.reserve(count);
+        for (const StagedChunk& chunk : chunks)
+        {
+            for (const StagedEntity& se : chunk.entities)
+                ids.push_back(se.id);
+        }
+
+        std::vector<entt::entity> ents;
+        scene.CreateEntitiesWithIds(ids.data(), ids.size(), ents);
+
+        std::vector<TransformComponent> transforms;
+        std::vector<TagComponent> tags;
+        transforms.reserve(count);
+        tags.reserve(count);
+
+        std::vector<entt::entity> prefabbed;
+        std::vector<PrefabComponent> prefabLinks;
+        std::vector<std::pair<std::shared_ptr<Prefab>, std::vector<entt::entity>>> stamps; // one Stamp per prefab
+        std::unordered_map<const Prefab*, size_t> stampIndex;
+
+        std::vector<entt::entity> children;
+        std::vector<uint64_t> parentIds;
+
+        size_t row = 0;
+        for (StagedChunk& chunk : chunks)
+        {
+            for (StagedEntity& se : chunk.entities)
+            {
+                const entt::entity e = ents[row++];
+
+                // Prefab lookups in file order, so sources lists them like the other loaders do
+                const std::shared_ptr<Prefab> prefab = se.hasPrefab ? prefabs.Get(se.prefab) : nullptr;
+
+                TransformComponent& tc = transforms.emplace_back(se.transform);
+                if (se.hasPrefab)
+                {
+                    tc = prefab ? prefab->Transform() : TransformComponent{};
+                    ReadFields(se.prefabTransform, tc);
+                }
+
+                // Scene tag overrides prefab tag
+                tags.push_back(TagComponent{ StringId((prefab && !se.hasTag) ? prefab->Tag() : se.tag) });
+
+                if (prefab)
+                {
+                    prefabbed.push_back(e);
+                    prefabLinks.push_back(PrefabComponent{ std::move(se.prefab) });
+
+                    const auto [it, added] = stampIndex.try_emplace(prefab.get(), stamps.size());
+                    if (added)
+                        stamps.emplace_back(prefab, std::vector<entt::entity>{});
+                    stamps[it->second].second.push_back(e);
+                }
+
+                if (se.hasParent)
+                {
+                    children.push_back(e);
+                    parentIds.push_back(se.parent);
+                }
+            }
+        }
+
+        reg.insert<TransformComponent>(ents.begin(), ents.end(), transforms.begin());
+        reg.insert<TagComponent>(ents.begin(), ents.end(), tags.begin());
+        reg.insert<PrefabComponent>(prefabbed.begin(), prefabbed.end(), prefabLinks.begin());
+
+        // Prefab components first, scene overrides second (as in SceneEntityLoader::Load)
+        for (const auto& [prefab, handles] : stamps)
+            prefab->Stamp(reg, handles.data(), handles.data() + handles.size());
+
+        std::vector<entt::entity> handles;
+        ForEachComponent(SerializedComponents{}, [&](auto type)
+            {
+                using T = typename decltype(type)::type;
+                if constexpr (Reflect<T>::kKey != nullptr && !Reflect<T>::kOverlay)
+                {
+                    for (StagedChunk& chunk : chunks)
+                        CommitColumn(reg, ents, std::get<StagedColumn<T>>(chunk.columns), handles);
+                }
+            });
+
+        LinkParents(scene, path, children, parentIds);
+    }
+
+    bool SceneSerializer::LoadFromJsonParallel(Scene& scene, const std::string& path, JobSystem& jobs, AssetManager* assets,
+        std::vector<std::string>* sources)
+    {
+        MY2D_PROFILE_SCOPE("SceneSerializer::LoadFromJsonParallel");
+        MY2D_ALLOC_SCOPE(Scene);
+
+        namespace fs = std::filesystem;
+
+        fs::path p(path);
+        p = p.lexically_normal().make_preferred();
+
+        if (sources)
+            sources->push_back(p.string());
+
+        MappedFile file;
+        if (!file.Open(p.string()))
+        {
+            spdlog::error("SceneSerializer: cannot open: {}", p.string());
+            spdlog::error("CWD: {}", fs::current_path().string());
+            return false;
+        }
+        const std::string_view text((const char*)file.Data(), file.Size());
+
+        std::vector<EntitySpan> spans;
+        std::string error;
+        if (!FindEntitySpans(text, spans, error))
+        {
+            spdlog::error("SceneSerializer: JSON parse failed for '{}': {}", p.string(), error);
+            return false;
+        }
+
+        // Several chunks per thread, so rooms with a few heavy entities (big tilemaps) still spread out
+        const uint32_t count = (uint32_t)spans.size();
+        const uint32_t grain = std::max<uint32_t>(64, count / (jobs.ThreadCount() * 8));
+        std::vector<StagedChunk> chunks((count + grain - 1) / grain);
+
+        const auto& stagers = ComponentStagers(); // built here rather than by whichever worker gets there first
+        {
+            MY2D_PROFILE_SCOPE("SceneSerializer::StageEntities");
+            jobs.ParallelFor(count, grain, [&](uint32_t begin, uint32_t end)
+                {
+                    StagedChunk& chunk = chunks[begin / grain];
+                    chunk.entities.reserve(end - begin);
+                    uint32_t i = begin;
+                    try
+                    {
+                        for (; i < end; ++i)
+                        {
+                            const json je = json::parse(text.data() + spans[i].begin, text.data() + spans[i].end);
+                            StageEntity(je, i, stagers, chunk);
+                        }
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        // Parse errors count from the start of the entity
+                        chunk.error = "entity at byte " + std::to_string(spans[i].begin) + ": " + ex.what();
+                    }
+                });
+        }
+
+        for (const StagedChunk& chunk : chunks)
+        {
+            if (!chunk.error.empty())
+            {
+                spdlog::error("SceneSerializer: JSON parse failed for '{}': {}", p.string(), chunk.error);
+                return false;
+            }
+        }
+
+        MY2D_PROFILE_SCOPE("SceneSerializer::CommitEntities");
+        scene.Registry().clear();
+
+        ScenePrefabs prefabs(p.string(), assets, sources);
+        CommitStaged(scene, p.string(), chunks, count, prefabs);
+        return true;
+    }
+}
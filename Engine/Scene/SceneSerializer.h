@@ -1,14 +1,57 @@
 #pragma once
 #include <string>
+#include <vector>
 
 namespace my2d
 {
     class Scene;
+    class Prefab;
+    class AssetManager;
+    class JobSystem;
 
     class SceneSerializer
     {
     public:
+        // Component keys and fields come from the tables in ComponentRegistry.h; runtime fields aren't saved.
         static bool SaveToFile(const Scene& scene, const std::string& path);
-        static bool LoadFromFile(Scene& scene, const std::string& path);
+
+        // Prefabs referenced by the scene come from assets' prefab cache (parsed once per path);
+        // without one they are still parsed only once per load.
+        // Uses the cooked .scene.bin next to the file when it is up to date (see CookedScene); otherwise
+        // loads the JSON (LoadFromJsonParallel with jobs, LoadFromJsonStream without) and, if a tool turned on
+        // auto-cook, writes a fresh .scene.bin for next time.
+        static bool LoadFromFile(Scene& scene, const std::string& path, AssetManager* assets = nullptr,
+            JobSystem* jobs = nullptr);
+
+        // JSON only, parsed into one DOM first. sources (optional) gets the scene file + every prefab file it pulled in.
+        static bool LoadFromJson(Scene& scene, const std::string& path, AssetManager* assets = nullptr,
+            std::vector<std::string>* sources = nullptr);
+
+        // Same result as LoadFromJson, but SAX-parsed from the file: each entity is built as its object closes
+        // and its JSON dropped, so memory beyond the scene itself stays around one entity. On failure the
+        // scene is left empty.
+        static bool LoadFromJsonStream(Scene& scene, const std::string& path, AssetManager* assets = nullptr,
+            std::vector<std::string>* sources = nullptr);
+
+        // Same result as LoadFromJson, in two stages: the entities are parsed into per-component staging
+        // arrays in parallel chunks on the job threads (no registry access), then committed on the calling
+        // thread with range inserts. Call from the thread that owns the JobSystem. On failure the scene is
+        // left as it was.
+        static bool LoadFromJsonParallel(Scene& scene, const std::string& path, JobSystem& jobs,
+            AssetManager* assets = nullptr, std::vector<std::string>* sources = nullptr);
+
+        // Load the JSON and write its .scene.bin (offline cooking, the normal way to produce cooked files).
+        static bool Cook(const std::string& path, AssetManager* assets = nullptr);
+
+        // On by default: tile layers are saved as an "rle16" string (see TileCodec) instead of an int array.
+        // Both are always read.
+        static void SetCompactTiles(bool enabled);
+
+        // Off by default, so shipped builds never write next to their content. Tools/editor opt in to have
+        // LoadFromFile write stale or missing .scene.bin files; up-to-date ones are read either way.
+        static void SetAutoCook(bool enabled);
+
+        // Parse a prefab file into a component template (see Prefab::LoadFromFile).
+        static bool LoadPrefab(const std::string& path, Prefab& out);
     };
 }
\ No newline at end of file
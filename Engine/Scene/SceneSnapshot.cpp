@@ -0,0 +1,476 @@
+#include "pch.h"
+#include "Scene/SceneSnapshot.h"
+#include "Scene/Scene.h"
+#include "Scene/ComponentRegistry.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace my2d
+{
+    namespace
+    {
+        constexpr uint32_t kSnapshotMagic = 0x5353594Du; // "MYSS"
+        constexpr uint32_t kSnapshotVersion = 2;
+        constexpr uint32_t kNoIndex = 0xFFFFFFFFu;
+
+        struct Writer
+        {
+            std::vector<uint8_t>& out;
+
+            void Bytes(const void* data, size_t size)
+            {
+                const auto* p = static_cast<const uint8_t*>(data);
+                out.insert(out.end(), p, p + size);
+            }
+
+            template<typename T>
+            void Pod(const T& v)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                Bytes(&v, sizeof(T));
+            }
+
+            void Str(const std::string& s)
+            {
+                Pod((uint32_t)s.size());
+                Bytes(s.data(), s.size());
+            }
+
+            template<typename T>
+            void Vec(const std::vector<T>& v)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                Pod((uint32_t)v.size());
+                if (!v.empty())
+                    Bytes(v.data(), v.size() * sizeof(T));
+            }
+
+            void StrVec(const std::vector<std::string>& v)
+            {
+                Pod((uint32_t)v.size());
+                for (const auto& s : v)
+                    Str(s);
+            }
+
+            bool Has(size_t) const { return true; } // the Reader's bounds check
+        };
+
+        // Every read is bounds checked; the first short read clears ok and the rest become no-ops.
+        struct Reader
+        {
+            const uint8_t* p = nullptr;
+            const uint8_t* end = nullptr;
+            bool ok = true;
+
+            bool Has(size_t size)
+            {
+                if (ok && (size_t)(end - p) < size)
+                    ok = false;
+                return ok;
+            }
+
+            void Bytes(void* dst, size_t size)
+            {
+                if (!Has(size) || size == 0)
+                    return;
+                std::memcpy(dst, p, size);
+                p += size;
+            }
+
+            template<typename T>
+            void Pod(T& v)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                Bytes(&v, sizeof(T));
+            }
+
+            void Str(std::string& s)
+            {
+                uint32_t n = 0;
+                Pod(n);
+                if (!Has(n))
+                    return;
+                s.assign(reinterpret_cast<const char*>(p), n);
+                p += n;
+            }
+
+            template<typename T>
+            void Vec(std::vector<T>& v)
+            {
+                uint32_t n = 0;
+                Pod(n);
+                if (!Has((size_t)n * sizeof(T)))
+                    return;
+                v.resize(n);
+                Bytes(v.data(), (size_t)n * sizeof(T));
+            }
+
+            void StrVec(std::vector<std::string>& v)
+            {
+                uint32_t n = 0;
+                Pod(n);
+                if (!Has((size_t)n * sizeof(uint32_t)))
+                    return;
+                v.resize(n);
+                for (auto& s : v)
+                    Str(s);
+            }
+        };
+
+        // ---- components with strings/vectors, field by field ----
+        // Walked from the component tables (ComponentRegistry.h), saved and runtime fields alike: a snapshot
+        // keeps runtime state. Everything else is trivially copyable and goes through as raw bytes
+        // (StringIds included: a snapshot never leaves the process that interned them).
+
+        template<typename IO, typename T>
+        void Fields(IO& io, T& c);
+
+        template<typename IO, typename V>
+        void FieldValue(IO& io, V& v)
+        {
+            if constexpr (std::is_same_v<V, std::string>)
+                io.Str(v);
+            else if constexpr (kIsVector<V>)
+            {
+                using E = typename V::value_type;
+                if constexpr (std::is_same_v<E, std::string>)
+                    io.StrVec(v);
+                else if constexpr (kIsReflected<E>)
+                {
+                    uint32_t count = (uint32_t)v.size();
+                    io.Pod(count);
+                    if (!io.Has(count)) // at least a byte each
+                        return;
+                    v.resize(count);
+                    for (auto& item : v)
+                        Fields(io, item);
+                }
+                else
+                    io.Vec(v);
+            }
+            else if constexpr (kIsReflected<V>)
+                Fields(io, v);
+            else
+                io.Pod(v);
+        }
+
+        template<typename IO, typename T>
+        void Fields(IO& io, T& c)
+        {
+            ForEachField<T>([&](const auto& f) { FieldValue(io, c.*f.member); });
+        }
+
+        template<typename T>
+        void Save(Writer& w, const T& c)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+                w.Pod(c);
+            else
+                Fields(w, const_cast<T&>(c)); // the Writer only reads
+        }
+
+        template<typename T>
+        void Load(Reader& r, T& c)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+                r.Pod(c);
+            else
+                Fields(r, c);
+        }
+
+        // ---- runtime handles that can't survive a restore ----
+
+        template<typename T>
+        void ResetRuntime(T& c)
+        {
+            ClearRuntimeHandles(c);
+
+            if constexpr (std::is_same_v<T, MeleeAttackComponent>)
+            {
+                // The hitbox shape went with the old world: the swing ends, the cooldown carries on
+                c.activeTimer = 0.0f;
+                c.attackRequested = false;
+            }
+        }
+
+        // entity index -> snapshot row (kNoIndex for entities without an id)
+        using RowMap = std::vector<uint32_t>;
+
+        uint32_t RowOf(const RowMap& rows, entt::entity e)
+        {
+            const size_t index = (size_t)entt::to_entity(e);
+            return index < rows.size() ? rows[index] : kNoIndex;
+        }
+
+        template<typename T>
+        void WriteColumn(Writer& w, entt::registry& reg, const RowMap& rows)
+        {
+            const size_t countAt = w.out.size();
+            uint32_t count = 0;
+            w.Pod(count);
+
+            for (auto [e, c] : reg.view<T>().each())
+            {
+                const uint32_t row = RowOf(rows, e);
+                if (row == kNoIndex)
+                    continue;
+
+                w.Pod(row);
+                Save(w, c);
+                ++count;
+            }
+
+            std::memcpy(w.out.data() + countAt, &count, sizeof(count));
+        }
+
+        // One column decoded and checked, waiting for its entities
+        template<typename T>
+        struct RestoredColumn
+        {
+            std::vector<uint32_t> rows;
+            std::vector<T> values;
+        };
+
+        template<typename... Ts>
+        std::tuple<RestoredColumn<Ts>...> MakeRestoredColumns(ComponentList<Ts...>);
+
+        using RestoredColumns = decltype(MakeRestoredColumns(SerializedComponents{}));
+
+        // seen: scratch, one flag per row (a row twice in a column would make emplace assert)
+        template<typename T>
+        void ReadColumn(Reader& r, size_t entityCount, std::vector<uint8_t>& seen, RestoredColumn<T>& out)
+        {
+            uint32_t count = 0;
+            r.Pod(count);
+            if (count > entityCount)
+                r.ok = false;
+            if (!r.ok)
+                return;
+
+            seen.assign(entityCount, 0);
+            out.rows.reserve(count);
+            out.values.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                uint32_t row = 0;
+                r.Pod(row);
+
+                T c{};
+                Load(r, c);
+                if (!r.ok || row >= entityCount || seen[row])
+                {
+                    r.ok = false;
+                    return;
+                }
+                seen[row] = 1;
+
+                ResetRuntime(c);
+                out.rows.push_back(row);
+                out.values.push_back(std::move(c));
+            }
+        }
+
+        template<typename T>
+        void CommitColumn(RestoredColumn<T>& column, entt::registry& reg, const std::vector<entt::entity>& ents)
+        {
+            for (size_t i = 0; i < column.rows.size(); ++i)
+                reg.emplace<T>(ents[column.rows[i]], std::move(column.values[i]));
+        }
+
+        template<typename... Ts>
+        void WriteColumns(ComponentList<Ts...>, Writer& w, entt::registry& reg, const RowMap& rows)
+        {
+            (WriteColumn<Ts>(w, reg, rows), ...);
+        }
+
+        template<typename... Ts>
+        void ReadColumns(ComponentList<Ts...>, Reader& r, size_t entityCount, RestoredColumns& out)
+        {
+            std::vector<uint8_t> seen;
+            (ReadColumn<Ts>(r, entityCount, seen, std::get<RestoredColumn<Ts>>(out)), ...);
+        }
+
+        template<typename... Ts>
+        void CommitColumns(ComponentList<Ts...>, RestoredColumns& columns, entt::registry& reg, const std::vector<entt::entity>& ents)
+        {
+            (CommitColumn<Ts>(std::get<RestoredColumn<Ts>>(columns), reg, ents), ...);
+        }
+    }
+
+    void SceneSnapshot::Clear()
+    {
+        m_data.clear();
+        m_bodies.clear();
+        m_entityCount = 0;
+    }
+
+    void SceneSnapshot::Capture(Scene& scene)
+    {
+        MY2D_PROFILE_SCOPE("SceneSnapshot::Capture");
+        MY2D_ALLOC_SCOPE(Scene);
+
+        Clear();
+
+        auto& reg = scene.Registry();
+        auto ids = reg.view<IdComponent>();
+
+        // Rows in id pool order; the map is by entity index
+        RowMap rows;
+        std::vector<uint64_t> rowIds;
+        rowIds.reserve(ids.size());
+        for (auto [e, id] : ids.each())
+        {
+            const size_t index = (size_t)entt::to_entity(e);
+            if (index >= rows.size())
+                rows.resize(index + 1, kNoIndex);
+            rows[index] = (uint32_t)rowIds.size();
+            rowIds.push_back(id.id);
+        }
+        m_entityCount = rowIds.size();
+
+        Writer w{ m_data };
+        w.Pod(kSnapshotMagic);
+        w.Pod(kSnapshotVersion);
+        w.Vec(rowIds);
+
+        WriteColumns(SerializedComponents{}, w, reg, rows);
+
+        // Parent links as (child row, parent id)
+        {
+            const size_t countAt = w.out.size();
+            uint32_t count = 0;
+            w.Pod(count);
+            for (auto [e, h] : reg.view<HierarchyComponent>().each())
+            {
+                const uint32_t row = RowOf(rows, e);
+                const IdComponent* parentId = (h.parent != entt::null) ? reg.try_get<IdComponent>(h.parent) : nullptr;
+                if (row == kNoIndex || !parentId)
+                    continue;
+
+                w.Pod(row);
+                w.Pod(parentId->id);
+                ++count;
+            }
+            std::memcpy(w.out.data() + countAt, &count, sizeof(count));
+        }
+
+        // Box2D state of every live body
+        for (auto [e, rb] : reg.view<RigidBody2DComponent>().each())
+        {
+            const uint32_t row = RowOf(rows, e);
+            if (row == kNoIndex || !b2Body_IsValid(rb.bodyId))
+                continue;
+
+            const b2Transform xf = b2Body_GetTransform(rb.bodyId);
+            const b2Vec2 v = b2Body_GetLinearVelocity(rb.bodyId);
+
+            BodyState& s = m_bodies.emplace_back();
+            s.id = rowIds[row];
+            s.px = xf.p.x; s.py = xf.p.y;
+            s.qc = xf.q.c; s.qs = xf.q.s;
+            s.vx = v.x; s.vy = v.y;
+            s.w = b2Body_GetAngularVelocity(rb.bodyId);
+            s.awake = b2Body_IsAwake(rb.bodyId);
+        }
+    }
+
+    bool SceneSnapshot::Restore(Scene& scene) const
+    {
+        MY2D_PROFILE_SCOPE("SceneSnapshot::Restore");
+        MY2D_ALLOC_SCOPE(Scene);
+
+        if (m_data.empty())
+            return false;
+
+        Reader r{ m_data.data(), m_data.data() + m_data.size() };
+
+        uint32_t magic = 0, version = 0;
+        r.Pod(magic);
+        r.Pod(version);
+        if (!r.ok || magic != kSnapshotMagic || version != kSnapshotVersion)
+        {
+            spdlog::error("SceneSnapshot: bad header");
+            return false;
+        }
+
+        std::vector<uint64_t> rowIds;
+        r.Vec(rowIds);
+
+        // Everything is decoded and checked before the scene is touched, so corrupt data leaves it as it was
+        RestoredColumns columns;
+        ReadColumns(SerializedComponents{}, r, rowIds.size(), columns);
+
+        uint32_t linkCount = 0;
+        r.Pod(linkCount);
+
+        std::vector<uint32_t> children;
+        std::vector<uint64_t> parentIds;
+        for (uint32_t i = 0; i < linkCount && r.ok; ++i)
+        {
+            uint32_t row = 0;
+            uint64_t parentId = 0;
+            r.Pod(row);
+            r.Pod(parentId);
+            if (row >= rowIds.size())
+                r.ok = false;
+
+            children.push_back(row);
+            parentIds.push_back(parentId);
+        }
+
+        if (!r.ok)
+        {
+            spdlog::error("SceneSnapshot: truncated or corrupt data");
+            return false;
+        }
+
+        std::vector<entt::entity> ents;
+        scene.CreateEntitiesWithIds(rowIds.data(), rowIds.size(), ents);
+        CommitColumns(SerializedComponents{}, columns, scene.Registry(), ents);
+
+        // Every transform is in place by now, so each SetParent computes the right world transforms
+        std::vector<entt::entity> parents;
+        scene.FindEntitiesByIds(parentIds, parents);
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            if (parents[i] != entt::null)
+                scene.SetParent(ents[children[i]], parents[i]);
+        }
+
+        return true;
+    }
+
+    void SceneSnapshot::ApplyBodyStates(Scene& scene) const
+    {
+        MY2D_PROFILE_SCOPE("SceneSnapshot::ApplyBodyStates");
+
+        std::vector<uint64_t> ids;
+        ids.reserve(m_bodies.size());
+        for (const BodyState& s : m_bodies)
+            ids.push_back(s.id);
+
+        std::vector<entt::entity> ents;
+        scene.FindEntitiesByIds(ids, ents);
+
+        auto& reg = scene.Registry();
+        for (size_t i = 0; i < m_bodies.size(); ++i)
+        {
+            const RigidBody2DComponent* rb = (ents[i] != entt::null) ? reg.try_get<RigidBody2DComponent>(ents[i]) : nullptr;
+            if (!rb || !b2Body_IsValid(rb->bodyId))
+                continue;
+
+            const BodyState& s = m_bodies[i];
+            b2Body_SetTransform(rb->bodyId, b2Vec2{ s.px, s.py }, b2Rot{ s.qc, s.qs });
+            b2Body_SetLinearVelocity(rb->bodyId, b2Vec2{ s.vx, s.vy });
+            b2Body_SetAngularVelocity(rb->bodyId, s.w);
+            if (!s.awake)
+                b2Body_SetAwake(rb->bodyId, false);
+        }
+    }
+}
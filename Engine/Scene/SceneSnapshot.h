@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace my2d
+{
+    class Scene;
+
+    // In-memory binary copy of a room: every entity with an IdComponent, all of its components
+    // (serialized and runtime fields, e.g. controller/attack timers, gate state) and the Box2D state
+    // of its body. Restoring never touches disk or JSON, so it's the fast path for checkpoints.
+    //
+    // Components are stored column by column (one block per component type), trivially copyable ones as
+    // raw bytes. Parent links are kept as ids. Runtime handles (bodies, shapes, attack hitboxes) are not
+    // kept: restore into a fresh Scene on a fresh physics world, then
+    //   BuildTilemapColliders + Physics_CreateRuntime, then ApplyBodyStates().
+    class SceneSnapshot
+    {
+    public:
+        void Capture(Scene& scene);
+
+        // Recreates the captured entities in `scene` (expected empty). False, with the scene untouched, if
+        // there's nothing captured or the data is corrupt.
+        bool Restore(Scene& scene) const;
+
+        // Box2D position/rotation/velocities/awake onto the bodies of the restored entities (by id).
+        void ApplyBodyStates(Scene& scene) const;
+
+        bool Empty() const { return m_data.empty(); }
+        void Clear();
+
+        size_t EntityCount() const { return m_entityCount; }
+        size_t BodyCount() const { return m_bodies.size(); }
+        size_t SizeBytes() const { return m_data.size() + m_bodies.size() * sizeof(BodyState); }
+
+    private:
+        struct BodyState
+        {
+            uint64_t id = 0;
+            float px = 0.0f, py = 0.0f;
+            float qc = 1.0f, qs = 0.0f;
+            float vx = 0.0f, vy = 0.0f;
+            float w = 0.0f;
+            bool awake = true;
+        };
+
+        std::vector<uint8_t> m_data;
+        std::vector<BodyState> m_bodies;
+        size_t m_entityCount = 0;
+    };
+}
@@ -0,0 +1,396 @@
+#include "pch.h"
+#include "Scene/SpatialGrid.h"
+#include "Scene/Components.h"
+#include "Scene/TransformHierarchy.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace my2d
+{
+    SpatialGrid::SpatialGrid(float cellSize)
+    {
+        m_cellSize = (cellSize > 1.0f) ? cellSize : DefaultCellSize;
+        m_invCellSize = 1.0f / m_cellSize;
+    }
+
+    void SpatialGrid::Connect(entt::registry& reg)
+    {
+        reg.on_construct<TransformComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_update<TransformComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_destroy<TransformComponent>().connect<&SpatialGrid::OnTransformDestroyed>(*this);
+
+        // Everything that grows the bounds: re-check on add/change/remove
+        reg.on_construct<SpriteRendererComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_update<SpriteRendererComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_destroy<SpriteRendererComponent>().connect<&SpatialGrid::OnChanged>(*this);
+
+        reg.on_construct<BoxCollider2DComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_update<BoxCollider2DComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_destroy<BoxCollider2DComponent>().connect<&SpatialGrid::OnChanged>(*this);
+
+        reg.on_construct<DoorComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_update<DoorComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_destroy<DoorComponent>().connect<&SpatialGrid::OnChanged>(*this);
+
+        reg.on_construct<GrantProgressionComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_update<GrantProgressionComponent>().connect<&SpatialGrid::OnChanged>(*this);
+        reg.on_destroy<GrantProgressionComponent>().connect<&SpatialGrid::OnChanged>(*this);
+    }
+
+    void SpatialGrid::Disconnect(entt::registry& reg)
+    {
+        reg.on_construct<TransformComponent>().disconnect(*this);
+        reg.on_update<TransformComponent>().disconnect(*this);
+        reg.on_destroy<TransformComponent>().disconnect(*this);
+
+        reg.on_construct<SpriteRendererComponent>().disconnect(*this);
+        reg.on_update<SpriteRendererComponent>().disconnect(*this);
+        reg.on_destroy<SpriteRendererComponent>().disconnect(*this);
+
+        reg.on_construct<BoxCollider2DComponent>().disconnect(*this);
+        reg.on_update<BoxCollider2DComponent>().disconnect(*this);
+        reg.on_destroy<BoxCollider2DComponent>().disconnect(*this);
+
+        reg.on_construct<DoorComponent>().disconnect(*this);
+        reg.on_update<DoorComponent>().disconnect(*this);
+        reg.on_destroy<DoorComponent>().disconnect(*this);
+
+        reg.on_construct<GrantProgressionComponent>().disconnect(*this);
+        reg.on_update<GrantProgressionComponent>().disconnect(*this);
+        reg.on_destroy<GrantProgressionComponent>().disconnect(*this);
+    }
+
+    bool SpatialGrid::ComputeBounds(const entt::registry& reg, entt::entity e, glm::vec2& outMin, glm::vec2& outMax)
+    {
+        const auto* local = reg.try_get<TransformComponent>(e);
+        if (!local) return false;
+
+        // Children are bucketed where they are drawn
+        const TransformComponent* tc = &WorldTransformOf(reg, e, *local);
+
+        glm::vec2 mn = tc->position;
+        glm::vec2 mx = tc->position;
+
+        auto grow = [&](const glm::vec2& a, const glm::vec2& b)
+            {
+                mn.x = std::min({ mn.x, a.x, b.x });
+                mn.y = std::min({ mn.y, a.y, b.y });
+                mx.x = std::max({ mx.x, a.x, b.x });
+                mx.y = std::max({ mx.y, a.y, b.y });
+            };
+
+        if (const auto* sc = reg.try_get<SpriteRendererComponent>(e))
+        {
+            // Same placement as Scene's sprite drawing
+            const glm::vec2 worldSize = { sc->size.x * tc->scale.x, sc->size.y * tc->scale.y };
+            const glm::vec2 pivotScaled = { sc->pivot.x * worldSize.x, sc->pivot.y * worldSize.y };
+            const glm::vec2 offsetScaled = { sc->offset.x * tc->scale.x, sc->offset.y * tc->scale.y };
+            const glm::vec2 drawPos = tc->position + offsetScaled - pivotScaled;
+
+            if (tc->rotationDeg == 0.0f)
+            {
+                grow(drawPos, drawPos + worldSize);
+            }
+            else
+            {
+                // Rotates about the rect center: use the circle around it
+                const glm::vec2 center = drawPos + worldSize * 0.5f;
+                const float r = 0.5f * std::sqrt(worldSize.x * worldSize.x + worldSize.y * worldSize.y);
+                grow(center - glm::vec2(r, r), center + glm::vec2(r, r));
+            }
+        }
+
+        if (const auto* bc = reg.try_get<BoxCollider2DComponent>(e))
+        {
+            // Transform.position is the collider's top-left minus offset (see PhysicsSystem)
+            const glm::vec2 topLeft = tc->position + bc->offset;
+            grow(topLeft, topLeft + bc->size);
+        }
+
+        if (const auto* door = reg.try_get<DoorComponent>(e))
+            grow(tc->position, tc->position + door->triggerSize);
+
+        if (const auto* g = reg.try_get<GrantProgressionComponent>(e))
+        {
+            const glm::vec2 r{ g->radiusPx, g->radiusPx };
+            grow(tc->position - r, tc->position + r);
+        }
+
+        outMin = mn;
+        outMax = mx;
+        return true;
+    }
+
+    int SpatialGrid::CellCoord(float v) const
+    {
+        // Clamped so wild positions (or NaN) can't overflow the int
+        float c = std::floor(v * m_invCellSize);
+        if (!(c > -1073741824.0f)) c = -1073741824.0f;
+        if (c > 1073741824.0f) c = 1073741824.0f;
+        return (int)c;
+    }
+
+    uint64_t SpatialGrid::CellKey(int x, int y)
+    {
+        return ((uint64_t)(uint32_t)x << 32) | (uint64_t)(uint32_t)y;
+    }
+
+    uint32_t SpatialGrid::NextStamp()
+    {
+        if (++m_queryStamp == 0)
+        {
+            std::fill(m_queryMark.begin(), m_queryMark.end(), 0u);
+            m_queryStamp = 1;
+        }
+        return m_queryStamp;
+    }
+
+    void SpatialGrid::MarkChanged(entt::entity e)
+    {
+        // Marked by handle: a recycled index (new version) still gets its own entry
+        const size_t index = (size_t)entt::to_entity(e);
+        if (index >= m_changedMark.size())
+            m_changedMark.resize(index + 1, entt::null);
+
+        if (m_changedMark[index] == e)
+            return;
+
+        m_changedMark[index] = e;
+        m_changed.push_back(e);
+    }
+
+    void SpatialGrid::OnChanged(entt::registry& reg, entt::entity e)
+    {
+        (void)reg;
+        MarkChanged(e);
+    }
+
+    void SpatialGrid::OnTransformDestroyed(entt::registry& reg, entt::entity e)
+    {
+        (void)reg;
+
+        // Straight away: the entity (and its index) may be gone before the next query
+        const size_t index = (size_t)entt::to_entity(e);
+        if (index < m_proxies.size() && m_proxies[index].entity == e)
+            Remove(m_proxies[index]);
+    }
+
+    void SpatialGrid::Insert(Proxy& p)
+    {
+        ++m_entityCount;
+
+        if (p.large)
+        {
+            m_large.push_back(p.entity);
+            return;
+        }
+
+        for (int y = p.y0; y <= p.y1; ++y)
+            for (int x = p.x0; x <= p.x1; ++x)
+                m_cells[CellKey(x, y)].push_back(p.entity);
+    }
+
+    static void EraseSwap(std::vector<entt::entity>& list, entt::entity e)
+    {
+        auto it = std::find(list.begin(), list.end(), e);
+        if (it == list.end()) return;
+        *it = list.back();
+        list.pop_back();
+    }
+
+    void SpatialGrid::Unlink(Proxy& p, entt::entity e)
+    {
+        if (p.large)
+        {
+            EraseSwap(m_large, e);
+            return;
+        }
+
+        for (int y = p.y0; y <= p.y1; ++y)
+        {
+            for (int x = p.x0; x <= p.x1; ++x)
+            {
+                auto it = m_cells.find(CellKey(x, y));
+                if (it == m_cells.end()) continue;
+
+                EraseSwap(it->second, e);
+                if (it->second.empty())
+                    m_cells.erase(it);
+            }
+        }
+    }
+
+    void SpatialGrid::Remove(Proxy& p)
+    {
+        if (p.entity == entt::null) return;
+
+        Unlink(p, p.entity);
+        p.entity = entt::null;
+        --m_entityCount;
+    }
+
+    void SpatialGrid::Refresh(entt::registry& reg, entt::entity e)
+    {
+        const size_t index = (size_t)entt::to_entity(e);
+
+        glm::vec2 mn, mx;
+        if (!reg.valid(e) || !ComputeBounds(reg, e, mn, mx))
+        {
+            if (index < m_proxies.size() && m_proxies[index].entity == e)
+                Remove(m_proxies[index]);
+            return;
+        }
+
+        if (index >= m_proxies.size())
+        {
+            m_proxies.resize(index + 1);
+            m_queryMark.resize(index + 1, 0u);
+        }
+
+        Proxy& p = m_proxies[index];
+        if (p.entity != e)
+            Remove(p); // older version of this index that was never cleaned up
+
+        const int x0 = CellCoord(mn.x), y0 = CellCoord(mn.y);
+        const int x1 = CellCoord(mx.x), y1 = CellCoord(mx.y);
+        const int64_t cells = (int64_t)(x1 - x0 + 1) * (int64_t)(y1 - y0 + 1);
+        const bool large = cells > MaxCellsPerEntity;
+
+        p.min = mn;
+        p.max = mx;
+
+        // Still in the same cells: nothing to re-bucket
+        if (p.entity == e && p.large == large && (large || (p.x0 == x0 && p.y0 == y0 && p.x1 == x1 && p.y1 == y1)))
+            return;
+
+        if (p.entity == e)
+        {
+            Unlink(p, e);
+            --m_entityCount;
+        }
+
+        p.entity = e;
+        p.x0 = x0; p.y0 = y0;
+        p.x1 = x1; p.y1 = y1;
+        p.large = large;
+        Insert(p);
+    }
+
+    void SpatialGrid::Flush(entt::registry& reg)
+    {
+        if (m_changed.empty()) return;
+
+        MY2D_PROFILE_SCOPE("SpatialGrid::Flush");
+
+        for (entt::entity e : m_changed)
+        {
+            m_changedMark[(size_t)entt::to_entity(e)] = entt::null;
+            Refresh(reg, e);
+        }
+        m_changed.clear();
+    }
+
+    void SpatialGrid::Rebuild(entt::registry& reg)
+    {
+        MY2D_PROFILE_SCOPE("SpatialGrid::Rebuild");
+
+        Flush(reg);
+        for (auto e : reg.view<TransformComponent>())
+            Refresh(reg, e);
+    }
+
+    const std::vector<entt::entity>& SpatialGrid::QueryAABB(entt::registry& reg, const glm::vec2& min, const glm::vec2& max)
+    {
+        Flush(reg);
+        const uint32_t stamp = NextStamp();
+
+        std::vector<entt::entity>& out = m_result;
+        out.clear();
+
+        auto visit = [&](entt::entity e)
+            {
+                const size_t index = (size_t)entt::to_entity(e);
+                if (m_queryMark[index] == stamp) return; // spans several cells, already returned
+
+                const Proxy& p = m_proxies[index];
+                if (p.min.x > max.x || p.max.x < min.x || p.min.y > max.y || p.max.y < min.y)
+                    return;
+
+                m_queryMark[index] = stamp;
+                out.push_back(e);
+            };
+
+        const int x0 = CellCoord(min.x), y0 = CellCoord(min.y);
+        const int x1 = CellCoord(max.x), y1 = CellCoord(max.y);
+        const int64_t rangeCells = (int64_t)(x1 - x0 + 1) * (int64_t)(y1 - y0 + 1);
+
+        if (rangeCells <= 0)
+        {
+            // min > max: empty query
+        }
+        else if ((uint64_t)rangeCells <= m_cells.size())
+        {
+            for (int y = y0; y <= y1; ++y)
+            {
+                for (int x = x0; x <= x1; ++x)
+                {
+                    auto it = m_cells.find(CellKey(x, y));
+                    if (it == m_cells.end()) continue;
+                    for (entt::entity e : it->second)
+                        visit(e);
+                }
+            }
+        }
+        else
+        {
+            // Query covers more cells than exist: walk the occupied ones instead
+            for (const auto& [key, list] : m_cells)
+            {
+                const int x = (int)(int32_t)(uint32_t)(key >> 32);
+                const int y = (int)(int32_t)(uint32_t)(key & 0xFFFFFFFFu);
+                if (x < x0 || x > x1 || y < y0 || y > y1) continue;
+                for (entt::entity e : list)
+                    visit(e);
+            }
+        }
+
+        for (entt::entity e : m_large)
+            visit(e);
+
+        return out;
+    }
+
+    const std::vector<entt::entity>& SpatialGrid::QueryRadius(entt::registry& reg, const glm::vec2& center, float radius)
+    {
+        QueryAABB(reg, center - glm::vec2(radius, radius), center + glm::vec2(radius, radius));
+
+        // Box corners outside the circle
+        std::vector<entt::entity>& out = m_result;
+        const float r2 = radius * radius;
+        size_t kept = 0;
+        for (size_t i = 0; i < out.size(); ++i)
+        {
+            const entt::entity e = out[i];
+            const size_t index = (size_t)entt::to_entity(e);
+            const Proxy& p = m_proxies[index];
+
+            const float dx = center.x - std::clamp(center.x, p.min.x, p.max.x);
+            const float dy = center.y - std::clamp(center.y, p.min.y, p.max.y);
+            if (dx * dx + dy * dy <= r2)
+                out[kept++] = e;
+            else
+                m_queryMark[index] = 0u; // not part of the result for InLastQuery
+        }
+        out.resize(kept);
+        return out;
+    }
+
+    bool SpatialGrid::InLastQuery(entt::entity e) const
+    {
+        const size_t index = (size_t)entt::to_entity(e);
+        return m_queryStamp != 0 && index < m_queryMark.size() && m_queryMark[index] == m_queryStamp
+            && m_proxies[index].entity == e;
+    }
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <entt/entt.hpp>
+#include <glm/vec2.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace my2d
+{
+    // Uniform grid over entity bounds for "what is near X" queries (pickups, doors, culling).
+    //
+    // Bounds = Transform position, grown by whatever the entity has of sprite rect, box collider,
+    // door trigger and pickup radius. Each entity is bucketed into every cell its bounds touch;
+    // bounds spanning more than MaxCellsPerEntity cells go to a side list every query checks.
+    //
+    // Kept up to date from the registry's signals (construct/patch/replace/destroy) plus MarkChanged()
+    // for transforms written in place (Physics_SyncTransforms calls it for bodies that moved).
+    // Pending changes are applied at the start of each query, and only entities that cross
+    // a cell boundary are re-bucketed.
+    class SpatialGrid
+    {
+    public:
+        static constexpr float DefaultCellSize = 128.0f;
+        static constexpr int MaxCellsPerEntity = 64;
+
+        explicit SpatialGrid(float cellSize = DefaultCellSize);
+
+        void Connect(entt::registry& reg);
+        void Disconnect(entt::registry& reg);
+
+        // Queue e for a bounds refresh on the next query.
+        void MarkChanged(entt::entity e);
+
+        // Re-check every entity with a Transform (for code that moved things without telling the grid).
+        void Rebuild(entt::registry& reg);
+
+        // Entities whose bounds overlap [min, max] / the circle, no duplicates.
+        // Results are broad-phase: callers still do their exact test against the components.
+        // The list is reused: valid until the next query (destroying entities while walking it is fine).
+        const std::vector<entt::entity>& QueryAABB(entt::registry& reg, const glm::vec2& min, const glm::vec2& max);
+        const std::vector<entt::entity>& QueryRadius(entt::registry& reg, const glm::vec2& center, float radius);
+
+        // True if e was returned by the most recent query (O(1), for filtering a walk against a query).
+        bool InLastQuery(entt::entity e) const;
+
+        // World bounds the grid would use for e. False if e has no Transform.
+        static bool ComputeBounds(const entt::registry& reg, entt::entity e, glm::vec2& outMin, glm::vec2& outMax);
+
+        float CellSize() const { return m_cellSize; }
+        size_t CellCount() const { return m_cells.size(); }
+        size_t EntityCount() const { return m_entityCount; }
+
+    private:
+        struct Proxy
+        {
+            entt::entity entity = entt::null; // null = slot unused
+            glm::vec2 min{ 0.0f, 0.0f };
+            glm::vec2 max{ 0.0f, 0.0f };
+            int x0 = 0, y0 = 0, x1 = -1, y1 = -1; // cell range, inclusive
+            bool large = false;
+        };
+
+        void OnChanged(entt::registry& reg, entt::entity e);
+        void OnTransformDestroyed(entt::registry& reg, entt::entity e);
+
+        void Flush(entt::registry& reg);
+        void Refresh(entt::registry& reg, entt::entity e);
+        void Insert(Proxy& p);
+        void Remove(Proxy& p);
+        void Unlink(Proxy& p, entt::entity e);
+
+        int CellCoord(float v) const;
+        static uint64_t CellKey(int x, int y);
+        uint32_t NextStamp();
+
+    private:
+        float m_cellSize = DefaultCellSize;
+        float m_invCellSize = 1.0f / DefaultCellSize;
+
+        std::unordered_map<uint64_t, std::vector<entt::entity>> m_cells;
+        std::vector<entt::entity> m_large;  // bounds too big to bucket
+        std::vector<Proxy> m_proxies;       // by entity index
+        size_t m_entityCount = 0;
+
+        std::vector<entt::entity> m_changed;
+        std::vector<entt::entity> m_changedMark; // by entity index, dedupes m_changed
+
+        std::vector<entt::entity> m_result;
+        std::vector<uint32_t> m_queryMark; // by entity index, == m_queryStamp when already returned
+        uint32_t m_queryStamp = 0;
+    };
+}
@@ -0,0 +1,98 @@
+#include "pch.h"
+#include "Scene/StateHash.h"
+#include "Scene/Scene.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace my2d
+{
+    namespace
+    {
+        struct Fnv1a
+        {
+            uint64_t h = 14695981039346656037ull;
+
+            void Bytes(const void* data, size_t size)
+            {
+                const auto* p = static_cast<const uint8_t*>(data);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    h ^= p[i];
+                    h *= 1099511628211ull;
+                }
+            }
+
+            template<typename T>
+            void Add(const T& v)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                Bytes(&v, sizeof(T));
+            }
+        };
+    }
+
+    uint64_t Scene_HashState(Scene& scene)
+    {
+        MY2D_PROFILE_SCOPE("Scene_HashState");
+
+        auto& reg = scene.Registry();
+        Fnv1a f;
+
+        // Entity index order: the same in every process that ran the same ticks, unlike the pool's packed
+        // order. Ids stay out on purpose: generated ones are salted per process (see Scene.cpp).
+        static thread_local std::vector<entt::entity> t_order;
+        const auto transforms = reg.view<TransformComponent>();
+        t_order.assign(transforms.begin(), transforms.end());
+        std::sort(t_order.begin(), t_order.end(), [](entt::entity a, entt::entity b)
+            {
+                return entt::to_entity(a) < entt::to_entity(b);
+            });
+
+        for (entt::entity e : t_order)
+        {
+            const TransformComponent& tc = transforms.get<TransformComponent>(e);
+            f.Add(tc.position.x);
+            f.Add(tc.position.y);
+            f.Add(tc.rotationDeg);
+            f.Add(tc.scale.x);
+            f.Add(tc.scale.y);
+
+            if (const RigidBody2DComponent* rb = reg.try_get<RigidBody2DComponent>(e); rb && b2Body_IsValid(rb->bodyId))
+            {
+                const b2Vec2 p = b2Body_GetPosition(rb->bodyId);
+                const b2Rot q = b2Body_GetRotation(rb->bodyId);
+                const b2Vec2 v = b2Body_GetLinearVelocity(rb->bodyId);
+                const float w = b2Body_GetAngularVelocity(rb->bodyId);
+                f.Add(p.x); f.Add(p.y);
+                f.Add(q.c); f.Add(q.s);
+                f.Add(v.x); f.Add(v.y);
+                f.Add(w);
+                f.Add((uint8_t)b2Body_IsAwake(rb->bodyId));
+            }
+
+            if (const HealthComponent* hc = reg.try_get<HealthComponent>(e))
+            {
+                f.Add(hc->hp);
+                f.Add(hc->maxHp);
+            }
+
+            if (const PlatformerControllerComponent* pc = reg.try_get<PlatformerControllerComponent>(e))
+            {
+                f.Add(pc->facing);
+                f.Add((uint8_t)pc->isDashing);
+                f.Add(pc->dashTimer);
+                f.Add(pc->dashCooldownTimer);
+                f.Add(pc->dashDir);
+                f.Add((uint8_t)pc->jumpableGround);
+                f.Add((uint8_t)pc->grounded);
+                f.Add(pc->coyoteTimer);
+                f.Add(pc->jumpBufferTimer);
+            }
+        }
+
+        return f.h;
+    }
+}
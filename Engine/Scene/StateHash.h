@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+
+namespace my2d
+{
+    class Scene;
+
+    // FNV-1a over the simulation state that has to match between a recording and its replay:
+    // Box2D body state, Transform, Health and PlatformerController runtime fields.
+    // Bit-exact on purpose (floats are hashed by representation). Entities are visited in index order and
+    // their ids left out, so two processes running the same ticks hash the same.
+    uint64_t Scene_HashState(Scene& scene);
+}
@@ -0,0 +1,224 @@
+#include "pch.h"
+#include "Scene/TileCodec.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace my2d
+{
+    namespace
+    {
+        constexpr uint32_t kFlipMask = 0xE0000000u; // Tiled H | V | D
+        constexpr uint32_t kMaxIndex = 0x1FFEu;     // stored as index + 1 in 13 bits
+        constexpr uint32_t kMaxTiles = 1u << 26;    // a few runs can claim any count: cap what gets allocated
+
+        constexpr char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        bool ToCode(int tile, uint16_t& code)
+        {
+            if (tile == -1)
+            {
+                code = 0;
+                return true;
+            }
+
+            const uint32_t raw = (uint32_t)tile;
+            const uint32_t index = raw & ~kFlipMask;
+            if (index > kMaxIndex)
+                return false;
+
+            code = (uint16_t)(((raw & kFlipMask) >> 16) | (index + 1));
+            return true;
+        }
+
+        int FromCode(uint16_t code)
+        {
+            if (code == 0)
+                return -1;
+
+            const uint32_t flags = ((uint32_t)code & 0xE000u) << 16;
+            return (int)(flags | (((uint32_t)code & 0x1FFFu) - 1));
+        }
+
+        // ---- base64 output ----
+
+        struct Base64Writer
+        {
+            std::string& out;
+            uint32_t bits = 0;
+            int count = 0;
+
+            void Byte(uint8_t b)
+            {
+                bits = (bits << 8) | b;
+                if (++count == 3)
+                {
+                    out.push_back(kAlphabet[(bits >> 18) & 63]);
+                    out.push_back(kAlphabet[(bits >> 12) & 63]);
+                    out.push_back(kAlphabet[(bits >> 6) & 63]);
+                    out.push_back(kAlphabet[bits & 63]);
+                    bits = 0;
+                    count = 0;
+                }
+            }
+
+            void Varint(uint32_t v)
+            {
+                while (v >= 0x80)
+                {
+                    Byte((uint8_t)(v | 0x80));
+                    v >>= 7;
+                }
+                Byte((uint8_t)v);
+            }
+
+            void Finish()
+            {
+                if (count == 0)
+                    return;
+
+                bits <<= (3 - count) * 8;
+                out.push_back(kAlphabet[(bits >> 18) & 63]);
+                out.push_back(kAlphabet[(bits >> 12) & 63]);
+                out.push_back(count == 2 ? kAlphabet[(bits >> 6) & 63] : '=');
+                out.push_back('=');
+            }
+        };
+
+        // ---- base64 input, decoded a byte at a time ----
+
+        struct Base64Reader
+        {
+            std::string_view in;
+            size_t pos = 0;
+            uint32_t bits = 0;
+            int count = 0; // decoded bytes still held in bits
+
+            static int Value(char c)
+            {
+                if (c >= 'A' && c <= 'Z') return c - 'A';
+                if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+                if (c >= '0' && c <= '9') return c - '0' + 52;
+                if (c == '+') return 62;
+                if (c == '/') return 63;
+                return -1;
+            }
+
+            bool Refill()
+            {
+                if (pos + 4 > in.size())
+                    return false;
+
+                uint32_t v = 0;
+                int bytes = 3;
+                for (int i = 0; i < 4; ++i)
+                {
+                    const char c = in[pos + i];
+                    int d = Value(c);
+                    if (d < 0)
+                    {
+                        // '=' only as the last one or two characters of the input
+                        if (c != '=' || i < 2 || pos + 4 != in.size() || (i == 2 && in[pos + 3] != '='))
+                            return false;
+                        d = 0;
+                        bytes = std::min(bytes, i - 1);
+                    }
+                    v = (v << 6) | (uint32_t)d;
+                }
+
+                pos += 4;
+                bits = v >> ((3 - bytes) * 8);
+                count = bytes;
+                return true;
+            }
+
+            bool Byte(uint8_t& b)
+            {
+                if (count == 0 && !Refill())
+                    return false;
+
+                --count;
+                b = (uint8_t)(bits >> (count * 8));
+                return true;
+            }
+
+            bool Varint(uint32_t& v)
+            {
+                v = 0;
+                for (int shift = 0; shift < 35; shift += 7)
+                {
+                    uint8_t b = 0;
+                    if (!Byte(b))
+                        return false;
+                    v |= (uint32_t)(b & 0x7F) << shift;
+                    if ((b & 0x80) == 0)
+                        return true;
+                }
+                return false;
+            }
+        };
+    }
+
+    bool EncodeTiles(const std::vector<int>& tiles, std::string& out)
+    {
+        std::string encoded;
+        encoded.reserve(64);
+        Base64Writer w{ encoded };
+        w.Varint((uint32_t)tiles.size());
+
+        int32_t prev = 0;
+        for (size_t i = 0; i < tiles.size();)
+        {
+            uint16_t code = 0;
+            if (!ToCode(tiles[i], code))
+                return false;
+
+            size_t run = 1;
+            while (i + run < tiles.size() && tiles[i + run] == tiles[i])
+                ++run;
+
+            const int32_t delta = (int32_t)code - prev;
+            w.Varint((uint32_t)run);
+            w.Varint(((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+
+            prev = code;
+            i += run;
+        }
+
+        w.Finish();
+        out = std::move(encoded);
+        return true;
+    }
+
+    bool DecodeTiles(std::string_view encoded, std::vector<int>& out)
+    {
+        Base64Reader r{ encoded };
+
+        uint32_t count = 0;
+        if (!r.Varint(count) || count > kMaxTiles)
+            return false;
+
+        out.resize(count);
+
+        int32_t prev = 0;
+        for (uint32_t i = 0; i < count;)
+        {
+            uint32_t run = 0, zz = 0;
+            if (!r.Varint(run) || !r.Varint(zz) || run == 0 || run > count - i)
+                return false;
+
+            const int32_t code = prev + (int32_t)((zz >> 1) ^ (0u - (zz & 1u)));
+            if (code < 0 || code > 0xFFFF)
+                return false;
+
+            const int tile = FromCode((uint16_t)code);
+            std::fill(out.begin() + i, out.begin() + i + run, tile);
+
+            prev = code;
+            i += run;
+        }
+
+        // Nothing but padding may follow
+        return r.count == 0 && r.pos == encoded.size();
+    }
+}
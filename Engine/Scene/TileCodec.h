@@ -0,0 +1,21 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace my2d
+{
+    // Compact text encoding for TileLayer::tiles ("rle16" in scene files).
+    //
+    // Each tile becomes a 16-bit code: 0 = empty (-1), otherwise bits 0-12 = tile index + 1 and bits 13-15 =
+    // the Tiled flip flags (D, V, H: bits 29-31 of the int). The codes are stored as runs, each run a varint
+    // length plus the zigzag varint delta from the previous run's code, after a varint tile count; the bytes
+    // are base64'd so they fit in a JSON string.
+    //
+    // False (out untouched) when a layer holds values that don't fit: tile index >= 8191 or a negative
+    // value other than -1. Those layers stay a plain array.
+    bool EncodeTiles(const std::vector<int>& tiles, std::string& out);
+
+    // Decodes straight into out (resized to the stored count). False on malformed data, with out unspecified.
+    bool DecodeTiles(std::string_view encoded, std::vector<int>& out);
+}
@@ -0,0 +1,288 @@
+#include "pch.h"
+#include "Scene/TransformHierarchy.h"
+#include "Core/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace my2d
+{
+    static constexpr float DegToRad = 0.01745329251994329577f;
+
+    TransformComponent Hierarchy_Compose(const TransformComponent& parentWorld, const TransformComponent& local)
+    {
+        const glm::vec2 scaled = { local.position.x * parentWorld.scale.x, local.position.y * parentWorld.scale.y };
+
+        TransformComponent out;
+        if (parentWorld.rotationDeg == 0.0f)
+        {
+            out.position = parentWorld.position + scaled;
+        }
+        else
+        {
+            const float c = std::cos(parentWorld.rotationDeg * DegToRad);
+            const float s = std::sin(parentWorld.rotationDeg * DegToRad);
+            out.position = parentWorld.position + glm::vec2{ scaled.x * c - scaled.y * s, scaled.x * s + scaled.y * c };
+        }
+        out.rotationDeg = parentWorld.rotationDeg + local.rotationDeg;
+        out.scale = { parentWorld.scale.x * local.scale.x, parentWorld.scale.y * local.scale.y };
+        return out;
+    }
+
+    TransformComponent Hierarchy_InterpolatedTransform(const WorldTransformComponent& wt, float alpha)
+    {
+        if (!wt.hasPrevTransform)
+            return wt.world;
+
+        alpha = std::clamp(alpha, 0.0f, 1.0f);
+
+        TransformComponent out = wt.world;
+        out.position = wt.prevPosition + (wt.world.position - wt.prevPosition) * alpha;
+
+        float delta = std::fmod(wt.world.rotationDeg - wt.prevRotationDeg + 540.0f, 360.0f) - 180.0f;
+        out.rotationDeg = wt.prevRotationDeg + delta * alpha;
+        return out;
+    }
+
+    void TransformHierarchy::Connect(entt::registry& reg)
+    {
+        reg.on_construct<TransformComponent>().connect<&TransformHierarchy::OnTransformChanged>(*this);
+        reg.on_update<TransformComponent>().connect<&TransformHierarchy::OnTransformChanged>(*this);
+        reg.on_destroy<HierarchyComponent>().connect<&TransformHierarchy::OnHierarchyDestroy>(*this);
+    }
+
+    void TransformHierarchy::Disconnect(entt::registry& reg)
+    {
+        reg.on_construct<TransformComponent>().disconnect(*this);
+        reg.on_update<TransformComponent>().disconnect(*this);
+        reg.on_destroy<HierarchyComponent>().disconnect(*this);
+    }
+
+    void TransformHierarchy::OnTransformChanged(entt::registry& reg, entt::entity e)
+    {
+        MarkDirty(reg, e);
+    }
+
+    void TransformHierarchy::MarkDirty(entt::registry& reg, entt::entity e)
+    {
+        auto* h = reg.try_get<HierarchyComponent>(e);
+        if (!h || h->dirty)
+            return;
+
+        // A root without children has nothing to update
+        if (h->parent == entt::null && h->firstChild == entt::null)
+            return;
+
+        h->dirty = true;
+        m_dirty.push_back(e);
+    }
+
+    void TransformHierarchy::OnHierarchyDestroy(entt::registry& reg, entt::entity e)
+    {
+        Unlink(reg, e);
+
+        // Children outliving their parent become roots where they are (Scene destroys whole subtrees,
+        // so this only happens when something destroys through the registry directly)
+        auto& h = reg.get<HierarchyComponent>(e);
+        entt::entity c = h.firstChild;
+        h.firstChild = entt::null;
+        while (c != entt::null)
+        {
+            auto& ch = reg.get<HierarchyComponent>(c);
+            const entt::entity next = ch.nextSibling;
+            ch.parent = ch.prevSibling = ch.nextSibling = entt::null;
+
+            if (const auto* wt = reg.try_get<WorldTransformComponent>(c))
+            {
+                if (auto* tc = reg.try_get<TransformComponent>(c))
+                    *tc = wt->world;
+                reg.remove<WorldTransformComponent>(c);
+            }
+            c = next;
+        }
+    }
+
+    void TransformHierarchy::Unlink(entt::registry& reg, entt::entity child)
+    {
+        auto& h = reg.get<HierarchyComponent>(child);
+        if (h.parent == entt::null)
+            return;
+
+        if (h.prevSibling != entt::null)
+            reg.get<HierarchyComponent>(h.prevSibling).nextSibling = h.nextSibling;
+        else
+            reg.get<HierarchyComponent>(h.parent).firstChild = h.nextSibling;
+
+        if (h.nextSibling != entt::null)
+            reg.get<HierarchyComponent>(h.nextSibling).prevSibling = h.prevSibling;
+
+        h.parent = h.prevSibling = h.nextSibling = entt::null;
+    }
+
+    bool TransformHierarchy::SetParent(entt::registry& reg, entt::entity child, entt::entity parent)
+    {
+        if (parent == entt::null)
+        {
+            ClearParent(reg, child);
+            return true;
+        }
+
+        if (!reg.valid(child) || !reg.valid(parent) || !reg.all_of<TransformComponent>(child) || !reg.all_of<TransformComponent>(parent))
+        {
+            spdlog::error("SetParent: both entities need to be valid and have a TransformComponent");
+            return false;
+        }
+
+        for (entt::entity a = parent; a != entt::null; )
+        {
+            if (a == child)
+            {
+                spdlog::error("SetParent: entity {} is an ancestor of the new parent", (uint32_t)child);
+                return false;
+            }
+            const auto* ah = reg.try_get<HierarchyComponent>(a);
+            a = ah ? ah->parent : entt::null;
+        }
+
+        // Both emplaced before taking references (an emplace can move the pool)
+        reg.get_or_emplace<HierarchyComponent>(parent);
+        reg.get_or_emplace<HierarchyComponent>(child);
+        reg.get_or_emplace<WorldTransformComponent>(child);
+
+        Unlink(reg, child);
+
+        auto& ph = reg.get<HierarchyComponent>(parent);
+        auto& h = reg.get<HierarchyComponent>(child);
+        h.parent = parent;
+        h.nextSibling = ph.firstChild;
+        if (ph.firstChild != entt::null)
+            reg.get<HierarchyComponent>(ph.firstChild).prevSibling = child;
+        ph.firstChild = child;
+
+        // Non-fixed update: the new placement snaps instead of blending from where it was
+        m_updated.clear();
+        m_queue.clear();
+        m_queue.push_back(child);
+        Propagate(reg, false);
+        return true;
+    }
+
+    void TransformHierarchy::ClearParent(entt::registry& reg, entt::entity child)
+    {
+        if (!reg.valid(child) || !reg.all_of<HierarchyComponent>(child))
+            return;
+
+        Unlink(reg, child);
+
+        if (const auto* wt = reg.try_get<WorldTransformComponent>(child))
+        {
+            if (auto* tc = reg.try_get<TransformComponent>(child))
+                *tc = wt->world;
+            reg.remove<WorldTransformComponent>(child);
+        }
+    }
+
+    void TransformHierarchy::CollectDescendants(const entt::registry& reg, entt::entity e, std::vector<entt::entity>& out) const
+    {
+        const size_t first = out.size();
+        out.push_back(e);
+
+        for (size_t i = first; i < out.size(); ++i)
+        {
+            const auto* h = reg.try_get<HierarchyComponent>(out[i]);
+            if (!h) continue;
+
+            for (entt::entity c = h->firstChild; c != entt::null; c = reg.get<HierarchyComponent>(c).nextSibling)
+                out.push_back(c);
+        }
+
+        out.erase(out.begin() + (std::ptrdiff_t)first);
+    }
+
+    const std::vector<entt::entity>& TransformHierarchy::Update(entt::registry& reg, bool fixedStep)
+    {
+        MY2D_PROFILE_SCOPE("TransformHierarchy::Update");
+
+        // Whatever moved last step and didn't move again stops blending
+        if (fixedStep)
+        {
+            for (entt::entity e : m_settle)
+            {
+                if (auto* wt = reg.valid(e) ? reg.try_get<WorldTransformComponent>(e) : nullptr)
+                {
+                    wt->prevPosition = wt->world.position;
+                    wt->prevRotationDeg = wt->world.rotationDeg;
+                }
+            }
+            m_settle.clear();
+        }
+
+        m_updated.clear();
+        if (m_dirty.empty())
+            return m_updated;
+
+        // Seed the queue with the topmost dirty entities only: anything under a dirty ancestor
+        // gets reached from there, so each subtree is walked once
+        m_queue.clear();
+        for (entt::entity e : m_dirty)
+        {
+            if (!reg.valid(e) || !reg.all_of<HierarchyComponent>(e))
+                continue;
+
+            bool covered = false;
+            for (entt::entity a = reg.get<HierarchyComponent>(e).parent; a != entt::null; a = reg.get<HierarchyComponent>(a).parent)
+            {
+                if (reg.get<HierarchyComponent>(a).dirty)
+                {
+                    covered = true;
+                    break;
+                }
+            }
+
+            if (!covered)
+                m_queue.push_back(e);
+        }
+
+        for (entt::entity e : m_dirty)
+        {
+            if (auto* h = reg.valid(e) ? reg.try_get<HierarchyComponent>(e) : nullptr)
+                h->dirty = false;
+        }
+        m_dirty.clear();
+
+        Propagate(reg, fixedStep);
+
+        if (fixedStep)
+            m_settle.assign(m_updated.begin(), m_updated.end());
+
+        return m_updated;
+    }
+
+    void TransformHierarchy::Propagate(entt::registry& reg, bool fixedStep)
+    {
+        for (size_t i = 0; i < m_queue.size(); ++i)
+        {
+            const entt::entity e = m_queue[i];
+            const auto& h = reg.get<HierarchyComponent>(e);
+
+            if (h.parent != entt::null)
+            {
+                const auto& parentLocal = reg.get<TransformComponent>(h.parent);
+                const TransformComponent world = Hierarchy_Compose(WorldTransformOf(reg, h.parent, parentLocal), reg.get<TransformComponent>(e));
+
+                auto& wt = reg.get<WorldTransformComponent>(e);
+                const bool blend = fixedStep && wt.hasPrevTransform;
+                wt.prevPosition = blend ? wt.world.position : world.position;
+                wt.prevRotationDeg = blend ? wt.world.rotationDeg : world.rotationDeg;
+                wt.hasPrevTransform = true;
+                wt.world = world;
+
+                m_updated.push_back(e);
+            }
+
+            for (entt::entity c = h.firstChild; c != entt::null; c = reg.get<HierarchyComponent>(c).nextSibling)
+                m_queue.push_back(c);
+        }
+    }
+}
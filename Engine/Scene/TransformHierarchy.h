@@ -0,0 +1,68 @@
+#pragma once
+#include <entt/entt.hpp>
+
+#include <vector>
+
+#include "Scene/Components.h"
+
+namespace my2d
+{
+    // World transform for drawing/physics/queries: the cached one for children, the local one for roots.
+    inline const TransformComponent& WorldTransformOf(const entt::registry& reg, entt::entity e, const TransformComponent& local)
+    {
+        const auto* wt = reg.try_get<WorldTransformComponent>(e);
+        return wt ? wt->world : local;
+    }
+
+    // Child world transform blended between the last two fixed steps (same idea as Physics_InterpolatedTransform).
+    TransformComponent Hierarchy_InterpolatedTransform(const WorldTransformComponent& wt, float alpha);
+
+    // parent * local: local position is scaled and rotated by the parent, rotation adds, scale multiplies.
+    TransformComponent Hierarchy_Compose(const TransformComponent& parentWorld, const TransformComponent& local);
+
+    // Parent/child links + the world transform cache (HierarchyComponent / WorldTransformComponent).
+    //
+    // Entities in a hierarchy whose transform changes (registry signals, Scene::MarkTransformChanged) are
+    // queued as dirty. Update() walks only the subtrees under dirty entities, breadth-first in one queue,
+    // so every parent is final before its children read it. Owned by Scene; use the Scene wrappers.
+    class TransformHierarchy
+    {
+    public:
+        void Connect(entt::registry& reg);
+        void Disconnect(entt::registry& reg);
+
+        // Links child under parent (entt::null = ClearParent) and computes the subtree's world transforms.
+        // False (and nothing changes) if that would make a cycle or either entity is invalid.
+        // The recomputed entities are in LastUpdated().
+        bool SetParent(entt::registry& reg, entt::entity child, entt::entity parent);
+
+        // Back to a root, keeping its world placement (the world transform becomes its local one).
+        void ClearParent(entt::registry& reg, entt::entity child);
+
+        // No-op for entities outside any hierarchy.
+        void MarkDirty(entt::registry& reg, entt::entity e);
+
+        // Recomputes world transforms under every dirty entity. fixedStep: the previous value is kept for
+        // interpolation (and last step's movers settle first); otherwise changes snap.
+        // Returns the entities whose world transform was rewritten, valid until the next Update/SetParent.
+        const std::vector<entt::entity>& Update(entt::registry& reg, bool fixedStep);
+        const std::vector<entt::entity>& LastUpdated() const { return m_updated; }
+
+        // Appends every descendant of e (not e itself), breadth-first.
+        void CollectDescendants(const entt::registry& reg, entt::entity e, std::vector<entt::entity>& out) const;
+
+    private:
+        void OnTransformChanged(entt::registry& reg, entt::entity e);
+        void OnHierarchyDestroy(entt::registry& reg, entt::entity e);
+        void Unlink(entt::registry& reg, entt::entity child);
+
+        // BFS over m_queue (pre-seeded with subtree roots), appending to m_updated
+        void Propagate(entt::registry& reg, bool fixedStep);
+
+    private:
+        std::vector<entt::entity> m_dirty;
+        std::vector<entt::entity> m_queue;
+        std::vector<entt::entity> m_updated;
+        std::vector<entt::entity> m_settle; // written by the last fixed-step update
+    };
+}
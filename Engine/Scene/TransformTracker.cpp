@@ -0,0 +1,59 @@
+#include "pch.h"
+#include "Scene/TransformTracker.h"
+#include "Scene/Components.h"
+
+#include <algorithm>
+
+namespace my2d
+{
+    void TransformTracker::Connect(entt::registry& reg)
+    {
+        reg.on_construct<TransformComponent>().connect<&TransformTracker::OnChanged>(*this);
+        reg.on_update<TransformComponent>().connect<&TransformTracker::OnChanged>(*this);
+    }
+
+    void TransformTracker::Disconnect(entt::registry& reg)
+    {
+        reg.on_construct<TransformComponent>().disconnect(*this);
+        reg.on_update<TransformComponent>().disconnect(*this);
+    }
+
+    void TransformTracker::OnChanged(entt::registry& reg, entt::entity e)
+    {
+        (void)reg;
+        MarkMoved(e);
+    }
+
+    void TransformTracker::MarkMoved(entt::entity e)
+    {
+        const size_t index = (size_t)entt::to_entity(e);
+        if (index >= m_version.size())
+        {
+            m_version.resize(index + 1, 0u);
+            m_movedMark.resize(index + 1, entt::null);
+        }
+
+        // Skips 0 on wrap so "never seen" stays unique
+        if (++m_version[index] == 0)
+            m_version[index] = 1;
+
+        if (m_movedMark[index] == e)
+            return;
+
+        m_movedMark[index] = e;
+        m_moved.push_back(e);
+    }
+
+    void TransformTracker::EndFrame()
+    {
+        const uint32_t moved = (uint32_t)m_moved.size();
+        m_stats.movedLastFrame = moved;
+        m_stats.maxMoved = std::max(m_stats.maxMoved, moved);
+        m_stats.totalMoved += moved;
+        ++m_stats.frames;
+
+        for (entt::entity e : m_moved)
+            m_movedMark[(size_t)entt::to_entity(e)] = entt::null;
+        m_moved.clear();
+    }
+}
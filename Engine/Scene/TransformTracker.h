@@ -0,0 +1,56 @@
+#pragma once
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace my2d
+{
+    struct TransformStats
+    {
+        uint32_t movedLastFrame = 0; // distinct entities whose transform changed in the previous frame
+        uint32_t maxMoved = 0;
+        uint64_t totalMoved = 0;
+        uint64_t frames = 0;
+
+        double AvgMoved() const { return frames ? (double)totalMoved / (double)frames : 0.0; }
+    };
+
+    // Which transforms changed this frame, plus a per-entity change counter for caches.
+    //
+    // Fed by the registry's TransformComponent signals (emplace/patch/replace) and by MarkMoved() for
+    // in-place writes (Scene::MarkTransformChanged; Physics_SyncTransforms does it for moved bodies).
+    // A cache stores Version(e) next to what it derived from the transform and recomputes when it differs.
+    class TransformTracker
+    {
+    public:
+        void Connect(entt::registry& reg);
+        void Disconnect(entt::registry& reg);
+
+        void MarkMoved(entt::entity e);
+
+        // Bumped on every MarkMoved; 0 = never seen. Per entity index, so a recycled index keeps counting up.
+        uint32_t Version(entt::entity e) const
+        {
+            const size_t index = (size_t)entt::to_entity(e);
+            return index < m_version.size() ? m_version[index] : 0u;
+        }
+
+        // Distinct entities marked since the last EndFrame (may include ones destroyed since).
+        const std::vector<entt::entity>& MovedThisFrame() const { return m_moved; }
+
+        // Sync point after the frame's update: rolls the moved list into Stats().
+        void EndFrame();
+
+        const TransformStats& Stats() const { return m_stats; }
+
+    private:
+        void OnChanged(entt::registry& reg, entt::entity e);
+
+    private:
+        std::vector<uint32_t> m_version;         // by entity index
+        std::vector<entt::entity> m_moved;
+        std::vector<entt::entity> m_movedMark;   // by entity index, dedupes m_moved within a frame
+        TransformStats m_stats;
+    };
+}
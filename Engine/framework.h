@@ -5,4 +5,6 @@
 #include "Core/EngineConfig.h"
 #include "Core/App.h"
 #include "Core/Input.h"
+#include "Core/AllocTracker.h"
+#include "Core/Profiler.h"
 #include "Core/Time.h"
\ No newline at end of file
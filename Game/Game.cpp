@@ -3,6 +3,7 @@
 #include <spdlog/spdlog.h>
 #include <filesystem>
 #include <cmath>
+#include <cstdlib>
 
 #include "Gameplay/RoomManager.h"
 #include "Gameplay/SaveGame.h"
@@ -48,23 +49,42 @@ public:
 
         // Save/load hotkeys
         if (engine.GetInput().WasKeyPressed(SDL_SCANCODE_F5))
+        {
             Save(engine);
 
+            // Checkpoint in memory too, so F9 doesn't need the disk
+            m_checkpointWorld = engine.GetWorldState();
+            m_rooms.SaveCheckpoint();
+        }
+
         if (engine.GetInput().WasKeyPressed(SDL_SCANCODE_F9))
         {
-            LoadSave(engine);
-            // Reload current room (or fall back to start)
-            const std::string room = m_rooms.CurrentRoom().empty() ? m_startRoom : m_rooms.CurrentRoom();
-            m_rooms.LoadRoom(engine, room, m_startSpawn);
+            if (m_rooms.HasCheckpoint())
+            {
+                engine.GetWorldState() = m_checkpointWorld;
+                m_rooms.RestoreCheckpoint(engine);
+            }
+            else
+            {
+                LoadSave(engine);
+                // Reload current room (or fall back to start)
+                const std::string room = m_rooms.CurrentRoom().empty() ? m_startRoom : m_rooms.CurrentRoom();
+                m_rooms.LoadRoom(engine, room, m_startSpawn);
+            }
         }
 
         if (engine.GetInput().WasKeyPressed(SDL_SCANCODE_F8))
         {
             engine.GetWorldState() = my2d::WorldState{};
+            m_rooms.ClearCheckpoint();
             spdlog::info("Cleared world state");
             m_rooms.LoadRoom(engine, m_startRoom, m_startSpawn);
         }
 
+        // Capture the next 120 frames as a Chrome trace (chrome://tracing / ui.perfetto.dev)
+        if (engine.GetInput().WasKeyPressed(SDL_SCANCODE_F10))
+            my2d::Profiler::RequestCapture(120, "profile_trace.json");
+
         if (engine.GetInput().WasKeyPressed(SDL_SCANCODE_ESCAPE))
             engine.RequestQuit();
 
@@ -100,7 +120,12 @@ public:
                 }
             }
         }
-        cam.SetPosition(m_rooms.GetPlayer().Get<my2d::TransformComponent>().position);
+        // Follow the interpolated position so the camera moves in step with the rendered player
+        {
+            auto player = m_rooms.GetPlayer();
+            const auto* rb = player.Has<my2d::RigidBody2DComponent>() ? &player.Get<my2d::RigidBody2DComponent>() : nullptr;
+            cam.SetPosition(my2d::Physics_InterpolatedTransform(player.Get<my2d::TransformComponent>(), rb, engine.RenderAlpha()).position);
+        }
     }
 
     void OnFixedUpdate(my2d::Engine& engine, double fixedDt) override
@@ -113,7 +138,7 @@ public:
     void OnPostFixedUpdate(my2d::Engine& engine, double fixedDt) override
     {
         my2d::Combat_PostPhysics(engine, m_rooms.GetScene(), (float)fixedDt);
-        my2d::Physics_SyncTransforms(m_rooms.GetScene(), engine.PixelsPerMeter());
+        my2d::Physics_SyncTransforms(m_rooms.GetScene(), engine.GetPhysics(), engine.PixelsPerMeter());
     }
 
     void OnRender(my2d::Engine& engine) override
@@ -128,7 +153,18 @@ public:
             );
         }
 
-        m_rooms.GetScene().OnRender(engine);
+        m_rooms.GetScene().OnRender(engine, engine.RenderAlpha());
+    }
+
+    // Pipelined mode: no physics debug overlay (it draws straight to the SDL_Renderer)
+    void OnBuildRenderSnapshot(my2d::Engine& engine, my2d::RenderSnapshot& out) override
+    {
+        m_rooms.GetScene().BuildRenderSnapshot(engine, engine.RenderAlpha(), out);
+    }
+
+    my2d::Scene* GetActiveScene() override
+    {
+        return &m_rooms.GetScene();
     }
 
 private:
@@ -259,7 +295,7 @@ private:
             // Spawn
             auto sp = s.CreateEntity("SpawnStart");
             sp.Get<my2d::TransformComponent>().position = { 0.0f, -200.0f };
-            sp.Add<my2d::PlayerSpawnComponent>().name = "start";
+            sp.Add<my2d::PlayerSpawnComponent>(my2d::PlayerSpawnComponent{ my2d::StringId("start") });
 
             // Door to room B
             auto d = s.CreateEntity("DoorToRoomB");
@@ -380,7 +416,7 @@ private:
 
             auto sp = s.CreateEntity("SpawnFromLeft");
             sp.Get<my2d::TransformComponent>().position = { -250.0f, -200.0f };
-            sp.Add<my2d::PlayerSpawnComponent>().name = "from_left";
+            sp.Add<my2d::PlayerSpawnComponent>(my2d::PlayerSpawnComponent{ my2d::StringId("from_left") });
 
             // Door back to A
             auto d = s.CreateEntity("DoorToRoomA");
@@ -403,15 +439,50 @@ private:
     std::string m_savePath = "savegame.json";
     std::string m_startRoom = "Scenes/room_start.scene.json";
     std::string m_startSpawn = "start";
+
+    // World state at the last F5, restored with the room checkpoint
+    my2d::WorldState m_checkpointWorld;
 };
 
-int main()
+int main(int argc, char** argv)
 {
     my2d::Engine engine;
     my2d::EngineConfig cfg;
     cfg.windowTitle = "My2DEngine - Rooms";
     cfg.contentRoot = "Game/Content";
 
+    // --headless <ticks> : fixed-step soak/throughput run without a window (0 = until Ctrl+C)
+    // --record <file>    : record input + per-tick state hashes while playing (with --headless: no input,
+    //                      a determinism recording for --replay)
+    // --replay <file>    : replay a recording headless, exit code 3 if the state diverges
+    // --pipelined        : simulate frame N+1 on its own thread while frame N renders
+    uint64_t headlessTicks = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--headless")
+        {
+            cfg.headless = true;
+            if (i + 1 < argc)
+                headlessTicks = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            cfg.recordInputPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            cfg.replayInputPath = argv[++i];
+        }
+        else if (arg == "--pipelined")
+        {
+            cfg.pipelinedRendering = true;
+        }
+    }
+
     MyGame game;
+    if (cfg.headless && cfg.replayInputPath.empty())
+        return engine.RunHeadless(cfg, game, headlessTicks);
+
     return engine.Run(cfg, game);
 }
\ No newline at end of file